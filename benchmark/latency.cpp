@@ -0,0 +1,249 @@
+#include "encoder.hpp"
+#include "qpsk.hpp"
+#include "channel.hpp"
+#include "random_bits.hpp"
+#include "precomputed_decoder.hpp"
+#include "fixed_point_decoder.hpp"
+#include "parallel_decoder.hpp"
+#include "utils/cpu_affinity.hpp"
+#include "utils/latency_histogram.hpp"
+#include "utils/tsc_clock.hpp"
+
+#ifdef __AVX2__
+#include "simd_decoder.hpp"
+#include "simd_fixed_point_decoder.hpp"
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace qpsk;
+
+struct Options {
+    size_t samples = 20000;
+    double snr_db = 0.0;
+    double rate = 0.0;  // requests per second, 0 = closed loop
+};
+
+struct Inputs {
+    std::vector<std::vector<Complex>> symbols;
+    std::vector<std::vector<double>> llrs;
+};
+
+constexpr size_t INPUT_POOL_SIZE = 1024;
+
+template <typename T>
+void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <int N>
+Inputs generate_inputs(double snr_db) {
+    BlockEncoder<N> code;
+    QPSK mod;
+    Channel channel(snr_db);
+    std::mt19937 rng = make_rng(1);
+
+    Inputs inputs;
+    for (size_t i = 0; i < INPUT_POOL_SIZE; ++i) {
+        auto rx = channel.apply(mod.modulate(code.encode(generate_random_bits<N>(rng))), rng);
+        inputs.llrs.push_back(mod.demodulate(rx));
+        inputs.symbols.push_back(std::move(rx));
+    }
+    return inputs;
+}
+
+template <typename Decoder>
+LatencyHistogram measure_decode(const Decoder& decoder, const Inputs& inputs, size_t samples) {
+    LatencyHistogram histogram;
+
+    for (size_t i = 0; i < samples; ++i) {
+        const auto& llrs = inputs.llrs[i % INPUT_POOL_SIZE];
+
+        uint64_t start = read_tsc();
+        auto result = decoder.decode(llrs);
+        uint64_t end = read_tsc();
+
+        do_not_optimize(result);
+        histogram.record(tsc_to_ns(end - start));
+    }
+
+    return histogram;
+}
+
+// Demodulation + decoding. With rate > 0 requests arrive on a fixed schedule
+// and latency is measured from the scheduled arrival, so time spent waiting
+// behind earlier requests is included.
+template <typename Decoder>
+LatencyHistogram measure_end_to_end(const Decoder& decoder, const Inputs& inputs,
+                                    size_t samples, double rate, size_t& late) {
+    QPSK mod;
+    LatencyHistogram histogram;
+    late = 0;
+
+    const double interval = rate > 0.0 ? tsc_ticks_per_ns() * 1e9 / rate : 0.0;
+    const uint64_t origin = read_tsc();
+
+    for (size_t i = 0; i < samples; ++i) {
+        const auto& symbols = inputs.symbols[i % INPUT_POOL_SIZE];
+
+        uint64_t arrival = read_tsc();
+        if (rate > 0.0) {
+            arrival = origin + static_cast<uint64_t>(interval * static_cast<double>(i));
+            uint64_t now = read_tsc();
+            if (now > arrival) {
+                ++late;
+            }
+            while (now < arrival) {
+                cpu_relax();
+                now = read_tsc();
+            }
+        }
+
+        auto result = decoder.decode(mod.demodulate(symbols));
+        uint64_t end = read_tsc();
+
+        do_not_optimize(result);
+        histogram.record(tsc_to_ns(end - arrival));
+    }
+
+    return histogram;
+}
+
+void print_header() {
+    std::cout << std::left << std::setw(16) << "Decoder" << std::setw(8) << "Path" << std::right
+              << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+              << std::setw(10) << "p99.9" << std::setw(10) << "max" << "   (ns)\n";
+    std::cout << std::string(74, '-') << "\n";
+}
+
+void print_row(const std::string& name, const std::string& path, const LatencyHistogram& h) {
+    std::cout << std::left << std::setw(16) << name << std::setw(8) << path << std::right
+              << std::setw(10) << h.percentile(50.0) << std::setw(10) << h.percentile(90.0)
+              << std::setw(10) << h.percentile(99.0) << std::setw(10) << h.percentile(99.9)
+              << std::setw(10) << h.max() << "\n";
+}
+
+template <typename Decoder>
+void run_decoder(const Decoder& decoder, const Inputs& inputs, const Options& options) {
+    for (size_t i = 0; i < 100; ++i) {
+        decoder.decode(inputs.llrs[i % INPUT_POOL_SIZE]);
+    }
+
+    print_row(decoder.name(), "decode", measure_decode(decoder, inputs, options.samples));
+
+    size_t late = 0;
+    auto e2e = measure_end_to_end(decoder, inputs, options.samples, options.rate, late);
+    print_row(decoder.name(), options.rate > 0.0 ? "open" : "e2e", e2e);
+
+    if (options.rate > 0.0 && late * 10 > options.samples) {
+        std::cout << "  " << decoder.name() << " cannot keep up with " << options.rate
+                  << " req/s (" << late << " late arrivals)\n";
+    }
+}
+
+template <int N>
+void run_latency(const Options& options) {
+    std::cout << "\n========================================\n";
+    std::cout << "Latency for N = " << N << " bits, SNR = " << options.snr_db << " dB\n";
+    std::cout << "Samples: " << options.samples;
+    if (options.rate > 0.0) {
+        std::cout << ", open loop at " << options.rate << " req/s";
+    }
+    std::cout << "\n========================================\n";
+
+    auto inputs = generate_inputs<N>(options.snr_db);
+    print_header();
+
+    run_decoder(PrecomputedDecoder<N>(), inputs, options);
+    run_decoder(FixedPointDecoder<N>(), inputs, options);
+#ifdef __AVX2__
+    run_decoder(SimdDecoder<N>(), inputs, options);
+    run_decoder(SimdFixedPointDecoder<N>(), inputs, options);
+#endif
+}
+
+// ParallelDecoder with the crossover heuristic bypassed.
+template <int N>
+struct ForcedParallel {
+    const ParallelDecoder<N>& decoder;
+    bool parallel;
+
+    std::bitset<N> decode(const std::vector<double>& llrs) const { return decoder.decode(llrs, parallel); }
+    std::string name() const {
+        return parallel ? "Parallel x" + std::to_string(decoder.helpers()) : "Parallel serial";
+    }
+};
+
+template <int N>
+void run_parallel_latency(const Options& options) {
+    std::cout << "\n========================================\n";
+    std::cout << "Intra-decode parallelism for N = " << N << " bits, SNR = " << options.snr_db << " dB\n";
+    std::cout << "Samples: " << options.samples << ", CPUs: " << allowed_cpus().size() << "\n";
+    std::cout << "========================================\n";
+
+    auto inputs = generate_inputs<N>(options.snr_db);
+
+    // Helpers go on the CPUs after the first one, which is left to the caller.
+    std::vector<int> cpus = allowed_cpus();
+    if (cpus.size() > 1) {
+        std::rotate(cpus.begin(), cpus.begin() + 1, cpus.end());
+    }
+
+    print_header();
+    for (int helpers : {0, 1, 2, 4, 8}) {
+        ParallelDecoder<N> decoder(helpers, cpus);
+        const ForcedParallel<N> forced{decoder, helpers > 0};
+        print_row(forced.name(), "decode", measure_decode(forced, inputs, options.samples));
+    }
+
+    std::cout << "\nCrossover heuristic (mean ns/decode at construction):\n";
+    for (int helpers : {1, 2, 4, 8}) {
+        ParallelDecoder<N> decoder(helpers, cpus);
+        std::cout << "  " << helpers << " helpers: serial " << static_cast<long>(decoder.serial_ns())
+                  << ", parallel " << static_cast<long>(decoder.parallel_ns())
+                  << " -> " << (decoder.parallel() ? "parallel" : "serial") << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Usage: " << argv[0] << " [--samples N] [--snr dB] [--rate req_per_s]\n";
+            return 1;
+        }
+        if (arg == "--samples") {
+            options.samples = std::stoul(argv[++i]);
+        } else if (arg == "--snr") {
+            options.snr_db = std::stod(argv[++i]);
+        } else if (arg == "--rate") {
+            options.rate = std::stod(argv[++i]);
+        } else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << "\n========================================\n";
+    std::cout << "Decoder Latency Benchmark\n";
+    std::cout << "TSC: " << std::fixed << std::setprecision(3) << tsc_ticks_per_ns() << " ticks/ns\n";
+    std::cout << "========================================\n";
+    std::cout.unsetf(std::ios::floatfield);
+
+    run_latency<2>(options);
+    run_latency<4>(options);
+    run_latency<6>(options);
+    run_latency<8>(options);
+    run_latency<11>(options);
+
+    run_parallel_latency<11>(options);
+
+    return 0;
+}
@@ -1,11 +1,26 @@
 #include "encoder.hpp"
 #include "basic_decoder.hpp"
 #include "precomputed_decoder.hpp"
+#include "partial_sum_decoder.hpp"
+#include "unrolled_decoder.hpp"
+#include "known_bits_decoder.hpp"
+#include "fixed_point_decoder.hpp"
+#include "branch_bound_decoder.hpp"
+#include "osd_decoder.hpp"
+#include "hard_decision_decoder.hpp"
+#include "qpsk.hpp"
+#include "channel.hpp"
+#include "random_bits.hpp"
+#include "simulation.hpp"
 
 #ifdef __AVX2__
 #include "simd_decoder.hpp"
+#include "simd_fixed_point_decoder.hpp"
 #endif
+#include "utils/trace.hpp"
 
+#include <algorithm>
+#include <filesystem>
 #include <iostream>
 #include <iomanip>
 #include <chrono>
@@ -40,6 +55,21 @@ double benchmark_decoder(const Decoder& decoder, const std::vector<double>& llrs
     return std::chrono::duration<double, std::milli>(end - start).count();
 }
 
+template <typename Decoder>
+double benchmark_quantized_decoder(const Decoder& decoder, const std::vector<int8_t>& llrs,
+                                   size_t iterations) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        volatile auto result = decoder.decode_quantized(llrs);
+        (void)result;
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
 template <int N>
 void run_benchmarks(size_t iterations) {
     std::cout << "\n========================================\n";
@@ -50,18 +80,25 @@ void run_benchmarks(size_t iterations) {
 
     BasicDecoder<N> basic;
     PrecomputedDecoder<N> precomputed;
+    FixedPointDecoder<N> fixed_point;
+    OsdDecoder<N> osd;
 #ifdef __AVX2__
     SimdDecoder<N> simd;
+    SimdFixedPointDecoder<N> simd_fixed_point;
 #endif
 
     auto llrs = generate_random_llrs();
+    auto quantized = quantize_llrs(llrs, DEFAULT_QUANTIZATION_BITS, 0.0);
 
     // Прогрев
     for (int i = 0; i < 100; ++i) {
         basic.decode(llrs);
         precomputed.decode(llrs);
+        fixed_point.decode_quantized(quantized);
+        osd.decode(llrs);
 #ifdef __AVX2__
         simd.decode(llrs);
+        simd_fixed_point.decode_quantized(quantized);
 #endif
     }
 
@@ -81,6 +118,376 @@ void run_benchmarks(size_t iterations) {
     std::cout << "AVX2.0: " << std::setw(13) << time_simd << " ms"
               << "  (x" << std::setprecision(2) << (time_basic / time_simd) << ")\n";
 #endif
+
+    double time_osd = benchmark_decoder<OsdDecoder<N>, N>(osd, llrs, iterations);
+    std::cout << "OSD (" << std::setw(3) << osd.budget() << "):   " << std::setprecision(3)
+              << std::setw(8) << time_osd << " ms"
+              << "  (x" << std::setprecision(2) << (time_basic / time_osd) << ")\n";
+
+    double time_fixed = benchmark_quantized_decoder(fixed_point, quantized, iterations);
+    std::cout << "Fixed int8:  " << std::setprecision(3) << std::setw(8) << time_fixed << " ms"
+              << "  (x" << std::setprecision(2) << (time_basic / time_fixed) << ")\n";
+
+#ifdef __AVX2__
+    double time_simd_fixed = benchmark_quantized_decoder(simd_fixed_point, quantized, iterations);
+    std::cout << "AVX2 int16:  " << std::setprecision(3) << std::setw(8) << time_simd_fixed << " ms"
+              << "  (x" << std::setprecision(2) << (time_basic / time_simd_fixed) << ")\n";
+#endif
+}
+
+template <int N>
+std::vector<std::vector<double>> generate_channel_llrs(double snr_db, size_t count) {
+    BlockEncoder<N> code;
+    QPSK mod;
+    Channel channel(snr_db);
+    std::mt19937 rng = make_rng(static_cast<uint64_t>(N));
+
+    std::vector<std::vector<double>> llrs;
+    llrs.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto rx = channel.apply(mod.modulate(code.encode(generate_random_bits<N>(rng))), rng);
+        llrs.push_back(mod.demodulate(rx));
+    }
+    return llrs;
+}
+
+template <typename Decoder>
+double benchmark_decoder_us(const Decoder& decoder, const std::vector<std::vector<double>>& llrs) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (const auto& v : llrs) {
+        volatile auto result = decoder.decode(v);
+        (void)result;
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::micro>(end - start).count() / llrs.size();
+}
+
+template <int N>
+void run_branch_bound_benchmarks(size_t count) {
+    std::cout << "\n========================================\n";
+    std::cout << "Branch-and-bound vs SNR, N = " << N << " bits\n";
+    std::cout << "Decodes per SNR: " << count << "\n";
+    std::cout << "========================================\n";
+    std::cout << "SNR(dB)   nodes/decode  BranchBound  Precomputed"
+#ifdef __AVX2__
+              << "       AVX2.0"
+#endif
+              << "   (us/decode)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    BranchBoundDecoder<N> branch_bound;
+    PrecomputedDecoder<N> precomputed;
+#ifdef __AVX2__
+    SimdDecoder<N> simd;
+#endif
+
+    for (double snr_db : {-6.0, -3.0, 0.0, 3.0, 6.0, 9.0}) {
+        auto llrs = generate_channel_llrs<N>(snr_db, count);
+
+        size_t nodes = 0;
+        for (const auto& v : llrs) {
+            size_t visited = 0;
+            branch_bound.decode(v, visited);
+            nodes += visited;
+        }
+
+        std::cout << std::fixed << std::setprecision(1) << std::setw(7) << snr_db
+                  << std::setw(15) << static_cast<double>(nodes) / count
+                  << std::setprecision(3)
+                  << std::setw(13) << benchmark_decoder_us(branch_bound, llrs)
+                  << std::setw(13) << benchmark_decoder_us(precomputed, llrs)
+#ifdef __AVX2__
+                  << std::setw(13) << benchmark_decoder_us(simd, llrs)
+#endif
+                  << "\n";
+    }
+}
+
+template <typename Decoder>
+double benchmark_decoder_ns(const Decoder& decoder, const std::vector<std::vector<double>>& llrs) {
+    double best = 1e300;
+    for (int repeat = 0; repeat < 5; ++repeat) {
+        best = std::min(best, benchmark_decoder_us(decoder, llrs) * 1000.0);
+    }
+    return best;
+}
+
+double partial_sum_build_ns(const std::vector<std::vector<double>>& llrs) {
+    PartialSumTables tables;
+    volatile double sink = 0.0;
+    double best = 1e300;
+    for (int repeat = 0; repeat < 5; ++repeat) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& v : llrs) {
+            build_partial_sums(v.data(), tables);
+            sink = sink + tables[3][31];
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count() / llrs.size());
+    }
+    return best;
+}
+
+template <int N>
+void run_partial_sum_row(size_t count) {
+    auto llrs = generate_channel_llrs<N>(0.0, count);
+
+    PartialSumDecoder<N> partial_sum;
+    PrecomputedDecoder<N> precomputed;
+#ifdef __AVX2__
+    SimdDecoder<N> simd;
+#endif
+
+    const double build = partial_sum_build_ns(llrs);
+    const double total = benchmark_decoder_ns(partial_sum, llrs);
+
+    std::cout << std::setw(2) << N << std::fixed << std::setprecision(1)
+              << std::setw(12) << build
+              << std::setw(14) << total
+              << std::setw(9) << build / total * 100.0 << "%"
+              << std::setw(14) << benchmark_decoder_ns(precomputed, llrs)
+#ifdef __AVX2__
+              << std::setw(12) << benchmark_decoder_ns(simd, llrs)
+#endif
+              << "\n";
+}
+
+void run_partial_sum_benchmarks(size_t count) {
+    std::cout << "\n========================================\n";
+    std::cout << "Partial-sum tables vs full scans (0 dB)\n";
+    std::cout << "Decodes per N: " << count << "\n";
+    std::cout << "========================================\n";
+    std::cout << " N  build(ns)  PartialSum  build share  Precomputed"
+#ifdef __AVX2__
+              << "      AVX2.0"
+#endif
+              << "   (ns/decode)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    run_partial_sum_row<2>(count);
+    run_partial_sum_row<4>(count);
+    run_partial_sum_row<6>(count);
+    run_partial_sum_row<8>(count);
+    run_partial_sum_row<11>(count);
+}
+
+template <int N>
+double unrolled_inline_ns(const std::vector<std::vector<double>>& llrs) {
+    double best = 1e300;
+    for (int repeat = 0; repeat < 5; ++repeat) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (const auto& v : llrs) {
+            volatile uint32_t result = unrolled_decode<N>(v.data());
+            (void)result;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count() / llrs.size());
+    }
+    return best;
+}
+
+template <int N>
+void run_unrolled_row(size_t count) {
+    auto llrs = generate_channel_llrs<N>(0.0, count);
+
+    PrecomputedDecoder<N> precomputed;
+    PartialSumDecoder<N> partial_sum;
+    UnrolledDecoder<N> unrolled;
+    // Called through the base class, as the registry hands it out.
+    const AbstractDecoder<N>& virtual_unrolled = unrolled;
+#ifdef __AVX2__
+    SimdDecoder<N> simd;
+#endif
+
+    std::cout << std::setw(2) << N << std::fixed << std::setprecision(1)
+              << std::setw(13) << benchmark_decoder_ns(precomputed, llrs)
+              << std::setw(12) << benchmark_decoder_ns(partial_sum, llrs)
+#ifdef __AVX2__
+              << std::setw(10) << benchmark_decoder_ns(simd, llrs)
+#endif
+              << std::setw(12) << benchmark_decoder_ns(virtual_unrolled, llrs)
+              << std::setw(10) << unrolled_inline_ns<N>(llrs) << "\n";
+}
+
+void run_unrolled_benchmarks(size_t count) {
+    std::cout << "\n========================================\n";
+    std::cout << "Unrolled Hadamard kernels vs candidate scans (0 dB)\n";
+    std::cout << "Decodes per N: " << count << "\n";
+    std::cout << "========================================\n";
+    std::cout << " N  Precomputed  PartialSum"
+#ifdef __AVX2__
+              << "    AVX2.0"
+#endif
+              << "    Unrolled    inline   (ns/decode)\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    run_unrolled_row<2>(count);
+    run_unrolled_row<4>(count);
+    run_unrolled_row<6>(count);
+    run_unrolled_row<8>(count);
+}
+
+template <int N>
+void run_hard_decision_row(size_t count) {
+    auto llrs = generate_channel_llrs<N>(0.0, count);
+
+    PartialSumDecoder<N> partial_sum;
+    UnrolledDecoder<N> unrolled;
+    HardDecisionDecoder<N> hard;
+    HardDecisionDecoder<N> hard_soft_tie(HardTieBreak::SoftMetric);
+
+    const double partial_sum_ns = benchmark_decoder_ns(partial_sum, llrs);
+    const double unrolled_ns = benchmark_decoder_ns(unrolled, llrs);
+    const double hard_ns = benchmark_decoder_ns(hard, llrs);
+    const double soft_tie_ns = benchmark_decoder_ns(hard_soft_tie, llrs);
+
+    std::cout << std::setw(2) << N << std::fixed << std::setprecision(1)
+              << std::setw(12) << partial_sum_ns
+              << std::setw(10) << unrolled_ns
+              << std::setw(8) << hard_ns
+              << std::setw(10) << soft_tie_ns
+              << std::setw(9) << std::min(partial_sum_ns, unrolled_ns) / hard_ns << "x\n";
+}
+
+void run_hard_decision_benchmarks(size_t count) {
+    std::cout << "\n========================================\n";
+    std::cout << "Hard-decision minimum distance vs soft ML (0 dB)\n";
+    std::cout << "Decodes per N: " << count << "\n";
+    std::cout << "========================================\n";
+    std::cout << " N  PartialSum  Unrolled    Hard   SoftTie   speedup   (ns/decode)\n";
+    std::cout << std::string(68, '-') << "\n";
+
+    run_hard_decision_row<2>(count);
+    run_hard_decision_row<4>(count);
+    run_hard_decision_row<6>(count);
+    run_hard_decision_row<8>(count);
+    run_hard_decision_row<11>(count);
+}
+
+template <int N>
+void run_known_bits_benchmarks(size_t count) {
+    std::cout << "\n========================================\n";
+    std::cout << "Known information bits, N = " << N << " bits (0 dB)\n";
+    std::cout << "Decodes per k: " << count << "\n";
+    std::cout << "========================================\n";
+    std::cout << " k  candidates  KnownBits  PartialSum   speedup   (ns/decode)\n";
+    std::cout << std::string(64, '-') << "\n";
+
+    auto llrs = generate_channel_llrs<N>(0.0, count);
+    PartialSumDecoder<N> full_search;
+    const double full_ns = benchmark_decoder_ns(full_search, llrs);
+
+    for (int k = 0; k < N; k += (k < 4 ? 1 : 2)) {
+        // The top k bits are known to be zero.
+        KnownBits known;
+        known.mask = ((1U << k) - 1) << (N - k);
+        KnownBitsDecoder<N> decoder(known);
+
+        const double ns = benchmark_decoder_ns(decoder, llrs);
+        std::cout << std::setw(2) << k << std::setw(12) << decoder.candidates()
+                  << std::fixed << std::setprecision(1) << std::setw(11) << ns
+                  << std::setw(12) << full_ns
+                  << std::setprecision(2) << std::setw(9) << full_ns / ns << "x\n";
+    }
+}
+
+double simulation_ns_per_trial(const SimulationConfig& config) {
+    auto start = std::chrono::high_resolution_clock::now();
+    simulate(config);
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / config.iterations;
+}
+
+void run_capture_overhead_benchmarks(long long iterations) {
+    std::cout << "\n========================================\n";
+    std::cout << "Error capture overhead (tuned decoder)\n";
+    std::cout << "Trials per run: " << iterations << "\n";
+    std::cout << "========================================\n";
+    std::cout << " N  SNR(dB)     BLER   off(ns/trial)  on(ns/trial)  overhead\n";
+    std::cout << std::string(64, '-') << "\n";
+
+    for (int n : {2, 11}) {
+        for (double snr_db : {10.0, 0.0}) {
+            SimulationConfig config;
+            config.n = n;
+            config.snr_db = snr_db;
+            config.iterations = iterations;
+            config.seed = 1;
+
+            const double bler = static_cast<double>(simulate(config).failed) / iterations;
+
+            SimulationConfig captured = config;
+            captured.capture.failures = 1024;
+            captured.capture.successes = 64;
+
+            // Interleave the runs so frequency drift hits both sides equally.
+            double off = 1e300;
+            double on = 1e300;
+            for (int repeat = 0; repeat < 5; ++repeat) {
+                off = std::min(off, simulation_ns_per_trial(config));
+                on = std::min(on, simulation_ns_per_trial(captured));
+            }
+
+            std::cout << std::setw(2) << n
+                      << std::fixed << std::setprecision(1) << std::setw(9) << snr_db
+                      << std::setprecision(4) << std::setw(9) << bler
+                      << std::setprecision(1) << std::setw(16) << off
+                      << std::setw(14) << on
+                      << std::setw(9) << (on / off - 1.0) * 100.0 << "%\n";
+        }
+    }
+}
+
+double traced_ns_per_trial(const SimulationConfig& config, uint32_t sample_period) {
+    TraceConfig trace;
+    trace.file = (std::filesystem::temp_directory_path() / "qpsk_benchmark_trace.json").string();
+    trace.sample_period = sample_period;
+    // Room for every span, so the run measures recording rather than dropping.
+    trace.buffer_spans = static_cast<size_t>(config.iterations) * 8;
+    start_tracing(trace);
+    const double ns = simulation_ns_per_trial(config);
+    stop_tracing();
+    return ns;
+}
+
+void run_trace_overhead_benchmarks(long long iterations) {
+    std::cout << "\n========================================\n";
+    std::cout << "Tracing overhead (tuned decoder, SNR 0 dB)\n";
+    std::cout << "Trials per run: " << iterations << "\n";
+#ifndef QPSK_TRACING
+    std::cout << "Built without QPSK_TRACING: spans are compiled out\n";
+#endif
+    std::cout << "========================================\n";
+    std::cout << " N  off(ns/trial)  all(ns/trial)  1/64(ns/trial)  overhead(all)  overhead(1/64)\n";
+    std::cout << std::string(82, '-') << "\n";
+
+    for (int n : {2, 11}) {
+        SimulationConfig config;
+        config.n = n;
+        config.snr_db = 0.0;
+        config.iterations = iterations;
+        config.seed = 1;
+        simulate(config);
+
+        double off = 1e300;
+        double all = 1e300;
+        double sampled = 1e300;
+        for (int repeat = 0; repeat < 5; ++repeat) {
+            off = std::min(off, simulation_ns_per_trial(config));
+            all = std::min(all, traced_ns_per_trial(config, 1));
+            sampled = std::min(sampled, traced_ns_per_trial(config, 64));
+        }
+
+        std::cout << std::setw(2) << n
+                  << std::fixed << std::setprecision(1) << std::setw(15) << off
+                  << std::setw(15) << all
+                  << std::setw(16) << sampled
+                  << std::setw(14) << (all / off - 1.0) * 100.0 << "%"
+                  << std::setw(15) << (sampled / off - 1.0) * 100.0 << "%\n";
+    }
 }
 
 int main() {
@@ -95,5 +502,18 @@ int main() {
     run_benchmarks<8>(10000);
     run_benchmarks<11>(10000);
 
+    run_branch_bound_benchmarks<8>(2000);
+    run_branch_bound_benchmarks<11>(2000);
+
+    run_partial_sum_benchmarks(2000);
+    run_unrolled_benchmarks(2000);
+    run_hard_decision_benchmarks(2000);
+
+    run_known_bits_benchmarks<8>(2000);
+    run_known_bits_benchmarks<11>(2000);
+
+    run_capture_overhead_benchmarks(200000);
+    run_trace_overhead_benchmarks(20000);
+
     return 0;
 }
@@ -0,0 +1,167 @@
+#include "batch_scheduler.hpp"
+#include "decoder_registry.hpp"
+#include "decoder_tuner.hpp"
+#include "encoder.hpp"
+#include "qpsk.hpp"
+#include "channel.hpp"
+#include "random_bits.hpp"
+#include "utils/thread_pool.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace qpsk;
+
+namespace {
+
+struct Options {
+    size_t reports = 512;
+    size_t batches = 200;
+    double snr_db = 0.0;
+    size_t threads = std::max(1U, std::thread::hardware_concurrency());
+};
+
+template <int N>
+DecodeRequest make_request(const Channel& channel, std::mt19937& rng) {
+    BlockEncoder<N> code;
+    QPSK mod;
+    auto symbols = channel.apply(mod.modulate(code.encode(generate_random_bits<N>(rng))), rng);
+    return {N, mod.demodulate(symbols)};
+}
+
+std::vector<DecodeRequest> generate_batch(const Options& options) {
+    static constexpr int SIZES[] = {2, 4, 6, 8, 11};
+
+    Channel channel(options.snr_db);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, 4);
+
+    std::vector<DecodeRequest> batch;
+    for (size_t i = 0; i < options.reports; ++i) {
+        switch (SIZES[pick(rng)]) {
+            case 2:  batch.push_back(make_request<2>(channel, rng)); break;
+            case 4:  batch.push_back(make_request<4>(channel, rng)); break;
+            case 6:  batch.push_back(make_request<6>(channel, rng)); break;
+            case 8:  batch.push_back(make_request<8>(channel, rng)); break;
+            case 11: batch.push_back(make_request<11>(channel, rng)); break;
+        }
+    }
+    return batch;
+}
+
+template <int N>
+uint32_t decode_one(const std::vector<double>& llrs) {
+    return static_cast<uint32_t>(shared_decoder<N>(select_decoder(N)).decode(llrs).to_ulong());
+}
+
+// What a mode does for every report: switch on N, look the decoder up, decode.
+uint32_t dispatch(const DecodeRequest& request) {
+    switch (request.n) {
+        case 2:  return decode_one<2>(request.llrs);
+        case 4:  return decode_one<4>(request.llrs);
+        case 6:  return decode_one<6>(request.llrs);
+        case 8:  return decode_one<8>(request.llrs);
+        default: return decode_one<11>(request.llrs);
+    }
+}
+
+template <typename Run>
+double measure_ns_per_report(const Options& options, Run run) {
+    run();
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < options.batches; ++b) {
+        run();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (options.batches * options.reports);
+}
+
+void print_row(const std::string& name, double ns, double baseline, bool matches) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << ns << std::setw(10) << std::setprecision(2) << baseline / ns << "x"
+              << (matches ? "" : "   MISMATCH") << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Usage: " << argv[0] << " [--reports N] [--batches N] [--snr dB] [--threads N]\n";
+            return 1;
+        }
+        if (arg == "--reports") {
+            options.reports = std::stoul(argv[++i]);
+        } else if (arg == "--batches") {
+            options.batches = std::stoul(argv[++i]);
+        } else if (arg == "--snr") {
+            options.snr_db = std::stod(argv[++i]);
+        } else if (arg == "--threads") {
+            options.threads = std::stoul(argv[++i]);
+        } else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return 1;
+        }
+    }
+
+    const auto batch = generate_batch(options);
+
+    std::cout << "\n========================================\n";
+    std::cout << "Mixed-N Batch Scheduler Benchmark\n";
+    std::cout << "Reports per batch: " << options.reports << ", N uniform over {2, 4, 6, 8, 11}, SNR = "
+              << options.snr_db << " dB, batches: " << options.batches << "\n";
+    std::cout << "========================================\n";
+
+    std::vector<uint32_t> reference(batch.size());
+    const double naive_ns = measure_ns_per_report(options, [&] {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            reference[i] = dispatch(batch[i]);
+        }
+    });
+
+    std::vector<uint32_t> pooled(batch.size());
+    ThreadPool thread_pool(options.threads);
+    const double pooled_ns = measure_ns_per_report(options, [&] {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            thread_pool.submit([&, i] { pooled[i] = dispatch(batch[i]); });
+        }
+        thread_pool.wait();
+    });
+
+    BatchScheduler serial(1);
+    std::vector<uint32_t> serial_results;
+    const double serial_ns = measure_ns_per_report(options, [&] { serial_results = serial.decode(batch); });
+
+    BatchScheduler parallel(options.threads);
+    std::vector<uint32_t> parallel_results;
+    const double parallel_ns = measure_ns_per_report(options, [&] { parallel_results = parallel.decode(batch); });
+
+    std::cout << "Calibrated ns/decode:";
+    for (int n : {2, 4, 6, 8, 11}) {
+        std::cout << "  N=" << n << " " << std::fixed << std::setprecision(1) << parallel.cost_ns(n);
+    }
+    std::cout << "\n\n";
+
+    std::cout << std::left << std::setw(28) << "Dispatch" << std::right << std::setw(12) << "ns/report"
+              << std::setw(11) << "speedup" << "\n";
+    std::cout << std::string(51, '-') << "\n";
+    print_row("per-request, 1 thread", naive_ns, naive_ns, true);
+    print_row("per-request, " + std::to_string(options.threads) + " threads", pooled_ns, naive_ns,
+              pooled == reference);
+    print_row("scheduler, 1 thread", serial_ns, naive_ns, serial_results == reference);
+    print_row("scheduler, " + std::to_string(options.threads) + " threads", parallel_ns, naive_ns,
+              parallel_results == reference);
+
+    const auto& stats = parallel.last_stats();
+    std::cout << "\nLast batch: " << stats.groups << " groups, " << stats.tasks << " tasks, "
+              << stats.steals << " steals\n";
+
+    return 0;
+}
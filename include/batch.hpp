@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace qpsk {
+
+struct BatchSummary {
+    size_t jobs = 0;
+    size_t failed = 0;
+    double seconds = 0.0;
+};
+
+// Expands directories into their *.json files (sorted); files are kept as given.
+std::vector<std::string> collect_batch_inputs(const std::vector<std::string>& paths);
+
+// Output file of `input` inside `output_dir`: <stem>.result.json.
+std::string batch_output_path(const std::string& input, const std::string& output_dir);
+
+// Runs every input job on `threads` workers and writes each result atomically
+// to batch_output_path(). Failed jobs produce no result file; jobs in the
+// "sharded simulation", "realtime" and "tune" modes are rejected as failed.
+BatchSummary run_batch(const std::vector<std::string>& inputs, const std::string& output_dir, size_t threads);
+
+} // namespace qpsk
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "decoder_registry.hpp"
+#include "utils/work_stealing_pool.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace qpsk {
+
+struct DecodeRequest {
+    int n = 0;
+    std::vector<double> llrs;
+};
+
+struct ScheduleStats {
+    size_t groups = 0;
+    size_t tasks = 0;
+    uint64_t steals = 0;
+};
+
+// Decodes heterogeneous batches of reports. Requests are grouped by N so
+// each codebook stays hot in one worker's cache, the groups are cut into
+// tasks of roughly equal measured decode cost, and the tasks are placed on
+// the least loaded worker of a WorkStealingPool (largest first); stealing
+// absorbs whatever the cost estimate got wrong.
+//
+// Not thread-safe: one batch at a time.
+class BatchScheduler {
+public:
+    // `decoder` empty selects the tuned decoder for every N.
+    explicit BatchScheduler(size_t threads, std::string decoder = "", DecoderOptions options = {});
+
+    // Information word of every request, bit i of the result being bit i of
+    // the decoded bitset. Throws std::invalid_argument on an invalid N or LLR
+    // vector size.
+    std::vector<uint32_t> decode(const std::vector<DecodeRequest>& requests);
+
+    // Calibrated nanoseconds per decode for N; measured on first use.
+    double cost_ns(int n);
+
+    size_t threads() const { return pool_.size(); }
+    const ScheduleStats& last_stats() const { return stats_; }
+
+private:
+    template <int N>
+    void bind();
+    template <int N>
+    void decode_range(const std::vector<DecodeRequest>& requests, const uint32_t* indices, size_t count,
+                      uint32_t* results) const;
+    void decode_task(int n, const std::vector<DecodeRequest>& requests, const uint32_t* indices, size_t count,
+                     uint32_t* results) const;
+
+    std::string decoder_;
+    DecoderOptions options_;
+    std::tuple<const AbstractDecoder<2>*, const AbstractDecoder<4>*, const AbstractDecoder<6>*,
+               const AbstractDecoder<8>*, const AbstractDecoder<11>*> decoders_{};
+    double cost_ns_[5] = {};
+    ScheduleStats stats_;
+    WorkStealingPool pool_;
+};
+
+} // namespace qpsk
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace qpsk {
+
+// Upper bounds on ML block error rate of the (20, N) code with QPSK over
+// AWGN, from the weight distribution of the code. snr_db is Es/N0 per QPSK
+// symbol as in Channel, so a pair of codewords at Hamming distance d is
+// confused with probability Q(sqrt(d * snr)).
+
+// min(1, sum_d A_d Q(sqrt(d * snr))).
+double union_bound_bler(int n, double snr_db);
+
+// Poltyrev's tangential-sphere bound with the SNR-independent optimal cone;
+// tighter than the union bound at low SNR, where the latter exceeds 1.
+double tangential_sphere_bound_bler(int n, double snr_db);
+
+} // namespace qpsk
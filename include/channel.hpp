@@ -3,6 +3,7 @@
 #include "system.hpp"
 
 #include <vector>
+#include <random>
 
 namespace qpsk {
 
@@ -11,6 +12,12 @@ public:
     explicit Channel(double snr_db) : snr_db_(snr_db) {}
 
     std::vector<Complex> apply(const std::vector<Complex>& signal) const;
+    std::vector<Complex> apply(const std::vector<Complex>& signal, std::mt19937& gen) const;
+    // apply() without the copy, for callers that reuse one buffer.
+    void apply_in_place(std::vector<Complex>& signal, std::mt19937& gen) const;
+    // Noise alone, at the level apply() adds to a unit-power signal such as
+    // QPSK: what the receiver sees when the UE did not transmit (DTX).
+    std::vector<Complex> noise(size_t count, std::mt19937& gen) const;
 
 private:
     static constexpr double GAUSSIAN_MEAN    = 0.0;
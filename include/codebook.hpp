@@ -0,0 +1,50 @@
+#pragma once
+
+#include "encoder.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace qpsk {
+
+// Codeword of info word i packed into bits 0..19, shared by all users of N.
+template <int N>
+const std::array<uint32_t, 1ULL << N>& packed_codebook();
+
+// A_w for w = 0..CODEWORD_SIZE, computed once per N.
+const std::vector<uint64_t>& weight_distribution(int n);
+int minimum_distance(int n);
+
+// Open-addressing hash table from packed codeword to info word, sized to a
+// load factor of 1/4 so a lookup is almost always a single probe.
+template <int N>
+class CodewordTable {
+public:
+    CodewordTable();
+
+    // Info word of `word`, or -1 if it is not a codeword.
+    int find(uint32_t word) const {
+        size_t slot = hash(word);
+        while (keys_[slot] != EMPTY) {
+            if (keys_[slot] == word) {
+                return values_[slot];
+            }
+            slot = (slot + 1) & (SLOTS - 1);
+        }
+        return -1;
+    }
+
+private:
+    static constexpr size_t SLOTS = 1ULL << (N + 2);
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    static size_t hash(uint32_t word) {
+        return static_cast<size_t>((word * 0x9E3779B1U) >> (32 - (N + 2)));
+    }
+
+    std::array<uint32_t, SLOTS> keys_;
+    std::array<uint16_t, SLOTS> values_;
+};
+
+} // namespace qpsk
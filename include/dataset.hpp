@@ -0,0 +1,82 @@
+#pragma once
+
+#include "encoder.hpp"
+#include "decoder_registry.hpp"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace qpsk {
+
+// One simulated transmission. rx holds the received symbols as interleaved
+// (re, im) pairs, which QPSK::demodulate passes through as the LLRs; they are
+// kept in double so replay decodes exactly what simulate() decoded.
+struct DatasetRecord {
+    uint32_t tx_bits = 0;
+    uint32_t reserved = 0;
+    double rx[CODEWORD_SIZE] = {};
+};
+
+static_assert(std::is_trivially_copyable_v<DatasetRecord>, "DatasetRecord is written as raw bytes");
+static_assert(sizeof(DatasetRecord) == 168, "DatasetRecord layout is part of the dataset file format");
+
+struct DatasetConfig {
+    int n = 11;
+    double snr_db = 0.0;
+    long long count = 0;
+    uint64_t seed = 0;
+};
+
+// Draws `count` trials exactly as simulate() does for the same seed and
+// streams them to `path`; returns the file size in bytes.
+size_t write_dataset(const std::string& path, const DatasetConfig& config);
+
+// Read-only memory mapping of a dataset file; records are used in place.
+class Dataset {
+public:
+    explicit Dataset(const std::string& path);
+    ~Dataset();
+
+    Dataset(const Dataset&) = delete;
+    Dataset& operator=(const Dataset&) = delete;
+
+    int n() const { return n_; }
+    double snr_db() const { return snr_db_; }
+    uint64_t seed() const { return seed_; }
+    size_t size() const { return count_; }
+
+    const DatasetRecord& operator[](size_t i) const { return records_[i]; }
+
+private:
+    void* data_ = nullptr;
+    size_t bytes_ = 0;
+    int n_ = 0;
+    double snr_db_ = 0.0;
+    uint64_t seed_ = 0;
+    size_t count_ = 0;
+    const DatasetRecord* records_ = nullptr;
+};
+
+struct DecoderReplay {
+    std::string name;
+    long long failed = 0;
+    // Time spent inside decode(), excluding LLR conversion and bookkeeping.
+    double decode_ns = 0.0;
+};
+
+struct ReplayResult {
+    long long records = 0;
+    std::vector<DecoderReplay> decoders;
+    // disagreements[a][b]: records on which decoders a and b decided differently.
+    std::vector<std::vector<long long>> disagreements;
+    // Records on which not all decoders agreed.
+    long long any_disagreement = 0;
+};
+
+// Runs every named decoder over the same records in a single pass.
+ReplayResult replay_dataset(const Dataset& dataset, const std::vector<std::string>& decoders,
+                            const DecoderOptions& options = {});
+
+} // namespace qpsk
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "decode_result.hpp"
+
 #include <vector>
 #include <bitset>
 #include <string>
@@ -11,6 +13,9 @@ class AbstractDecoder {
 public:
     virtual ~AbstractDecoder() = default;
     virtual std::bitset<N> decode(const std::vector<double>& llrs) const = 0;
+    // Same decision as decode(), plus the best and runner-up metrics of the
+    // same candidate scan and, if `soft` is set, max-log bit LLRs.
+    virtual DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const = 0;
     virtual std::string name() const = 0;
 };
 
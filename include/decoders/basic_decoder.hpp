@@ -9,7 +9,13 @@ template <int N>
 class BasicDecoder : public AbstractDecoder<N> {
 public:
     std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
     std::string name() const override { return "Basic"; }
+
+private:
+    // Feeds every candidate's metric to sink.add(index, metric).
+    template <typename Sink>
+    void scan(const std::vector<double>& llrs, Sink& sink) const;
 };
 
 } // namespace qpsk
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "partial_sum_decoder.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace qpsk {
+
+// ML decision restricted to the codebook of one payload size.
+struct SizeHypothesis {
+    int n = 0;
+    uint32_t bits = 0;
+    double best_metric = 0.0;
+    // Best metric among the other words of this size.
+    double second_metric = 0.0;
+    // normalized_correlation() of the decision.
+    double correlation = 0.0;
+};
+
+struct BlindDetection {
+    // One entry per candidate size, ascending.
+    std::vector<SizeHypothesis> sizes;
+    // Index into `sizes` chosen by the selection rule.
+    size_t selected = 0;
+
+    const SizeHypothesis& decision() const { return sizes[selected]; }
+};
+
+// Payload-size detection when the receiver does not know N. The encoder
+// uses the first N columns of BASE_MATRIX, so the codebook of N is the
+// prefix [0, 2^N) of the codebook of any larger size. One ascending scan of
+// the largest candidate size therefore yields every smaller size's ML
+// decision: it is the running argmax when the scan reaches 2^N.
+//
+// A larger codebook always fits at least as well, so the rule picks the
+// smallest size whose correlation is within `margin` of the largest one's.
+class BlindDetector {
+public:
+    static constexpr double DEFAULT_MARGIN = 0.05;
+
+    // `sizes` must be valid payload sizes; empty means all of VALID_N_BITS.
+    explicit BlindDetector(std::vector<int> sizes = {}, double margin = DEFAULT_MARGIN);
+
+    BlindDetection detect(const std::vector<double>& llrs) const;
+
+    const std::vector<int>& sizes() const { return sizes_; }
+    double margin() const { return margin_; }
+
+private:
+    std::vector<int> sizes_;
+    double margin_;
+    const uint32_t* codebook_;
+};
+
+} // namespace qpsk
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "abstarct_decoder.hpp"
+#include "encoder.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace qpsk {
+
+// Exact ML search over the info bits. Bits are fixed in an order driven by the
+// most reliable codeword positions; a codeword position contributes to the
+// metric as soon as all info bits of its BASE_MATRIX row are fixed, and the
+// still undetermined positions are bounded by the sum of their positive LLRs.
+template <int N>
+class BranchBoundDecoder : public AbstractDecoder<N> {
+public:
+    BranchBoundDecoder();
+    std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
+    std::bitset<N> decode(const std::vector<double>& llrs, size_t& nodes_visited) const;
+    std::string name() const override { return "BranchBound"; }
+
+private:
+    struct Search;
+
+    void run(Search& s, const std::vector<double>& llrs) const;
+    void search(Search& s, int depth, uint32_t parity, uint32_t info, double partial) const;
+
+    std::array<uint32_t, N> columns_;
+    std::array<uint32_t, CODEWORD_SIZE> rows_;
+};
+
+} // namespace qpsk
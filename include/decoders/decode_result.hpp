@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace qpsk {
+
+// Everything one candidate scan knows about its decision. Metrics are the
+// decoders' correlation sum over the codeword's ones, in LLR units.
+template <int N>
+struct DecodeResult {
+    std::bitset<N> bits;
+    // Index of the winning candidate, i.e. the information word.
+    uint32_t index = 0;
+    double best_metric = 0.0;
+    // Best metric among the other candidates the decoder scored.
+    double second_metric = 0.0;
+    // Max-log LLR per information bit (positive favours 1); empty unless requested.
+    std::vector<double> soft;
+
+    double margin() const { return best_metric - second_metric; }
+};
+
+// Sum of |LLR|: no two codewords differ in metric by more, so it stands in for
+// a competitor that an approximate decoder never scored.
+inline double metric_span(const std::vector<double>& llrs) {
+    double span = 0.0;
+    for (double llr : llrs) {
+        span += std::abs(llr);
+    }
+    return span;
+}
+
+// Metric of one packed codeword (bit j is position j): the sum of the LLRs
+// at its ones.
+inline double codeword_metric(uint32_t codeword, const std::vector<double>& llrs) {
+    double metric = 0.0;
+    for (; codeword != 0; codeword &= codeword - 1) {
+        metric += llrs[__builtin_ctz(codeword)];
+    }
+    return metric;
+}
+
+// Bipolar correlation of the decided codeword with the received LLRs,
+// normalised by sqrt(20) * |llrs|: 1 for a noiseless codeword, independent of
+// the signal level, and small when only noise was received. Used as the DTX
+// detection statistic.
+inline double normalized_correlation(double best_metric, const std::vector<double>& llrs) {
+    double sum = 0.0;
+    double energy = 0.0;
+    for (double llr : llrs) {
+        sum += llr;
+        energy += llr * llr;
+    }
+    if (energy <= 0.0) {
+        return 0.0;
+    }
+    return (2.0 * best_metric - sum) / std::sqrt(static_cast<double>(llrs.size()) * energy);
+}
+
+// Running best, runner-up and per-bit maxima of a candidate scan. Candidates
+// must be added in ascending index order for ties to go to the lower index,
+// as in the plain decode() scans.
+template <int N>
+class CandidateRanking {
+public:
+    explicit CandidateRanking(bool soft) : soft_(soft) {
+        if (soft_) {
+            for (auto& side : max_) {
+                side.fill(-std::numeric_limits<double>::infinity());
+            }
+        }
+    }
+
+    void add(uint32_t index, double metric) {
+        if (metric > best_) {
+            second_ = best_;
+            best_ = metric;
+            best_index_ = index;
+        } else if (metric > second_) {
+            second_ = metric;
+        }
+
+        if (soft_) {
+            for (int i = 0; i < N; ++i) {
+                double& side = max_[(index >> i) & 1U][i];
+                side = std::max(side, metric);
+            }
+        }
+    }
+
+    // `span` bounds the metric gap to candidates that were never added.
+    DecodeResult<N> result(double span) const {
+        DecodeResult<N> r;
+        r.index = best_index_;
+        r.bits = std::bitset<N>(best_index_);
+        r.best_metric = best_;
+        r.second_metric = std::isfinite(second_) ? second_ : best_ - span;
+
+        if (soft_) {
+            r.soft.resize(N);
+            for (int i = 0; i < N; ++i) {
+                const bool one = (best_index_ >> i) & 1U;
+                const double other = max_[!one][i];
+                const double gap = std::isfinite(other) ? best_ - other : span;
+                r.soft[i] = one ? gap : -gap;
+            }
+        }
+        return r;
+    }
+
+private:
+    bool soft_;
+    double best_ = -std::numeric_limits<double>::infinity();
+    double second_ = -std::numeric_limits<double>::infinity();
+    uint32_t best_index_ = 0;
+    std::array<std::array<double, N>, 2> max_;
+};
+
+// Best-only counterpart of CandidateRanking for decode() scans that need no
+// runner-up. Same add() interface, so one scan can feed either; ties go to
+// the first candidate added.
+template <typename Metric = double>
+class BestCandidate {
+public:
+    void add(uint32_t index, Metric metric) {
+        if (metric > best_) {
+            best_ = metric;
+            index_ = index;
+        }
+    }
+
+    uint32_t index() const { return index_; }
+
+private:
+    Metric best_ = std::numeric_limits<Metric>::lowest();
+    uint32_t index_ = 0;
+};
+
+} // namespace qpsk
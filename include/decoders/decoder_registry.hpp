@@ -0,0 +1,41 @@
+#pragma once
+
+#include "abstarct_decoder.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace qpsk {
+
+struct DecoderInfo {
+    std::string name;
+    // Exact decoders return the ML decision; only they are auto-tuning candidates.
+    bool exact;
+    // False for decoders that run their own threads and so must be asked for by name.
+    bool tunable = true;
+};
+
+// Per-request settings of approximate decoders; exact ones ignore them.
+struct DecoderOptions {
+    // Number of test patterns scored by OSD; 0 keeps its default.
+    int budget = 0;
+    // Helper threads of the Parallel decoder and the CPUs they are pinned to;
+    // 0 uses one helper per spare CPU, up to 3.
+    int helpers = 0;
+    std::vector<int> helper_cpus;
+};
+
+// Decoders available in this build, in registration order.
+const std::vector<DecoderInfo>& registered_decoders();
+bool is_registered_decoder(const std::string& name);
+
+template <int N>
+std::unique_ptr<AbstractDecoder<N>> make_decoder(const std::string& name, const DecoderOptions& options = {});
+
+// Process-wide instance of a decoder, built on first use and kept warm for
+// later requests. Decoders are stateless, so it may be used from any thread.
+template <int N>
+const AbstractDecoder<N>& shared_decoder(const std::string& name, const DecoderOptions& options = {});
+
+} // namespace qpsk
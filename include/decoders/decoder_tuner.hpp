@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace qpsk {
+
+struct TuneResult {
+    int n = 0;
+    std::string decoder;
+    // (decoder name, ns per decode) for every candidate that was measured.
+    std::vector<std::pair<std::string, double>> timings_ns;
+};
+
+std::string cpu_model();
+
+// $QPSK_DECODER_CACHE, else $XDG_CACHE_HOME/qpsk/decoders.json, else ~/.cache/qpsk/decoders.json.
+std::string decoder_cache_path();
+
+TuneResult tune_decoder(int n);
+
+// Benchmarks every exact decoder for every valid N and stores the winners.
+std::vector<TuneResult> tune_decoders();
+
+// Fastest exact decoder for N on this CPU: taken from the cache file when
+// present, otherwise measured once and persisted.
+std::string select_decoder(int n);
+
+} // namespace qpsk
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "abstarct_decoder.hpp"
+#include "codebook.hpp"
+
+#include <memory>
+
+namespace qpsk {
+
+// Hard-slices the LLRs and, if the sign word is a codeword, returns it without
+// searching: it maximises the metric over all 2^20 words, and it is the unique
+// ML decision when the d_min smallest |LLR| add up to more than zero, since
+// every other codeword gives up at least that much. Otherwise the fallback
+// decoder runs the full search.
+template <int N>
+class EarlyExitDecoder : public AbstractDecoder<N> {
+public:
+    EarlyExitDecoder();
+    explicit EarlyExitDecoder(std::unique_ptr<AbstractDecoder<N>> fallback);
+
+    std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
+    std::bitset<N> decode(const std::vector<double>& llrs, bool& early_exit) const;
+    std::string name() const override { return "EarlyExit"; }
+
+private:
+    CodewordTable<N> table_;
+    int min_distance_;
+    std::unique_ptr<AbstractDecoder<N>> fallback_;
+};
+
+} // namespace qpsk
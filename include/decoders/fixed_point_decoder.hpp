@@ -0,0 +1,47 @@
+#pragma once
+
+#include "abstarct_decoder.hpp"
+#include "encoder.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace qpsk {
+
+constexpr int DEFAULT_QUANTIZATION_BITS = 8;
+
+// Quantizes double LLRs with `scale` (or, if scale <= 0, so that the largest
+// |LLR| of each vector maps to the top level) and correlates in integers.
+// The scale actually used is stored in `applied_scale` when given.
+std::vector<int8_t> quantize_llrs(const std::vector<double>& llrs, int bits, double scale,
+                                  double* applied_scale = nullptr);
+
+// Feeds integer metrics to a CandidateRanking in LLR units.
+template <int N>
+struct ScaledRanking {
+    CandidateRanking<N>& ranking;
+    double scale;
+
+    void add(uint32_t index, int32_t metric) { ranking.add(index, metric / scale); }
+};
+
+template <int N>
+class FixedPointDecoder : public AbstractDecoder<N> {
+public:
+    explicit FixedPointDecoder(int bits = DEFAULT_QUANTIZATION_BITS, double scale = 0.0);
+    std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
+    std::bitset<N> decode_quantized(const std::vector<int8_t>& llrs) const;
+    std::string name() const override { return "FixedPoint"; }
+
+private:
+    // Feeds every candidate's integer metric to sink.add(index, metric).
+    template <typename Sink>
+    void scan(const std::vector<int8_t>& llrs, Sink& sink) const;
+
+    std::array<uint32_t, 1ULL << N> codewords_;
+    int bits_;
+    double scale_;
+};
+
+} // namespace qpsk
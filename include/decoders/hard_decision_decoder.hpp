@@ -0,0 +1,44 @@
+#pragma once
+
+#include "abstarct_decoder.hpp"
+#include "codebook.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace qpsk {
+
+// How HardDecisionDecoder settles candidates at the same Hamming distance.
+enum class HardTieBreak {
+    // Lowest information word, as the soft scans do on equal metrics.
+    LowestIndex,
+    // Largest soft correlation among the tied candidates.
+    SoftMetric,
+};
+
+// Bit j set when llrs[j] > 0, for the 20 LLRs of one codeword.
+uint32_t hard_slice(const double* llrs);
+
+// Slices the LLRs to a 20-bit word and returns the codeword nearest to it in
+// Hamming distance: XOR with every packed codeword and a popcount, eight
+// codewords per AVX2 instruction. This is ML decoding of the LLRs replaced
+// by +-mean|LLR|, so it costs about 2 dB of SNR against the soft decoders;
+// decode_full() reports metrics over those sliced LLRs.
+template <int N>
+class HardDecisionDecoder : public AbstractDecoder<N> {
+public:
+    explicit HardDecisionDecoder(HardTieBreak tie_break = HardTieBreak::LowestIndex);
+    std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
+    std::string name() const override {
+        return tie_break_ == HardTieBreak::SoftMetric ? "HardDecisionSoftTie" : "HardDecision";
+    }
+
+private:
+    uint32_t nearest(const double* llrs, uint32_t word) const;
+
+    const std::array<uint32_t, 1ULL << N>& codebook_;
+    HardTieBreak tie_break_;
+};
+
+} // namespace qpsk
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "system.hpp"
+#include "abstarct_decoder.hpp"
+#include "partial_sum_decoder.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace qpsk {
+
+// Information bits the receiver knows in advance (reserved or padding bits,
+// a fixed CQI/RI subset). Bit i of mask/values is pucch_f2_bits[i].
+struct KnownBits {
+    uint32_t mask = 0;
+    uint32_t values = 0;
+
+    bool empty() const { return mask == 0; }
+    int count() const { return __builtin_popcount(mask); }
+    // Forces the known positions of `word` to their values.
+    uint32_t apply(uint32_t word) const { return (word & ~mask) | values; }
+};
+
+// Parses parallel position/value lists; throws on out-of-range positions,
+// non-binary values, duplicates or mismatched lengths.
+KnownBits make_known_bits(int n, const std::vector<int>& positions, const std::vector<int>& values);
+
+// {"positions": [...], "values": [...]} of pucch_f2_bits known in advance.
+KnownBits parse_known_bits(const json& spec, int n);
+
+// ML decoder over the affine subcode consistent with the known bits: the
+// 2^(N-k) codewords c0 ^ x, where c0 encodes the known values and x ranges
+// over the span of the free bits' generator rows. Since
+//   sum_{c_j=1} llr_j = sum_{c0_j=1} llr_j + sum_{x_j=1} (c0_j ? -llr_j : llr_j),
+// the offset codeword is folded into the LLR signs once per decode and the
+// scan only scores the linear subcode, with partial-sum tables.
+template <int N>
+class KnownBitsDecoder : public AbstractDecoder<N> {
+public:
+    explicit KnownBitsDecoder(const KnownBits& known);
+
+    std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
+    std::string name() const override { return "KnownBits"; }
+
+    const KnownBits& known() const { return known_; }
+    size_t candidates() const { return subcode_.size(); }
+
+private:
+    // Offset-folded LLRs and the constant sum_{c0_j=1} llr_j.
+    double fold(const std::vector<double>& llrs, PartialSumTables& tables) const;
+
+    KnownBits known_;
+    uint32_t offset_ = 0;
+    // Packed subcode codewords and their full information words, both in
+    // ascending information-word order.
+    std::vector<uint32_t> subcode_;
+    std::vector<uint32_t> words_;
+};
+
+} // namespace qpsk
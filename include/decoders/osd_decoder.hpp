@@ -0,0 +1,40 @@
+#pragma once
+
+#include "abstarct_decoder.hpp"
+#include "encoder.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace qpsk {
+
+// Ordered-statistics decoder. Positions are sorted by |LLR|, the N most
+// reliable linearly independent BASE_MATRIX rows form the information set,
+// and the hard decisions on it are re-encoded together with a list of flip
+// patterns on its least reliable positions. Only `budget` patterns (the
+// order-0 one included) are scored, so the result is approximate unless the
+// budget covers the whole pattern list for small N.
+template <int N>
+class OsdDecoder : public AbstractDecoder<N> {
+public:
+    static constexpr int MAX_ORDER = 3;
+
+    // budget <= 0 selects DEFAULT_BUDGET (order-2 reprocessing).
+    explicit OsdDecoder(int budget = 0);
+    std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
+    std::string name() const override { return "OSD"; }
+
+    int budget() const { return static_cast<int>(patterns_.size()); }
+
+    static constexpr int DEFAULT_BUDGET = 1 + N + N * (N - 1) / 2;
+
+private:
+    std::array<uint32_t, CODEWORD_SIZE> rows_;
+    // Flip masks over the information set, indexed from its least reliable
+    // position, cheapest first.
+    std::vector<uint32_t> patterns_;
+};
+
+} // namespace qpsk
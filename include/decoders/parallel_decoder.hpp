@@ -0,0 +1,82 @@
+#pragma once
+
+#include "abstarct_decoder.hpp"
+#include "partial_sum_decoder.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace qpsk {
+
+// Exact decoder for single latency-critical reports: the candidate range is
+// split between the calling thread and `helpers` spinning (optionally pinned)
+// helper threads. Each scans its slice of the partial-sum tables and
+// publishes a local (metric, index) argmax in its own cache line; the caller
+// combines the slots in slice order, so ties resolve as in decode().
+//
+// The constructor times both paths and decode() keeps to the single-threaded
+// scan when that is faster (small N, or fewer free cores than helpers).
+// Helpers park on a condition variable after a short spin, so an idle decoder
+// costs no CPU. A decode() that finds the helpers busy with another caller's
+// request scans alone instead of waiting.
+template <int N>
+class ParallelDecoder : public AbstractDecoder<N> {
+public:
+    // `cpus[i]` pins helper i (cycled); empty leaves helpers unpinned.
+    explicit ParallelDecoder(int helpers, const std::vector<int>& cpus = {});
+    ~ParallelDecoder() override;
+
+    ParallelDecoder(const ParallelDecoder&) = delete;
+    ParallelDecoder& operator=(const ParallelDecoder&) = delete;
+
+    std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    // Runner-up and soft outputs need the whole ranking; computed serially.
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
+    std::string name() const override { return "Parallel"; }
+
+    // Bypasses the crossover heuristic.
+    std::bitset<N> decode(const std::vector<double>& llrs, bool parallel) const;
+
+    int helpers() const { return helpers_; }
+    bool parallel() const { return parallel_; }
+    double serial_ns() const { return serial_ns_; }
+    double parallel_ns() const { return parallel_ns_; }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> done{0};
+        double metric = 0.0;
+        uint32_t index = 0;
+    };
+
+    void helper_loop(int helper, int cpu);
+    uint64_t wait_for_work(uint64_t seen) const;
+    void scan(const PartialSumTables& tables, uint32_t begin, uint32_t end, double& metric, uint32_t& index) const;
+    uint32_t slice_begin(int slice) const;
+    uint32_t decode_parallel(const std::vector<double>& llrs) const;
+    void calibrate();
+
+    const std::array<uint32_t, 1ULL << N>& codebook_;
+    const int helpers_;
+    const uint64_t spin_ticks_;
+    bool parallel_ = false;
+    double serial_ns_ = 0.0;
+    double parallel_ns_ = 0.0;
+
+    // Request state, written by the caller holding busy_ before each release.
+    mutable PartialSumTables tables_;
+    mutable std::atomic<uint64_t> generation_{0};
+    mutable std::atomic_flag busy_ = ATOMIC_FLAG_INIT;
+    std::unique_ptr<Slot[]> slots_;
+
+    mutable std::mutex park_mutex_;
+    mutable std::condition_variable park_cv_;
+    mutable std::atomic<int> parked_{0};
+    std::atomic<bool> stop_{false};
+    std::vector<std::thread> threads_;
+};
+
+} // namespace qpsk
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "abstarct_decoder.hpp"
+#include "encoder.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace qpsk {
+
+// Codeword positions are split into groups of PARTIAL_SUM_GROUP_BITS; each
+// group gets a table of the LLR sums of all 2^5 subsets of its positions.
+constexpr int PARTIAL_SUM_GROUP_BITS = 5;
+constexpr int PARTIAL_SUM_GROUPS = CODEWORD_SIZE / PARTIAL_SUM_GROUP_BITS;
+constexpr int PARTIAL_SUM_ENTRIES = 1 << PARTIAL_SUM_GROUP_BITS;
+
+using PartialSumTables = std::array<std::array<double, PARTIAL_SUM_ENTRIES>, PARTIAL_SUM_GROUPS>;
+
+// 4 * 31 additions, independent of N.
+void build_partial_sums(const double* llrs, PartialSumTables& tables);
+
+// Correlation of a packed codeword: one lookup per group.
+inline double partial_sum_score(const PartialSumTables& tables, uint32_t codeword) {
+    return (tables[0][codeword & 31U] + tables[1][(codeword >> 5) & 31U]) +
+           (tables[2][(codeword >> 10) & 31U] + tables[3][codeword >> 15]);
+}
+
+// Scores every candidate with PARTIAL_SUM_GROUPS table lookups indexed by the
+// 5-bit fields of its packed codeword, instead of up to 20 conditional adds.
+// The tables are rebuilt for every LLR vector, so the decoder is stateless.
+template <int N>
+class PartialSumDecoder : public AbstractDecoder<N> {
+public:
+    PartialSumDecoder();
+    std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
+    std::string name() const override { return "PartialSum"; }
+
+    // Scan over tables that are already built; decode() is build + this.
+    uint32_t decode_tables(const PartialSumTables& tables) const;
+
+private:
+    const std::array<uint32_t, 1ULL << N>& codebook_;
+};
+
+} // namespace qpsk
@@ -12,9 +12,14 @@ class PrecomputedDecoder : public AbstractDecoder<N> {
 public:
     PrecomputedDecoder();
     std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
     std::string name() const override { return "Precomputed"; }
 
 private:
+    // Feeds every candidate's metric to sink.add(index, metric).
+    template <typename Sink>
+    void scan(const std::vector<double>& llrs, Sink& sink) const;
+
     std::array<std::bitset<CODEWORD_SIZE>, 1ULL << N> codewords_;
 };
 
@@ -12,9 +12,14 @@ class SimdDecoder : public AbstractDecoder<N> {
 public:
     SimdDecoder();
     std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
     std::string name() const override { return "SIMD"; }
 
 private:
+    // Feeds every candidate's metric to sink.add(index, metric).
+    template <typename Sink>
+    void scan(const std::vector<double>& llrs, Sink& sink) const;
+
     std::array<std::array<double, CODEWORD_SIZE>, 1ULL << N> masks_;
 };
 
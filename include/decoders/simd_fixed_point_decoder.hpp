@@ -0,0 +1,47 @@
+#pragma once
+
+#include "abstarct_decoder.hpp"
+#include "fixed_point_decoder.hpp"
+#include "encoder.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace qpsk {
+
+#ifdef __AVX2__
+
+constexpr size_t INT16_LANES = 16;
+
+template <int N>
+class SimdFixedPointDecoder : public AbstractDecoder<N> {
+public:
+    explicit SimdFixedPointDecoder(int bits = DEFAULT_QUANTIZATION_BITS, double scale = 0.0);
+    std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
+    std::bitset<N> decode_quantized(const std::vector<int8_t>& llrs) const;
+    std::string name() const override { return "SIMDFixedPoint"; }
+
+private:
+    static constexpr size_t BLOCKS = ((1ULL << N) + INT16_LANES - 1) / INT16_LANES;
+
+    // Metrics of all candidates, padding lanes included, 16 per block.
+    void score(const std::vector<int8_t>& llrs, int16_t* metrics) const;
+
+    // masks_[b][j][l] is -1 if codeword bit j of candidate b * 16 + l is set, 0 otherwise.
+    alignas(32) std::array<std::array<std::array<int16_t, INT16_LANES>, CODEWORD_SIZE>, BLOCKS> masks_;
+    int bits_;
+    double scale_;
+};
+
+#else
+
+template <int N>
+class SimdFixedPointDecoder : public AbstractDecoder<N> {
+private:
+    SimdFixedPointDecoder() = delete;
+};
+
+#endif
+
+} // namespace qpsk
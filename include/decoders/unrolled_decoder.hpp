@@ -0,0 +1,206 @@
+#pragma once
+
+#include "abstarct_decoder.hpp"
+#include "encoder.hpp"
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace qpsk {
+
+// Largest N whose kernel is generated as straight-line code; larger N run
+// the same transform as loops, since 2^N * N unrolled butterflies would
+// swamp the instruction cache.
+constexpr int UNROLLED_MAX_N = 6;
+
+// Smallest N that runs the transform in AVX2 registers. Below it the whole
+// transform fits in scalar registers, and reloading the gathered values as
+// vectors would stall on store forwarding.
+constexpr int UNROLLED_VECTOR_MIN_N = 5;
+
+namespace unrolled_detail {
+
+// BASE_MATRIX row i restricted to the first N columns: codeword bit i of
+// info word w is the parity of (w & row).
+template <int N>
+constexpr std::array<uint32_t, CODEWORD_SIZE> info_rows() {
+    std::array<uint32_t, CODEWORD_SIZE> rows{};
+    for (size_t i = 0; i < CODEWORD_SIZE; ++i) {
+        for (int j = 0; j < N; ++j) {
+            if (BASE_MATRIX[i][j]) {
+                rows[i] |= 1U << j;
+            }
+        }
+    }
+    return rows;
+}
+
+template <int N>
+inline constexpr std::array<uint32_t, CODEWORD_SIZE> INFO_ROWS = info_rows<N>();
+
+template <typename F, size_t... I>
+inline void unroll(F&& f, std::index_sequence<I...>) {
+    (f(std::integral_constant<size_t, I>{}), ...);
+}
+
+// f(0), ..., f(Count - 1): expanded at compile time with constant indices
+// when Unroll is set, a plain loop otherwise.
+template <size_t Count, bool Unroll, typename F>
+inline void repeat(F&& f) {
+    if constexpr (Unroll) {
+        unroll(f, std::make_index_sequence<Count>{});
+    } else {
+        for (size_t i = 0; i < Count; ++i) {
+            f(i);
+        }
+    }
+}
+
+// Negated sum of the LLRs at each row pattern; see unrolled_correlations().
+template <int N>
+inline void gather(const double* llrs, double* h) {
+    for (size_t w = 0; w < (size_t{1} << N); ++w) {
+        h[w] = 0.0;
+    }
+    repeat<CODEWORD_SIZE, N <= UNROLLED_MAX_N>([&](auto i) { h[INFO_ROWS<N>[i]] -= llrs[i]; });
+}
+
+#ifdef __AVX2__
+// Four words per register (N >= 2). Spans 1 and 2 of the transform stay inside a
+// register; wider spans pair whole registers.
+template <int N>
+inline void transform(__m256d* v) {
+    constexpr bool unrolled = N <= UNROLLED_MAX_N;
+    constexpr size_t VECTORS = (size_t{1} << N) / 4;
+
+    repeat<VECTORS, unrolled>([&](auto k) {
+        __m256d x = v[k];
+        __m256d swapped = _mm256_permute_pd(x, 0b0101);
+        x = _mm256_blend_pd(_mm256_add_pd(x, swapped), _mm256_sub_pd(swapped, x), 0b1010);
+        swapped = _mm256_permute2f128_pd(x, x, 0x01);
+        v[k] = _mm256_blend_pd(_mm256_add_pd(x, swapped), _mm256_sub_pd(swapped, x), 0b1100);
+    });
+
+    repeat<(N > 2 ? N - 2 : 0), unrolled>([&](auto s) {
+        const size_t span = size_t{1} << s;
+        repeat<VECTORS / 2, unrolled>([&](auto p) {
+            const size_t k = ((p >> s) << (s + 1)) | (p & (span - 1));
+            const __m256d a = v[k];
+            const __m256d b = v[k + span];
+            v[k] = _mm256_add_pd(a, b);
+            v[k + span] = _mm256_sub_pd(a, b);
+        });
+    });
+}
+
+template <int N>
+inline uint32_t argmax(const __m256d* v) {
+    constexpr bool unrolled = N <= UNROLLED_MAX_N;
+    constexpr size_t VECTORS = (size_t{1} << N) / 4;
+
+    __m256d m = v[0];
+    repeat<VECTORS, unrolled>([&](auto k) { m = _mm256_max_pd(m, v[k]); });
+    m = _mm256_max_pd(m, _mm256_permute2f128_pd(m, m, 0x01));
+    m = _mm256_max_pd(m, _mm256_permute_pd(m, 0b0101));
+
+    // Lowest index holding the maximum, so ties go to the lower word as in
+    // the candidate scans. A NaN LLR can make the maximum NaN, which equals
+    // nothing; the word is then 0.
+    if constexpr (unrolled) {
+        uint64_t hits = 0;
+        repeat<VECTORS, true>([&](auto k) {
+            hits |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(v[k], m, _CMP_EQ_OQ))) << (4 * k);
+        });
+        return hits != 0 ? static_cast<uint32_t>(__builtin_ctzll(hits)) : 0;
+    } else {
+        for (size_t k = 0; k < VECTORS; ++k) {
+            const int hits = _mm256_movemask_pd(_mm256_cmp_pd(v[k], m, _CMP_EQ_OQ));
+            if (hits != 0) {
+                return static_cast<uint32_t>(4 * k + __builtin_ctz(hits));
+            }
+        }
+        return 0;
+    }
+}
+#endif
+
+template <int N>
+inline void transform(double* h) {
+    constexpr bool unrolled = N <= UNROLLED_MAX_N;
+    repeat<N, unrolled>([&](auto s) {
+        const size_t span = size_t{1} << s;
+        repeat<(size_t{1} << (N - 1)), unrolled>([&](auto p) {
+            const size_t k = ((p >> s) << (s + 1)) | (p & (span - 1));
+            const double a = h[k];
+            const double b = h[k + span];
+            h[k] = a + b;
+            h[k + span] = a - b;
+        });
+    });
+}
+
+template <int N>
+inline uint32_t argmax(const double* h) {
+    uint32_t best = 0;
+    repeat<(size_t{1} << N), N <= UNROLLED_MAX_N>([&](auto w) {
+        best = h[w] > h[best] ? static_cast<uint32_t>(w) : best;
+    });
+    return best;
+}
+
+} // namespace unrolled_detail
+
+// Metrics of every candidate at once. With h[r] the negated sum of the LLRs
+// whose BASE_MATRIX row pattern is r, the Walsh-Hadamard transform of h is
+// W[w] = sum_i (-1)^(c_wi + 1) llr_i = 2 * metric(w) - sum(llrs), so N
+// butterfly stages over 2^N values replace the 2^N * 20 candidate scan.
+// For N up to UNROLLED_MAX_N the gather, every butterfly and the argmax are
+// expanded at compile time into straight-line code with constant indices.
+template <int N>
+inline void unrolled_correlations(const double* llrs, std::array<double, 1U << N>& h) {
+    unrolled_detail::gather<N>(llrs, h.data());
+#ifdef __AVX2__
+    if constexpr (N >= UNROLLED_VECTOR_MIN_N) {
+        __m256d v[(1U << N) / 4];
+        unrolled_detail::repeat<(1U << N) / 4, N <= UNROLLED_MAX_N>([&](auto k) { v[k] = _mm256_loadu_pd(&h[4 * k]); });
+        unrolled_detail::transform<N>(v);
+        unrolled_detail::repeat<(1U << N) / 4, N <= UNROLLED_MAX_N>([&](auto k) { _mm256_storeu_pd(&h[4 * k], v[k]); });
+        return;
+    }
+#endif
+    unrolled_detail::transform<N>(h.data());
+}
+
+// ML information word of 20 LLRs. Non-virtual and inline, for callers that
+// know N at compile time; the LLR count is not checked.
+template <int N>
+inline uint32_t unrolled_decode(const double* llrs) {
+    alignas(32) std::array<double, 1U << N> h;
+    unrolled_detail::gather<N>(llrs, h.data());
+#ifdef __AVX2__
+    if constexpr (N >= UNROLLED_VECTOR_MIN_N) {
+        __m256d v[(1U << N) / 4];
+        unrolled_detail::repeat<(1U << N) / 4, N <= UNROLLED_MAX_N>([&](auto k) { v[k] = _mm256_load_pd(&h[4 * k]); });
+        unrolled_detail::transform<N>(v);
+        return unrolled_detail::argmax<N>(v);
+    }
+#endif
+    unrolled_detail::transform<N>(h.data());
+    return unrolled_detail::argmax<N>(h.data());
+}
+
+template <int N>
+class UnrolledDecoder final : public AbstractDecoder<N> {
+public:
+    std::bitset<N> decode(const std::vector<double>& llrs) const override;
+    DecodeResult<N> decode_full(const std::vector<double>& llrs, bool soft = false) const override;
+    std::string name() const override { return "Unrolled"; }
+};
+
+} // namespace qpsk
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "encoder.hpp"
+#include "utils/ring_buffer.hpp"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace qpsk {
+
+// One simulated trial as stored in a capture file. rx holds the received
+// symbols as interleaved (re, im) pairs; QPSK::demodulate passes these
+// components through unchanged, so they are also the decoder's LLRs.
+// Metrics are the correlations sum_{j: c_j = 1} llr_j maximised by ML
+// decoding, taken over the whole codebook.
+struct TrialRecord {
+    uint64_t trial = 0;
+    uint32_t tx_bits = 0;
+    uint32_t rx_bits = 0;
+    uint32_t best_index = 0;
+    uint32_t runner_up_index = 0;
+    float best_metric = 0.0f;
+    float runner_up_metric = 0.0f;
+    float snr_db = 0.0f;
+    uint8_t n = 0;
+    uint8_t failed = 0;
+    uint16_t reserved = 0;
+    float rx[CODEWORD_SIZE] = {};
+};
+
+static_assert(std::is_trivially_copyable_v<TrialRecord>, "TrialRecord is written as raw bytes");
+static_assert(sizeof(TrialRecord) == 120, "TrialRecord layout is part of the capture file format");
+
+struct CaptureConfig {
+    // Ring capacities; both zero disables capture.
+    size_t failures = 0;
+    size_t successes = 0;
+    // Every sample_period-th successful trial is offered to the success ring.
+    long long sample_period = 1000;
+
+    bool enabled() const { return failures > 0 || successes > 0; }
+};
+
+struct CaptureDump {
+    uint64_t failures_seen = 0;
+    uint64_t successes_sampled = 0;
+    // Retained failures followed by retained successes, each oldest first.
+    std::vector<TrialRecord> records;
+};
+
+// Per-simulation capture state. The hot path is wants(), a branch on the
+// trial outcome plus a countdown; records are only built for captured trials.
+class ErrorCapture {
+public:
+    explicit ErrorCapture(const CaptureConfig& config);
+
+    bool wants(bool failed) {
+        if (failed) {
+            return failures_.capacity() > 0;
+        }
+        if (successes_.capacity() == 0 || --countdown_ > 0) {
+            return false;
+        }
+        countdown_ = period_;
+        return true;
+    }
+
+    template <int N>
+    void record(uint64_t trial, double snr_db, const std::bitset<N>& tx_bits,
+                const std::bitset<N>& rx_bits, const std::vector<double>& llrs);
+
+    CaptureDump dump() const;
+
+private:
+    RingBuffer<TrialRecord> failures_;
+    RingBuffer<TrialRecord> successes_;
+    long long period_;
+    long long countdown_;
+};
+
+void write_capture(const std::string& path, const CaptureDump& dump);
+CaptureDump read_capture(const std::string& path);
+
+} // namespace qpsk
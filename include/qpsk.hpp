@@ -13,10 +13,20 @@ constexpr size_t QPSK_SYMBOLS_COUNT   = CODEWORD_SIZE / QPSK_STD_SYMBOL_SIZE;
 
 const double NORM = 1.0 / std::sqrt(2.0);
 
+constexpr int MIN_QUANTIZATION_BITS = 2;
+constexpr int MAX_QUANTIZATION_BITS = 8;
+constexpr double QUANTIZATION_CLIP_SIGMAS = 2.0;
+
 class QPSK {
 public:
     std::vector<Complex> modulate(const std::bitset<CODEWORD_SIZE>& bits) const;
     std::vector<double> demodulate(const std::vector<Complex>& symbols) const;
+    std::vector<int8_t> demodulate_quantized(const std::vector<Complex>& symbols,
+                                             int bits, double scale) const;
+
+    // Maps the amplitude NORM + QUANTIZATION_CLIP_SIGMAS * sigma to the largest
+    // representable level, sigma being the per-component noise at snr_db.
+    static double quantization_scale(double snr_db, int bits);
 };
 
 } // namespace qpsk
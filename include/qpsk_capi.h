@@ -0,0 +1,55 @@
+#ifndef QPSK_CAPI_H
+#define QPSK_CAPI_H
+
+/*
+ * Stable C interface of qpsk_core for in-process use (e.g. Python ctypes).
+ *
+ * Symbols are exchanged as interleaved (re, im) doubles, QPSK_CAPI_SYMBOLS
+ * complex values per codeword. Bits are one uint8_t (0 or 1) per bit.
+ * Functions return 0 on success and -1 on error; qpsk_last_error() then
+ * describes the failure for the calling thread. A NULL or empty decoder name
+ * selects the decoder tuned for the host.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define QPSK_CAPI_VERSION 2
+#define QPSK_CAPI_SYMBOLS 10
+
+#if defined(__GNUC__)
+#define QPSK_API __attribute__((visibility("default")))
+#else
+#define QPSK_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+QPSK_API int qpsk_capi_version(void);
+QPSK_API const char* qpsk_last_error(void);
+
+/* bits: count * n values, symbols: count * QPSK_CAPI_SYMBOLS * 2 doubles. */
+QPSK_API int qpsk_encode_batch(int n, const uint8_t* bits, size_t count, double* symbols);
+
+/* symbols: count * QPSK_CAPI_SYMBOLS * 2 doubles, bits: count * n values. */
+QPSK_API int qpsk_decode_batch(int n, const double* symbols, size_t count, uint8_t* bits,
+                               const char* decoder);
+
+QPSK_API int qpsk_simulate_point(int n, double snr_db, long long iterations, uint64_t seed,
+                                 const char* decoder, long long* failed);
+
+/* Point i uses a seed derived from (seed, i), so a sweep is reproducible. */
+QPSK_API int qpsk_simulate_sweep(int n, const double* snr_db, size_t count, long long iterations,
+                                 uint64_t seed, const char* decoder, double* bler);
+
+/* Analytical ML BLER upper bounds; either output may be NULL to skip it. */
+QPSK_API int qpsk_bler_bounds(int n, const double* snr_db, size_t count, double* union_bound,
+                              double* tangential_sphere_bound);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* QPSK_CAPI_H */
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "decoder_registry.hpp"
+#include "utils/latency_histogram.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace qpsk {
+
+struct RealtimeConfig {
+    // Report sizes drawn uniformly for every codeword of the input pool.
+    std::vector<int> sizes;
+    double snr_db = 0.0;
+    // 1 ms at 15 kHz SCS, 0.5 ms at 30 kHz.
+    int64_t tti_ns = 1000000;
+    int reports_per_tti = 1;
+    long long ttis = 1000;
+    int workers = 1;
+    // CPUs for the workers in order; empty takes them from the process
+    // affinity mask. Ignored when `pin` is false.
+    std::vector<int> cpus;
+    bool pin = true;
+    // SCHED_FIFO priority of the workers; 0 keeps the default policy.
+    int fifo_priority = 0;
+    bool lock_memory = true;
+    uint64_t seed = 0;
+    // Registered decoder name; empty selects the tuned decoder per N.
+    std::string decoder;
+    DecoderOptions decoder_options;
+};
+
+struct RealtimeResult {
+    long long ttis = 0;
+    long long reports = 0;
+    long long failed = 0;
+    long long misses = 0;
+    // Per TTI, relative to its release time, in nanoseconds. Met TTIs go to
+    // `slack` (deadline - completion), missed ones to `lateness`.
+    LatencyHistogram slack;
+    LatencyHistogram lateness;
+    LatencyHistogram processing;
+    // Per worker and TTI: wake-up time minus release time.
+    LatencyHistogram wakeup;
+    // Whether the requested environment was actually granted.
+    bool memory_locked = false;
+    bool pinned = false;
+    bool fifo = false;
+};
+
+// Releases `reports_per_tti` codewords every TTI on an absolute
+// CLOCK_MONOTONIC timer and decodes them on `workers` threads, each taking
+// every workers-th report of the batch. A TTI is missed when its last report
+// completes after the next release. Throws std::invalid_argument on a bad
+// configuration; unavailable pinning, mlock or SCHED_FIFO only clear the
+// corresponding RealtimeResult flag.
+RealtimeResult run_realtime(const RealtimeConfig& config);
+
+struct RealtimeProbe {
+    int reports_per_tti = 0;
+    long long ttis = 0;
+    long long misses = 0;
+};
+
+struct RealtimeCapacity {
+    // 0 if even a single report per TTI misses too often.
+    int max_reports_per_tti = 0;
+    std::vector<RealtimeProbe> probes;
+};
+
+// Largest reports_per_tti (up to `limit`) whose miss rate over config.ttis
+// TTIs stays at or below `max_miss_rate`: doubling, then bisection.
+RealtimeCapacity find_max_reports_per_tti(const RealtimeConfig& config, double max_miss_rate, int limit);
+
+} // namespace qpsk
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "system.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace qpsk {
+
+struct ShardJob {
+    std::vector<int> sizes;
+    std::vector<double> snrs_db;
+    long long iterations = 0;
+    long long shard_size = 0;
+    uint64_t seed = 0;
+    // Empty lets every worker use the decoder tuned for its own host.
+    std::string decoder;
+};
+
+struct ShardSpec {
+    int id = 0;
+    int n = 0;
+    double snr_db = 0.0;
+    long long first_trial = 0;
+    long long trials = 0;
+    uint64_t seed = 0;
+    std::string decoder;
+};
+
+struct ShardResult {
+    int id = 0;
+    int n = 0;
+    double snr_db = 0.0;
+    long long success = 0;
+    long long failed = 0;
+};
+
+uint64_t shard_seed(uint64_t job_seed, int shard_id);
+
+// Directory layout:
+//   job.json            - job description and shard count
+//   shards/<id>.json    - shard specs
+//   leases/<id>.lease   - created with O_EXCL by the worker that claimed the shard
+//   results/<id>.json   - partial counts, written atomically
+class ShardQueue {
+public:
+    explicit ShardQueue(std::string dir) : dir_(std::move(dir)) {}
+
+    bool exists() const;
+    void create(const ShardJob& job) const;
+
+    ShardJob job() const;
+    int shard_count() const;
+    ShardSpec shard(int id) const;
+
+    std::optional<ShardSpec> claim(double lease_timeout_s) const;
+    void complete(const ShardResult& result) const;
+
+    std::vector<ShardResult> results() const;
+    json merge() const;
+
+private:
+    std::string shard_path(int id) const;
+    std::string lease_path(int id) const;
+    std::string result_path(int id) const;
+
+    std::string dir_;
+};
+
+ShardResult run_shard(const ShardSpec& spec);
+int run_shard_worker(const ShardQueue& queue, double lease_timeout_s);
+
+} // namespace qpsk
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "error_capture.hpp"
+#include "decoder_registry.hpp"
+#include "known_bits_decoder.hpp"
+#include "blind_detector.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace qpsk {
+
+struct SimulationConfig {
+    int n = 0;
+    double snr_db = 10.0;
+    long long iterations = 0;
+    uint64_t seed = 0;
+    // Registered decoder name; empty selects the tuned decoder for N.
+    std::string decoder;
+    DecoderOptions decoder_options;
+    // Also decodes every trial with the tuned exact decoder and times both.
+    bool compare_to_ml = false;
+    // Wraps the decoder in EarlyExitDecoder and counts the early exits.
+    bool early_exit = false;
+    // Bit widths decoded in fixed point alongside the double-precision decoder.
+    std::vector<int> quantization_bits;
+    CaptureConfig capture;
+    // Declares DTX when the normalized_correlation() of the decision is below
+    // the threshold. Signal trials count missed detections; dtx_trials extra
+    // noise-only trials (0: as many as iterations) count false alarms.
+    std::optional<double> dtx_threshold;
+    long long dtx_trials = 0;
+    // Transmitted words carry these values; trials are decoded by
+    // KnownBitsDecoder, and by the configured decoder for comparison.
+    KnownBits known_bits;
+    // Also runs BlindDetector over these payload sizes (must include n), as
+    // if the receiver did not know N, with the given selection margin.
+    std::vector<int> blind_sizes;
+    double blind_margin = BlindDetector::DEFAULT_MARGIN;
+    // "serial" (default) or "pipelined", see simulate_pipelined().
+    std::string engine;
+    // Pipelined engine: consecutive PIPELINE_STAGES joined with '+', one
+    // thread per entry; empty uses DEFAULT_PIPELINE.
+    std::vector<std::string> pipeline_stages;
+    // Pipelined engine: CPU of each stage thread; empty leaves them unpinned.
+    std::vector<int> pipeline_cpus;
+};
+
+struct StageStats {
+    std::string name;
+    long long blocks = 0;
+    // Time running the stage, waiting for an input block and waiting for
+    // room in the output ring.
+    double busy_ns = 0.0;
+    double input_stall_ns = 0.0;
+    double output_stall_ns = 0.0;
+    double wall_ns = 0.0;
+    bool pinned = false;
+};
+
+struct SimulationResult {
+    long long success = 0;
+    long long failed = 0;
+    long long early_exits = 0;
+    // Failures per entry of SimulationConfig::quantization_bits.
+    std::vector<long long> quantized_failed;
+    // Filled when SimulationConfig::compare_to_ml is set.
+    std::string ml_decoder;
+    long long ml_failed = 0;
+    long long disagreements = 0;
+    double decode_ns = 0.0;
+    double ml_decode_ns = 0.0;
+    // Filled when SimulationConfig::capture is enabled.
+    CaptureDump capture;
+    // Filled when SimulationConfig::dtx_threshold is set.
+    long long missed_detections = 0;
+    long long dtx_trials = 0;
+    long long false_alarms = 0;
+    // Filled when SimulationConfig::known_bits is set: failures of the
+    // configured decoder searching all 2^N candidates.
+    long long full_search_failed = 0;
+    // Filled when SimulationConfig::blind_sizes is set: how often each size
+    // was selected, and trials whose size or bits came out wrong.
+    std::vector<long long> blind_selected;
+    long long blind_failed = 0;
+    // Transmitted words that are also words of the next smaller size in
+    // blind_sizes; no detector can tell the size of these.
+    long long blind_ambiguous = 0;
+    // Filled by the pipelined engine, one entry per stage thread.
+    std::vector<StageStats> stages;
+};
+
+extern const std::vector<std::string> PIPELINE_STAGES;
+extern const std::vector<std::string> DEFAULT_PIPELINE;
+
+SimulationResult simulate(const SimulationConfig& config);
+
+// Runs the trial chain as a pipeline: every stage group has its own thread
+// and passes blocks of trials to the next one through SPSC rings, the last
+// group returning them to the first. Bits and noise come from separate
+// streams derived from the seed, so results are reproducible but differ from
+// the serial engine. Capture, ML comparison, early exit, quantization and DTX
+// detection are not supported and throw std::invalid_argument.
+SimulationResult simulate_pipelined(const SimulationConfig& config);
+
+} // namespace qpsk
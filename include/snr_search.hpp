@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace qpsk {
+
+struct SnrSearchConfig {
+    int n = 0;
+    double target_bler = 1e-2;
+    // Initial bracket; widened outwards if it does not contain the target.
+    double snr_low_db = -10.0;
+    double snr_high_db = 10.0;
+    // Stop once the bracket is narrower than this.
+    double tolerance_db = 0.05;
+    double confidence = 0.95;
+    // A point whose Wilson interval is within this relative half-width of its
+    // BLER estimate is considered resolved even if it cannot be classified.
+    double relative_precision = 0.1;
+    long long max_trials = 10000000;
+    // Size of the reference uniform sweep reported in SnrSearchResult::sweep_trials.
+    int sweep_points = 30;
+    uint64_t seed = 0;
+    std::string decoder;
+};
+
+struct SnrSearchPoint {
+    double snr_db = 0.0;
+    long long trials = 0;
+    long long failed = 0;
+    // +1: BLER above target, -1: below, 0: statistically indistinguishable.
+    int side = 0;
+};
+
+struct SnrSearchResult {
+    double snr_db = 0.0;
+    double snr_low_db = 0.0;
+    double snr_high_db = 0.0;
+    bool converged = false;
+    long long trials = 0;
+    // Trials a sweep of sweep_points points would need for the same precision at the target.
+    long long sweep_trials = 0;
+    std::vector<SnrSearchPoint> points;
+};
+
+double normal_quantile(double p);
+std::pair<double, double> wilson_interval(long long failed, long long trials, double z);
+
+SnrSearchResult search_snr(const SnrSearchConfig& config);
+
+} // namespace qpsk
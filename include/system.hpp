@@ -11,8 +11,21 @@ namespace qpsk {
 
 using Complex = std::complex<double>;
 
+// Dispatches on input["mode"] to one of the run_*_mode functions below.
+int run_mode(const json& input, json& output);
+
 int run_coding_mode(const json& input, json& output);
+int run_bulk_coding_mode(const json& input, json& output);
 int run_decoding_mode(const json& input, json& output);
 int run_simulation_mode(const json& input, json& output);
+int run_sharded_simulation_mode(const json& input, json& output);
+int run_shard_worker_mode(const json& input, json& output);
+int run_shard_merge_mode(const json& input, json& output);
+int run_tune_mode(const json& input, json& output);
+int run_snr_search_mode(const json& input, json& output);
+int run_union_bound_mode(const json& input, json& output);
+int run_realtime_mode(const json& input, json& output);
+int run_dataset_capture_mode(const json& input, json& output);
+int run_dataset_replay_mode(const json& input, json& output);
 
 } // namespace qpsk
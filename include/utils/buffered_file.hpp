@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace qpsk {
+
+constexpr size_t BUFFERED_FILE_BYTES = 4 << 20;
+
+// Appends to a temporary file through one fixed-size buffer; commit() renames
+// it into place, so readers never see a partial file. Destroying an
+// uncommitted file removes the temporary.
+class BufferedFile {
+public:
+    explicit BufferedFile(const std::string& path, size_t buffer_bytes = BUFFERED_FILE_BYTES);
+    ~BufferedFile();
+
+    BufferedFile(const BufferedFile&) = delete;
+    BufferedFile& operator=(const BufferedFile&) = delete;
+
+    void append(const void* data, size_t bytes);
+    // Returns the file size in bytes.
+    size_t commit();
+
+private:
+    void flush();
+    void write_all(const char* data, size_t bytes);
+
+    std::string path_;
+    std::string tmp_;
+    int fd_ = -1;
+    std::vector<char> buffer_;
+    size_t used_ = 0;
+    size_t written_ = 0;
+};
+
+} // namespace qpsk
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <vector>
+
+namespace qpsk {
+
+// CPUs in the affinity mask of the calling process, ascending.
+std::vector<int> allowed_cpus();
+
+// Restricts the calling thread to `cpu`; false if the OS refuses.
+bool pin_current_thread(int cpu);
+
+} // namespace qpsk
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <string>
+
+namespace qpsk {
+
+void write_file_atomic(const std::string& path, const std::string& content);
+std::string read_file(const std::string& path);
+
+} // namespace qpsk
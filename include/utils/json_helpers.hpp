@@ -2,10 +2,16 @@
 
 #include "system.hpp"
 #include <string>
+#include <vector>
 
 namespace qpsk {
 
 Complex parse_complex(const std::string& s);
 std::string format_complex(const Complex& c);
 
+// A single value or an array of them, e.g. "snr_db": 3 or [0, 3, 6].
+// Instantiated for int and double.
+template<typename T>
+std::vector<T> scalar_or_array(const json& value);
+
 } // namespace qpsk
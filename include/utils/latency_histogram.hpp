@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace qpsk {
+
+// HDR-style histogram: values below 2^SUB_BUCKET_BITS are counted exactly,
+// larger ones in log2 octaves split into 2^(SUB_BUCKET_BITS - 1) linear
+// sub-buckets, which bounds the relative error by 2^-(SUB_BUCKET_BITS - 1).
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 6;
+    static constexpr size_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+    static constexpr size_t HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+    static constexpr size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * HALF_SUB_BUCKETS + HALF_SUB_BUCKETS;
+
+    void record(uint64_t value);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    // Smallest bucket upper bound at or below which `p` percent of values fall.
+    uint64_t percentile(double p) const;
+
+    uint64_t bucket_count(size_t index) const { return counts_[index]; }
+
+    static size_t bucket_index(uint64_t value);
+    static uint64_t bucket_upper(size_t index);
+
+private:
+    std::array<uint64_t, BUCKETS> counts_{};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t min_ = UINT64_MAX;
+    uint64_t max_ = 0;
+};
+
+} // namespace qpsk
@@ -2,13 +2,13 @@
 
 #include <bitset>
 #include <random>
+#include <cstdint>
 
 namespace qpsk {
 
 template <int N>
-std::bitset<N> generate_random_bits() {
-    static std::mt19937 rng(std::random_device{}());
-    static std::uniform_int_distribution<int> dis(0, 1);
+std::bitset<N> generate_random_bits(std::mt19937& rng) {
+    std::uniform_int_distribution<int> dis(0, 1);
 
     std::bitset<N> bits;
 
@@ -19,4 +19,29 @@ std::bitset<N> generate_random_bits() {
     return bits;
 }
 
+template <int N>
+std::bitset<N> generate_random_bits() {
+    static std::mt19937 rng(std::random_device{}());
+
+    return generate_random_bits<N>(rng);
+}
+
+inline std::mt19937 make_rng(uint64_t seed) {
+    std::seed_seq seq{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+    return std::mt19937(seq);
+}
+
+// splitmix64 of (seed, stream): independent, reproducible seeds for sub-tasks.
+inline uint64_t derive_seed(uint64_t seed, uint64_t stream) {
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (stream + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+inline uint64_t random_seed() {
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) | rd();
+}
+
 } // namespace qpsk
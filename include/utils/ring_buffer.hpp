@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace qpsk {
+
+// Fixed-capacity ring that keeps the most recent `capacity` pushes. It is
+// owned by a single thread, so pushing is a store and an increment with no
+// locks or atomics.
+template <typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity) : slots_(capacity) {}
+
+    void push(const T& value) {
+        if (slots_.empty()) {
+            return;
+        }
+        slots_[head_ % slots_.size()] = value;
+        ++head_;
+    }
+
+    size_t capacity() const { return slots_.size(); }
+    size_t size() const { return head_ < slots_.size() ? static_cast<size_t>(head_) : slots_.size(); }
+    // Number of pushes, including the ones already overwritten.
+    uint64_t pushed() const { return head_; }
+
+    // Retained values, oldest first.
+    std::vector<T> snapshot() const {
+        std::vector<T> values;
+        values.reserve(size());
+        for (uint64_t i = head_ - size(); i < head_; ++i) {
+            values.push_back(slots_[i % slots_.size()]);
+        }
+        return values;
+    }
+
+private:
+    std::vector<T> slots_;
+    uint64_t head_ = 0;
+};
+
+} // namespace qpsk
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "system.hpp"
+#include "utils/tsc_clock.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace qpsk {
+
+struct TraceConfig {
+    std::string file;
+    // Outermost sampled spans are kept with probability 1/sample_period and
+    // sampled spans nested in them follow their decision; 1 keeps all.
+    uint32_t sample_period = 1;
+    // Spans kept per thread; later ones are only counted as dropped.
+    size_t buffer_spans = 1 << 16;
+};
+
+struct TraceSummary {
+    size_t threads = 0;
+    size_t spans = 0;
+    size_t dropped = 0;
+};
+
+namespace trace_detail {
+
+extern std::atomic<bool> enabled;
+
+// Entering an outermost sampled span draws the decision for its subtree.
+bool enter_sampled();
+void leave_sampled();
+void record(const char* name, uint64_t start_ticks, uint64_t end_ticks);
+
+} // namespace trace_detail
+
+inline bool tracing_enabled() {
+    return trace_detail::enabled.load(std::memory_order_relaxed);
+}
+
+// "trace.json" or {"file": ..., "sample_period": ..., "buffer_spans": ...}.
+TraceConfig parse_trace_config(const json& spec);
+
+// Starts a session; spans recorded before it was stopped are discarded.
+void start_tracing(const TraceConfig& config);
+
+// Stops recording and writes every thread's spans to config.file as
+// Chrome/Perfetto trace-event JSON. Threads that recorded spans must be
+// finished or idle; their buffers outlive them.
+TraceSummary stop_tracing();
+
+// Label of the calling thread in the trace; default "thread <id>".
+void set_trace_thread_name(const std::string& name);
+
+// Records [construction, destruction) as a complete event of the calling
+// thread. When tracing is off this is one relaxed load and a branch.
+class TraceSpan {
+public:
+    TraceSpan(const char* name, bool sampled) : name_(name) {
+        if (tracing_enabled()) {
+            sampled_ = sampled;
+            if (!sampled || trace_detail::enter_sampled()) {
+                start_ = read_tsc();
+            }
+        }
+    }
+
+    ~TraceSpan() {
+        if (sampled_) {
+            trace_detail::leave_sampled();
+        }
+        if (start_ != 0) {
+            trace_detail::record(name_, start_, read_tsc());
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    // Must be a string literal or otherwise outlive the session.
+    const char* name_;
+    uint64_t start_ = 0;
+    bool sampled_ = false;
+};
+
+} // namespace qpsk
+
+// Spans compile to nothing unless the build sets QPSK_TRACING
+// (cmake -DQPSK_TRACING=ON, the default).
+#ifdef QPSK_TRACING
+#define QPSK_TRACE_CONCAT_(a, b) a##b
+#define QPSK_TRACE_CONCAT(a, b) QPSK_TRACE_CONCAT_(a, b)
+// Scope span recorded every time; for coarse, infrequent work.
+#define TRACE_SPAN(name) ::qpsk::TraceSpan QPSK_TRACE_CONCAT(qpsk_trace_span_, __LINE__)(name, false)
+// Scope span subject to sample_period; for per-trial work. Wrap a trial's
+// stages in an outer sampled span to keep or drop them together.
+#define TRACE_SPAN_SAMPLED(name) ::qpsk::TraceSpan QPSK_TRACE_CONCAT(qpsk_trace_span_, __LINE__)(name, true)
+#else
+#define TRACE_SPAN(name) ((void)0)
+#define TRACE_SPAN_SAMPLED(name) ((void)0)
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace qpsk {
+
+// Serialized timestamp read: rdtscp waits for preceding instructions and the
+// trailing lfence keeps later ones from starting before the read.
+inline uint64_t read_tsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int aux;
+    uint64_t ticks = __rdtscp(&aux);
+    _mm_lfence();
+    return ticks;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Spin-wait hint: pause on x86, nothing elsewhere.
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+
+// TSC ticks per nanosecond, calibrated once against steady_clock.
+double tsc_ticks_per_ns();
+
+inline uint64_t tsc_to_ns(uint64_t ticks) {
+    return static_cast<uint64_t>(static_cast<double>(ticks) / tsc_ticks_per_ns());
+}
+
+} // namespace qpsk
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace qpsk {
+
+// Fork-join pool with one task deque per worker. A worker takes its own
+// tasks newest first and, once its deque is empty, steals the oldest task of
+// another worker, so a caller can place related tasks on the same worker and
+// still have idle workers pick up the slack.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(size_t threads);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Queues `task` on worker `worker % size()`.
+    void submit(size_t worker, std::function<void()> task);
+    // Blocks until every submitted task has finished.
+    void wait();
+
+    size_t size() const { return workers_.size(); }
+    // Tasks run by a worker other than the one they were submitted to.
+    uint64_t steals() const;
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    bool take(size_t self, std::function<void()>& task);
+    void worker_loop(size_t self);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    mutable std::mutex mutex_;
+    std::condition_variable task_ready_;
+    std::condition_variable all_done_;
+    // Submitted but not yet taken, and taken but not yet finished.
+    size_t queued_ = 0;
+    size_t active_ = 0;
+    uint64_t steals_ = 0;
+    bool stopping_ = false;
+};
+
+} // namespace qpsk
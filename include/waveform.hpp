@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace qpsk {
+
+// Raw IQ layouts: interleaved (re, im) pairs in host byte order, no header.
+enum class IqFormat { CF32, CF64, CI16 };
+
+// "cf32", "cf64" or "ci16".
+IqFormat parse_iq_format(const std::string& name);
+const char* iq_format_name(IqFormat format);
+size_t iq_sample_bytes(IqFormat format);
+
+struct WaveformConfig {
+    int n = 11;
+    IqFormat format = IqFormat::CF32;
+    // Messages to transmit, one uint16 per message with pucch_f2_bits[i] in
+    // bit i. Empty: `count` uniformly random messages drawn from `seed`.
+    std::string messages_file;
+    long long count = 0;
+    uint64_t seed = 0;
+    // If set, the generated messages are saved there in the same format.
+    std::string save_messages;
+    // AWGN from Channel at this SNR; unset writes the clean TX waveform.
+    std::optional<double> snr_db;
+    // ci16 level of amplitude 1.0; larger amplitudes saturate.
+    double ci16_scale = 16384.0;
+};
+
+struct WaveformResult {
+    long long messages = 0;
+    size_t bytes = 0;
+    double seconds = 0.0;
+};
+
+// Writes QPSK_SYMBOLS_COUNT samples per message to `path`. Clean waveforms
+// are copied from a per-message sample table, so the cost per message is a
+// short memcpy into a large write buffer and nothing is allocated per message.
+WaveformResult write_waveform(const std::string& path, const WaveformConfig& config);
+
+} // namespace qpsk
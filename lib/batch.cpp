@@ -0,0 +1,125 @@
+#include "batch.hpp"
+#include "system.hpp"
+#include "utils/file_utils.hpp"
+#include "utils/thread_pool.hpp"
+#include "utils/trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <set>
+
+namespace fs = std::filesystem;
+
+namespace qpsk {
+
+namespace {
+
+// Modes that must own the process: sharded simulation forks while sibling
+// jobs may hold the tuner or registry locks, and realtime and tune measure
+// timing that concurrent jobs would distort.
+const std::set<std::string> EXCLUSIVE_MODES = {"sharded simulation", "realtime", "tune"};
+
+} // namespace
+
+std::vector<std::string> collect_batch_inputs(const std::vector<std::string>& paths) {
+    std::vector<std::string> inputs;
+
+    for (const auto& path : paths) {
+        if (fs::is_directory(path)) {
+            std::vector<std::string> found;
+            for (const auto& entry : fs::directory_iterator(path)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".json") {
+                    found.push_back(entry.path().string());
+                }
+            }
+            std::sort(found.begin(), found.end());
+            inputs.insert(inputs.end(), found.begin(), found.end());
+        } else {
+            inputs.push_back(path);
+        }
+    }
+
+    return inputs;
+}
+
+std::string batch_output_path(const std::string& input, const std::string& output_dir) {
+    return (fs::path(output_dir) / (fs::path(input).stem().string() + ".result.json")).string();
+}
+
+BatchSummary run_batch(const std::vector<std::string>& inputs, const std::string& output_dir, size_t threads) {
+    // Results share one temp-file suffix per process, so every output must be unique.
+    std::set<std::string> outputs;
+    for (const auto& input : inputs) {
+        if (!outputs.insert(batch_output_path(input, output_dir)).second) {
+            throw std::invalid_argument("lib/batch.cpp: two inputs map to the same result file: " + input);
+        }
+    }
+
+    fs::create_directories(output_dir);
+
+    std::atomic<size_t> failed{0};
+    const auto start = std::chrono::steady_clock::now();
+
+    {
+        ThreadPool pool(threads);
+
+        for (const auto& input : inputs) {
+            pool.submit([&input, &output_dir, &failed] {
+                TRACE_SPAN("batch job");
+                try {
+                    std::string text;
+                    {
+                        TRACE_SPAN("read input");
+                        text = read_file(input);
+                    }
+                    json request;
+                    {
+                        TRACE_SPAN("parse input");
+                        request = json::parse(text);
+                    }
+                    const std::string mode = request.value("mode", "");
+                    if (EXCLUSIVE_MODES.count(mode) != 0) {
+                        std::cerr << input << ": mode '" << mode << "' cannot run in batch mode\n";
+                        ++failed;
+                        return;
+                    }
+                    json output;
+
+                    int result;
+                    {
+                        TRACE_SPAN("run mode");
+                        result = run_mode(request, output);
+                    }
+                    if (result != 0) {
+                        std::cerr << input << ": job failed\n";
+                        ++failed;
+                        return;
+                    }
+
+                    {
+                        TRACE_SPAN("serialize output");
+                        text = output.dump(2) + "\n";
+                    }
+                    TRACE_SPAN("write output");
+                    write_file_atomic(batch_output_path(input, output_dir), text);
+                } catch (const std::exception& e) {
+                    std::cerr << input << ": " << e.what() << "\n";
+                    ++failed;
+                }
+            });
+        }
+
+        pool.wait();
+    }
+
+    BatchSummary summary;
+    summary.jobs = inputs.size();
+    summary.failed = failed;
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
+
+} // namespace qpsk
@@ -0,0 +1,171 @@
+#include "batch_scheduler.hpp"
+#include "encoder.hpp"
+#include "decoder_tuner.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+
+namespace qpsk {
+
+namespace {
+
+// A task cheaper than this does not pay for the queue round trip.
+constexpr double MIN_TASK_NS = 20000.0;
+// Tasks per worker the batch is cut into, leaving room for stealing.
+constexpr size_t TASKS_PER_THREAD = 4;
+constexpr size_t CALIBRATION_DECODES = 64;
+
+int size_index(int n) {
+    switch (n) {
+        case 2:  return 0;
+        case 4:  return 1;
+        case 6:  return 2;
+        case 8:  return 3;
+        case 11: return 4;
+        default:
+            throw std::invalid_argument("lib/batch_scheduler.cpp: invalid num_of_pucch_f2_bits");
+    }
+}
+
+struct Task {
+    int n;
+    size_t group;
+    size_t begin;
+    size_t count;
+    double cost;
+};
+
+} // namespace
+
+BatchScheduler::BatchScheduler(size_t threads, std::string decoder, DecoderOptions options)
+    : decoder_(std::move(decoder)), options_(options), pool_(threads) {}
+
+template <int N>
+void BatchScheduler::bind() {
+    auto& slot = std::get<const AbstractDecoder<N>*>(decoders_);
+    if (slot) {
+        return;
+    }
+    slot = &shared_decoder<N>(decoder_.empty() ? select_decoder(N) : decoder_, options_);
+
+    std::mt19937 rng(N);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<std::vector<double>> inputs(CALIBRATION_DECODES, std::vector<double>(CODEWORD_SIZE));
+    for (auto& llrs : inputs) {
+        for (auto& llr : llrs) {
+            llr = noise(rng);
+        }
+    }
+
+    // The first pass warms the decoder tables, the second one is timed.
+    for (const auto& llrs : inputs) {
+        slot->decode(llrs);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& llrs : inputs) {
+        slot->decode(llrs);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    cost_ns_[size_index(N)] = std::chrono::duration<double, std::nano>(elapsed).count() / CALIBRATION_DECODES;
+}
+
+double BatchScheduler::cost_ns(int n) {
+    switch (n) {
+        case 2:  bind<2>(); break;
+        case 4:  bind<4>(); break;
+        case 6:  bind<6>(); break;
+        case 8:  bind<8>(); break;
+        case 11: bind<11>(); break;
+        default:
+            throw std::invalid_argument("lib/batch_scheduler.cpp: invalid num_of_pucch_f2_bits");
+    }
+    return cost_ns_[size_index(n)];
+}
+
+template <int N>
+void BatchScheduler::decode_range(const std::vector<DecodeRequest>& requests, const uint32_t* indices,
+                                  size_t count, uint32_t* results) const {
+    const AbstractDecoder<N>& decoder = *std::get<const AbstractDecoder<N>*>(decoders_);
+    for (size_t i = 0; i < count; ++i) {
+        results[indices[i]] = static_cast<uint32_t>(decoder.decode(requests[indices[i]].llrs).to_ulong());
+    }
+}
+
+void BatchScheduler::decode_task(int n, const std::vector<DecodeRequest>& requests, const uint32_t* indices,
+                                 size_t count, uint32_t* results) const {
+    switch (n) {
+        case 2:  decode_range<2>(requests, indices, count, results); break;
+        case 4:  decode_range<4>(requests, indices, count, results); break;
+        case 6:  decode_range<6>(requests, indices, count, results); break;
+        case 8:  decode_range<8>(requests, indices, count, results); break;
+        case 11: decode_range<11>(requests, indices, count, results); break;
+    }
+}
+
+std::vector<uint32_t> BatchScheduler::decode(const std::vector<DecodeRequest>& requests) {
+    static constexpr int SIZES[] = {2, 4, 6, 8, 11};
+
+    stats_ = ScheduleStats{};
+
+    std::array<std::vector<uint32_t>, 5> groups;
+    for (size_t i = 0; i < requests.size(); ++i) {
+        if (requests[i].llrs.size() != CODEWORD_SIZE) {
+            throw std::invalid_argument("lib/batch_scheduler.cpp: LLR vector must have 20 elements");
+        }
+        groups[size_index(requests[i].n)].push_back(static_cast<uint32_t>(i));
+    }
+
+    double total_ns = 0.0;
+    for (size_t g = 0; g < groups.size(); ++g) {
+        if (!groups[g].empty()) {
+            total_ns += cost_ns(SIZES[g]) * static_cast<double>(groups[g].size());
+            ++stats_.groups;
+        }
+    }
+
+    const double target_ns = std::max(MIN_TASK_NS, total_ns / static_cast<double>(pool_.size() * TASKS_PER_THREAD));
+    std::vector<Task> tasks;
+    for (size_t g = 0; g < groups.size(); ++g) {
+        const double cost = std::max(cost_ns_[g], 1.0);
+        const size_t chunk = std::max<size_t>(1, static_cast<size_t>(target_ns / cost));
+        for (size_t begin = 0; begin < groups[g].size(); begin += chunk) {
+            const size_t count = std::min(chunk, groups[g].size() - begin);
+            tasks.push_back({SIZES[g], g, begin, count, cost * static_cast<double>(count)});
+        }
+    }
+    stats_.tasks = tasks.size();
+
+    std::vector<uint32_t> results(requests.size());
+
+    if (tasks.size() <= 1 || pool_.size() == 1) {
+        for (const Task& task : tasks) {
+            decode_task(task.n, requests, groups[task.group].data() + task.begin, task.count, results.data());
+        }
+        return results;
+    }
+
+    // Longest processing time first onto the least loaded worker.
+    std::stable_sort(tasks.begin(), tasks.end(), [](const Task& a, const Task& b) { return a.cost > b.cost; });
+    std::vector<double> load(pool_.size(), 0.0);
+
+    const uint64_t steals = pool_.steals();
+    for (const Task& task : tasks) {
+        const size_t worker = static_cast<size_t>(std::min_element(load.begin(), load.end()) - load.begin());
+        load[worker] += task.cost;
+
+        const uint32_t* indices = groups[task.group].data() + task.begin;
+        pool_.submit(worker, [this, &requests, &results, task, indices] {
+            decode_task(task.n, requests, indices, task.count, results.data());
+        });
+    }
+    pool_.wait();
+    stats_.steals = pool_.steals() - steals;
+
+    return results;
+}
+
+} // namespace qpsk
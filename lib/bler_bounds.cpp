@@ -0,0 +1,217 @@
+#include "bler_bounds.hpp"
+#include "codebook.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace qpsk {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr int LENGTH = static_cast<int>(CODEWORD_SIZE);
+
+// Outer integral starts this many noise deviations below the codeword and
+// uses GL panels of this width; the inner one spans at most INNER_SPAN.
+constexpr double OUTER_FLOOR = -8.0;
+constexpr double PANEL_WIDTH = 1.0;
+constexpr double INNER_SPAN = 10.0;
+
+struct Quadrature {
+    std::vector<double> nodes;
+    std::vector<double> weights;
+};
+
+Quadrature gauss_legendre(int order) {
+    Quadrature q;
+    q.nodes.resize(order);
+    q.weights.resize(order);
+
+    for (int i = 0; i < order; ++i) {
+        double x = std::cos(PI * (i + 0.75) / (order + 0.5));
+        double derivative = 0.0;
+        for (int iter = 0; iter < 100; ++iter) {
+            double p0 = 1.0;
+            double p1 = x;
+            for (int k = 2; k <= order; ++k) {
+                const double p2 = ((2.0 * k - 1.0) * x * p1 - (k - 1.0) * p0) / k;
+                p0 = p1;
+                p1 = p2;
+            }
+            derivative = order * (x * p1 - p0) / (x * x - 1.0);
+            const double step = p1 / derivative;
+            x -= step;
+            if (std::abs(step) < 1e-15) {
+                break;
+            }
+        }
+        q.nodes[i] = x;
+        q.weights[i] = 2.0 / ((1.0 - x * x) * derivative * derivative);
+    }
+    return q;
+}
+
+const Quadrature& panel_rule() {
+    static const Quadrature rule = gauss_legendre(8);
+    return rule;
+}
+
+const Quadrature& inner_rule() {
+    static const Quadrature rule = gauss_legendre(16);
+    return rule;
+}
+
+template <typename F>
+double integrate(const Quadrature& rule, double a, double b, F f) {
+    const double half = 0.5 * (b - a);
+    const double mid = 0.5 * (a + b);
+    double sum = 0.0;
+    for (size_t i = 0; i < rule.nodes.size(); ++i) {
+        sum += rule.weights[i] * f(mid + half * rule.nodes[i]);
+    }
+    return sum * half;
+}
+
+double q_function(double x) {
+    return 0.5 * std::erfc(x / std::sqrt(2.0));
+}
+
+double normal_pdf(double x) {
+    return std::exp(-0.5 * x * x) / std::sqrt(2.0 * PI);
+}
+
+// P(a, x) for a = twice_a / 2, integer or half-integer.
+double regularized_gamma_p(int twice_a, double x) {
+    if (x <= 0.0) {
+        return 0.0;
+    }
+
+    double sum = 0.0;
+    if (twice_a % 2 == 0) {
+        double term = 1.0;
+        for (int j = 0; j < twice_a / 2; ++j) {
+            sum += term;
+            term *= x / (j + 1);
+        }
+        return std::max(0.0, 1.0 - std::exp(-x) * sum);
+    }
+
+    double term = 2.0 * std::sqrt(x / PI);
+    for (int j = 0; j < twice_a / 2; ++j) {
+        sum += term;
+        term *= x / (j + 1.5);
+    }
+    return std::max(0.0, std::erf(std::sqrt(x)) - std::exp(-x) * sum);
+}
+
+// Area of a cap of half-angle theta on the unit (LENGTH - 2)-sphere, up to a
+// constant factor shared with the full sphere.
+double cap_area(double theta) {
+    return integrate(inner_rule(), 0.0, theta,
+                     [](double phi) { return std::pow(std::sin(phi), LENGTH - 3); });
+}
+
+// Cotangent of the angle between a codeword and the plane bisecting it and a
+// neighbour at distance w.
+double bisector_ratio(int w) {
+    return std::sqrt(static_cast<double>(w) / (LENGTH - w));
+}
+
+// Cone radius per unit codeword norm at which the caps cut by the neighbours
+// cover the sphere once; this minimises the bound for every SNR.
+double compute_cone_ratio(int n) {
+    const auto& distribution = weight_distribution(n);
+    const double sphere = 2.0 * cap_area(0.5 * PI);
+
+    auto covered = [&](double ratio) {
+        double area = 0.0;
+        for (int w = 1; w < LENGTH; ++w) {
+            const double c = bisector_ratio(w);
+            if (distribution[w] > 0 && c < ratio) {
+                area += distribution[w] * cap_area(std::acos(c / ratio));
+            }
+        }
+        return area;
+    };
+
+    double low = 1e-6;
+    double high = 1e3;
+    for (int i = 0; i < 100; ++i) {
+        const double mid = std::sqrt(low * high);
+        (covered(mid) < sphere ? low : high) = mid;
+    }
+    return std::sqrt(low * high);
+}
+
+double cone_ratio(int n) {
+    static const double ratios[] = {
+        compute_cone_ratio(2), compute_cone_ratio(4), compute_cone_ratio(6), compute_cone_ratio(8), compute_cone_ratio(11)
+    };
+
+    switch (n) {
+        case 2:  return ratios[0];
+        case 4:  return ratios[1];
+        case 6:  return ratios[2];
+        case 8:  return ratios[3];
+        case 11: return ratios[4];
+        default:
+            throw std::invalid_argument("lib/bler_bounds.cpp: invalid num_of_pucch_f2_bits");
+    }
+}
+
+} // namespace
+
+double union_bound_bler(int n, double snr_db) {
+    const auto& distribution = weight_distribution(n);
+    const double snr = std::pow(10.0, snr_db / 10.0);
+
+    double bound = 0.0;
+    for (int w = 1; w <= LENGTH; ++w) {
+        if (distribution[w] > 0) {
+            bound += distribution[w] * q_function(std::sqrt(w * snr));
+        }
+    }
+    return std::min(1.0, bound);
+}
+
+double tangential_sphere_bound_bler(int n, double snr_db) {
+    const auto& distribution = weight_distribution(n);
+    const double ratio = cone_ratio(n);
+    const double snr = std::pow(10.0, snr_db / 10.0);
+
+    // Unit noise variance per dimension; z1 is the noise component along the
+    // transmitted codeword, whose norm is `radius`.
+    const double radius = std::sqrt(LENGTH * snr);
+
+    auto conditional = [&](double z1) {
+        const double height = radius - z1;
+        const double cone = ratio * height;
+
+        double error = 1.0 - regularized_gamma_p(LENGTH - 1, 0.5 * cone * cone);
+        for (int w = 1; w < LENGTH; ++w) {
+            const double c = bisector_ratio(w);
+            if (distribution[w] == 0 || c >= ratio) {
+                continue;
+            }
+            const double beta = c * height;
+            const double end = std::min(cone, beta + INNER_SPAN);
+            error += distribution[w] * integrate(inner_rule(), beta, end, [&](double z2) {
+                return normal_pdf(z2) * regularized_gamma_p(LENGTH - 2, 0.5 * (cone * cone - z2 * z2));
+            });
+        }
+        return normal_pdf(z1) * std::min(1.0, error);
+    };
+
+    double bound = q_function(radius);
+    const double start = std::min(OUTER_FLOOR, radius - PANEL_WIDTH);
+    const int panels = static_cast<int>(std::ceil((radius - start) / PANEL_WIDTH));
+    const double width = (radius - start) / panels;
+    for (int p = 0; p < panels; ++p) {
+        bound += integrate(panel_rule(), start + p * width, start + (p + 1) * width, conditional);
+    }
+    return std::min(1.0, bound);
+}
+
+} // namespace qpsk
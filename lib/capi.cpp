@@ -0,0 +1,182 @@
+#include "qpsk_capi.h"
+#include "encoder.hpp"
+#include "qpsk.hpp"
+#include "simulation.hpp"
+#include "random_bits.hpp"
+#include "decoder_registry.hpp"
+#include "decoder_tuner.hpp"
+#include "bler_bounds.hpp"
+
+#include <string>
+
+using namespace qpsk;
+
+static_assert(QPSK_CAPI_SYMBOLS == QPSK_SYMBOLS_COUNT, "C API symbol count out of sync");
+
+namespace {
+
+thread_local std::string last_error;
+
+template <typename F>
+int guarded(F&& body) {
+    try {
+        body();
+        last_error.clear();
+        return 0;
+    } catch (const std::exception& e) {
+        last_error = e.what();
+    } catch (...) {
+        last_error = "unknown error";
+    }
+    return -1;
+}
+
+std::string decoder_name(int n, const char* decoder) {
+    if (decoder == nullptr || decoder[0] == '\0') {
+        return select_decoder(n);
+    }
+    return decoder;
+}
+
+void require(bool condition, const char* message) {
+    if (!condition) {
+        throw std::invalid_argument(message);
+    }
+}
+
+template <int N>
+void encode_batch(const uint8_t* bits, size_t count, double* symbols) {
+    BlockEncoder<N> code;
+    QPSK mod;
+
+    for (size_t k = 0; k < count; ++k) {
+        std::bitset<N> info;
+        for (int i = 0; i < N; ++i) {
+            require(bits[k * N + i] <= 1, "lib/capi.cpp: bit value must be 0 or 1");
+            info[i] = bits[k * N + i] == 1;
+        }
+
+        auto modulated = mod.modulate(code.encode(info));
+        for (size_t s = 0; s < QPSK_SYMBOLS_COUNT; ++s) {
+            symbols[(k * QPSK_SYMBOLS_COUNT + s) * 2] = modulated[s].real();
+            symbols[(k * QPSK_SYMBOLS_COUNT + s) * 2 + 1] = modulated[s].imag();
+        }
+    }
+}
+
+template <int N>
+void decode_batch(const double* symbols, size_t count, uint8_t* bits, const std::string& name) {
+    auto decoder = make_decoder<N>(name);
+    QPSK mod;
+    std::vector<Complex> rx(QPSK_SYMBOLS_COUNT);
+
+    for (size_t k = 0; k < count; ++k) {
+        for (size_t s = 0; s < QPSK_SYMBOLS_COUNT; ++s) {
+            rx[s] = Complex(symbols[(k * QPSK_SYMBOLS_COUNT + s) * 2],
+                            symbols[(k * QPSK_SYMBOLS_COUNT + s) * 2 + 1]);
+        }
+
+        auto decoded = decoder->decode(mod.demodulate(rx));
+        for (int i = 0; i < N; ++i) {
+            bits[k * N + i] = decoded[i] ? 1 : 0;
+        }
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+int qpsk_capi_version(void) {
+    return QPSK_CAPI_VERSION;
+}
+
+const char* qpsk_last_error(void) {
+    return last_error.c_str();
+}
+
+int qpsk_encode_batch(int n, const uint8_t* bits, size_t count, double* symbols) {
+    return guarded([&] {
+        require(count == 0 || (bits != nullptr && symbols != nullptr), "lib/capi.cpp: null buffer");
+
+        switch (n) {
+            case 2:  encode_batch<2>(bits, count, symbols); break;
+            case 4:  encode_batch<4>(bits, count, symbols); break;
+            case 6:  encode_batch<6>(bits, count, symbols); break;
+            case 8:  encode_batch<8>(bits, count, symbols); break;
+            case 11: encode_batch<11>(bits, count, symbols); break;
+            default:
+                throw std::invalid_argument("lib/capi.cpp: invalid num_of_pucch_f2_bits");
+        }
+    });
+}
+
+int qpsk_decode_batch(int n, const double* symbols, size_t count, uint8_t* bits, const char* decoder) {
+    return guarded([&] {
+        require(count == 0 || (bits != nullptr && symbols != nullptr), "lib/capi.cpp: null buffer");
+
+        switch (n) {
+            case 2:  decode_batch<2>(symbols, count, bits, decoder_name(n, decoder)); break;
+            case 4:  decode_batch<4>(symbols, count, bits, decoder_name(n, decoder)); break;
+            case 6:  decode_batch<6>(symbols, count, bits, decoder_name(n, decoder)); break;
+            case 8:  decode_batch<8>(symbols, count, bits, decoder_name(n, decoder)); break;
+            case 11: decode_batch<11>(symbols, count, bits, decoder_name(n, decoder)); break;
+            default:
+                throw std::invalid_argument("lib/capi.cpp: invalid num_of_pucch_f2_bits");
+        }
+    });
+}
+
+int qpsk_simulate_point(int n, double snr_db, long long iterations, uint64_t seed,
+                        const char* decoder, long long* failed) {
+    return guarded([&] {
+        require(failed != nullptr, "lib/capi.cpp: null buffer");
+        require(iterations > 0, "lib/capi.cpp: iterations must be positive");
+
+        SimulationConfig config;
+        config.n = n;
+        config.snr_db = snr_db;
+        config.iterations = iterations;
+        config.seed = seed;
+        config.decoder = decoder ? decoder : "";
+
+        *failed = simulate(config).failed;
+    });
+}
+
+int qpsk_simulate_sweep(int n, const double* snr_db, size_t count, long long iterations,
+                        uint64_t seed, const char* decoder, double* bler) {
+    return guarded([&] {
+        require(count == 0 || (snr_db != nullptr && bler != nullptr), "lib/capi.cpp: null buffer");
+        require(iterations > 0, "lib/capi.cpp: iterations must be positive");
+
+        SimulationConfig config;
+        config.n = n;
+        config.iterations = iterations;
+        config.decoder = decoder ? decoder : "";
+
+        for (size_t i = 0; i < count; ++i) {
+            config.snr_db = snr_db[i];
+            config.seed = derive_seed(seed, i);
+            bler[i] = static_cast<double>(simulate(config).failed) / iterations;
+        }
+    });
+}
+
+int qpsk_bler_bounds(int n, const double* snr_db, size_t count, double* union_bound,
+                     double* tangential_sphere_bound) {
+    return guarded([&] {
+        require(count == 0 || snr_db != nullptr, "lib/capi.cpp: null buffer");
+
+        for (size_t i = 0; i < count; ++i) {
+            if (union_bound) {
+                union_bound[i] = union_bound_bler(n, snr_db[i]);
+            }
+            if (tangential_sphere_bound) {
+                tangential_sphere_bound[i] = tangential_sphere_bound_bler(n, snr_db[i]);
+            }
+        }
+    });
+}
+
+} // extern "C"
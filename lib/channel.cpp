@@ -6,12 +6,24 @@
 namespace qpsk {
 
 std::vector<Complex> Channel::apply(const std::vector<Complex>& signal) const {
+    std::random_device rd;
+    std::seed_seq seed{rd(), rd(), rd(), rd()};
+    std::mt19937 gen(seed);
+
+    return apply(signal, gen);
+}
+
+std::vector<Complex> Channel::apply(const std::vector<Complex>& signal, std::mt19937& gen) const {
+    std::vector<Complex> noisy = signal;
+    apply_in_place(noisy, gen);
+    return noisy;
+}
+
+void Channel::apply_in_place(std::vector<Complex>& signal, std::mt19937& gen) const {
     if (signal.empty()) {
         throw std::invalid_argument("lib/channel.cpp: signal is empty");
     }
 
-    std::vector<Complex> noisy = signal;
-
     double signal_power = 0.0;
     for (const auto& s : signal) {
         signal_power += std::norm(s);
@@ -22,17 +34,27 @@ std::vector<Complex> Channel::apply(const std::vector<Complex>& signal) const {
     double sigma = std::sqrt(noise_power / 2.0);
 
     std::normal_distribution<double> dist(GAUSSIAN_MEAN, GAUSSIAN_STD_DEV);
-    std::random_device rd;
-    std::seed_seq seed{rd(), rd(), rd(), rd()};
-    std::mt19937 gen(seed);
 
-    for (auto& s: noisy) {
+    for (auto& s: signal) {
         double re_noise = sigma * dist(gen);
         double im_noise = sigma * dist(gen);
         s += Complex(re_noise, im_noise);
     }
+}
 
-    return noisy;
+std::vector<Complex> Channel::noise(size_t count, std::mt19937& gen) const {
+    const double sigma = std::sqrt(1.0 / std::pow(10.0, snr_db_ / 10.0) / 2.0);
+
+    std::normal_distribution<double> dist(GAUSSIAN_MEAN, GAUSSIAN_STD_DEV);
+
+    std::vector<Complex> samples(count);
+    for (auto& s : samples) {
+        double re_noise = sigma * dist(gen);
+        double im_noise = sigma * dist(gen);
+        s = Complex(re_noise, im_noise);
+    }
+
+    return samples;
 }
 
 } // namespace qpsk
@@ -0,0 +1,89 @@
+#include "codebook.hpp"
+
+namespace qpsk {
+
+namespace {
+
+template <int N>
+std::array<uint32_t, 1ULL << N> build_codebook() {
+    BlockEncoder<N> encoder;
+    std::array<uint32_t, 1ULL << N> codebook;
+
+    for (size_t i = 0; i < (1ULL << N); ++i) {
+        codebook[i] = static_cast<uint32_t>(encoder.encode(std::bitset<N>(i)).to_ulong());
+    }
+    return codebook;
+}
+
+template <int N>
+std::vector<uint64_t> count_weights() {
+    std::vector<uint64_t> distribution(CODEWORD_SIZE + 1, 0);
+    for (uint32_t codeword : packed_codebook<N>()) {
+        ++distribution[__builtin_popcount(codeword)];
+    }
+    return distribution;
+}
+
+} // namespace
+
+template <int N>
+const std::array<uint32_t, 1ULL << N>& packed_codebook() {
+    static const auto codebook = build_codebook<N>();
+    return codebook;
+}
+
+const std::vector<uint64_t>& weight_distribution(int n) {
+    static const std::vector<uint64_t> distributions[] = {
+        count_weights<2>(), count_weights<4>(), count_weights<6>(), count_weights<8>(), count_weights<11>()
+    };
+
+    switch (n) {
+        case 2:  return distributions[0];
+        case 4:  return distributions[1];
+        case 6:  return distributions[2];
+        case 8:  return distributions[3];
+        case 11: return distributions[4];
+        default:
+            throw std::invalid_argument("lib/codebook.cpp: invalid num_of_pucch_f2_bits");
+    }
+}
+
+int minimum_distance(int n) {
+    const auto& distribution = weight_distribution(n);
+    for (size_t w = 1; w < distribution.size(); ++w) {
+        if (distribution[w] > 0) {
+            return static_cast<int>(w);
+        }
+    }
+    return 0;
+}
+
+template <int N>
+CodewordTable<N>::CodewordTable() {
+    keys_.fill(EMPTY);
+    values_.fill(0);
+
+    const auto& codebook = packed_codebook<N>();
+    for (size_t i = 0; i < codebook.size(); ++i) {
+        size_t slot = hash(codebook[i]);
+        while (keys_[slot] != EMPTY) {
+            slot = (slot + 1) & (SLOTS - 1);
+        }
+        keys_[slot] = codebook[i];
+        values_[slot] = static_cast<uint16_t>(i);
+    }
+}
+
+template const std::array<uint32_t, 1ULL << 2>& packed_codebook<2>();
+template const std::array<uint32_t, 1ULL << 4>& packed_codebook<4>();
+template const std::array<uint32_t, 1ULL << 6>& packed_codebook<6>();
+template const std::array<uint32_t, 1ULL << 8>& packed_codebook<8>();
+template const std::array<uint32_t, 1ULL << 11>& packed_codebook<11>();
+
+template class CodewordTable<2>;
+template class CodewordTable<4>;
+template class CodewordTable<6>;
+template class CodewordTable<8>;
+template class CodewordTable<11>;
+
+} // namespace qpsk
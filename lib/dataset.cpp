@@ -0,0 +1,215 @@
+#include "dataset.hpp"
+#include "qpsk.hpp"
+#include "channel.hpp"
+#include "random_bits.hpp"
+#include "utils/buffered_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace qpsk {
+
+namespace {
+
+constexpr char MAGIC[8] = {'Q', 'P', 'S', 'K', 'D', 'A', 'T', '1'};
+constexpr uint32_t VERSION = 2;
+// Records are decoded in blocks so each decoder is timed over a whole block.
+constexpr size_t BLOCK_RECORDS = 1024;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t n;
+    uint32_t reserved;
+    double snr_db;
+    uint64_t seed;
+    uint64_t record_count;
+    uint64_t padding[2];
+};
+
+static_assert(sizeof(FileHeader) == 64, "FileHeader layout is part of the dataset file format");
+
+using Clock = std::chrono::steady_clock;
+
+template <int N>
+void generate_records(const DatasetConfig& config, BufferedFile& out) {
+    BlockEncoder<N> code;
+    QPSK mod;
+    Channel channel(config.snr_db);
+    std::mt19937 rng = make_rng(config.seed);
+
+    for (long long i = 0; i < config.count; ++i) {
+        const auto tx_bits = generate_random_bits<N>(rng);
+        const auto llrs = mod.demodulate(channel.apply(mod.modulate(code.encode(tx_bits)), rng));
+
+        DatasetRecord r;
+        r.tx_bits = static_cast<uint32_t>(tx_bits.to_ulong());
+        std::copy(llrs.begin(), llrs.end(), r.rx);
+        out.append(&r, sizeof(r));
+    }
+}
+
+template <int N>
+ReplayResult replay(const Dataset& dataset, const std::vector<std::string>& names, const DecoderOptions& options) {
+    std::vector<std::unique_ptr<AbstractDecoder<N>>> decoders;
+    for (const auto& name : names) {
+        decoders.push_back(make_decoder<N>(name, options));
+    }
+
+    const size_t count = decoders.size();
+    ReplayResult result;
+    result.records = static_cast<long long>(dataset.size());
+    result.disagreements.assign(count, std::vector<long long>(count, 0));
+    for (const auto& name : names) {
+        result.decoders.push_back({name, 0, 0.0});
+    }
+
+    std::vector<std::vector<double>> llrs(BLOCK_RECORDS, std::vector<double>(CODEWORD_SIZE));
+    std::vector<std::vector<uint32_t>> decisions(count, std::vector<uint32_t>(BLOCK_RECORDS));
+
+    for (size_t begin = 0; begin < dataset.size(); begin += BLOCK_RECORDS) {
+        const size_t block = std::min(BLOCK_RECORDS, dataset.size() - begin);
+
+        for (size_t k = 0; k < block; ++k) {
+            const DatasetRecord& r = dataset[begin + k];
+            std::copy(r.rx, r.rx + CODEWORD_SIZE, llrs[k].begin());
+        }
+
+        for (size_t d = 0; d < count; ++d) {
+            const AbstractDecoder<N>& decoder = *decoders[d];
+            auto& decided = decisions[d];
+
+            const auto start = Clock::now();
+            for (size_t k = 0; k < block; ++k) {
+                decided[k] = static_cast<uint32_t>(decoder.decode(llrs[k]).to_ulong());
+            }
+            result.decoders[d].decode_ns += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        }
+
+        for (size_t k = 0; k < block; ++k) {
+            const uint32_t tx_bits = dataset[begin + k].tx_bits;
+            bool split = false;
+            for (size_t a = 0; a < count; ++a) {
+                result.decoders[a].failed += decisions[a][k] != tx_bits;
+                for (size_t b = a + 1; b < count; ++b) {
+                    if (decisions[a][k] != decisions[b][k]) {
+                        ++result.disagreements[a][b];
+                        ++result.disagreements[b][a];
+                        split = true;
+                    }
+                }
+            }
+            result.any_disagreement += split;
+        }
+    }
+
+    return result;
+}
+
+} // namespace
+
+size_t write_dataset(const std::string& path, const DatasetConfig& config) {
+    if (config.count < 0) {
+        throw std::invalid_argument("lib/dataset.cpp: record count must be non-negative");
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.record_size = sizeof(DatasetRecord);
+    header.n = static_cast<uint32_t>(config.n);
+    header.snr_db = config.snr_db;
+    header.seed = config.seed;
+    header.record_count = static_cast<uint64_t>(config.count);
+
+    BufferedFile out(path);
+    out.append(&header, sizeof(header));
+
+    switch (config.n) {
+        case 2:  generate_records<2>(config, out); break;
+        case 4:  generate_records<4>(config, out); break;
+        case 6:  generate_records<6>(config, out); break;
+        case 8:  generate_records<8>(config, out); break;
+        case 11: generate_records<11>(config, out); break;
+        default:
+            throw std::invalid_argument("lib/dataset.cpp: invalid num_of_pucch_f2_bits");
+    }
+
+    return out.commit();
+}
+
+Dataset::Dataset(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("lib/dataset.cpp: cannot open " + path);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader)) {
+        close(fd);
+        throw std::invalid_argument("lib/dataset.cpp: truncated dataset file " + path);
+    }
+
+    bytes_ = static_cast<size_t>(st.st_size);
+    data_ = mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("lib/dataset.cpp: cannot map " + path);
+    }
+
+    FileHeader header;
+    std::memcpy(&header, data_, sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.record_size != sizeof(DatasetRecord)) {
+        munmap(data_, bytes_);
+        throw std::invalid_argument("lib/dataset.cpp: unsupported dataset file " + path);
+    }
+    if (bytes_ != sizeof(header) + header.record_count * sizeof(DatasetRecord)) {
+        munmap(data_, bytes_);
+        throw std::invalid_argument("lib/dataset.cpp: truncated dataset file " + path);
+    }
+
+    n_ = static_cast<int>(header.n);
+    snr_db_ = header.snr_db;
+    seed_ = header.seed;
+    count_ = static_cast<size_t>(header.record_count);
+    records_ = reinterpret_cast<const DatasetRecord*>(static_cast<const char*>(data_) + sizeof(header));
+
+    // Replay walks the file front to back exactly once.
+    madvise(data_, bytes_, MADV_SEQUENTIAL);
+}
+
+Dataset::~Dataset() {
+    if (data_ != nullptr) {
+        munmap(data_, bytes_);
+    }
+}
+
+ReplayResult replay_dataset(const Dataset& dataset, const std::vector<std::string>& decoders,
+                            const DecoderOptions& options) {
+    if (decoders.empty()) {
+        throw std::invalid_argument("lib/dataset.cpp: no decoders to replay");
+    }
+
+    switch (dataset.n()) {
+        case 2:  return replay<2>(dataset, decoders, options);
+        case 4:  return replay<4>(dataset, decoders, options);
+        case 6:  return replay<6>(dataset, decoders, options);
+        case 8:  return replay<8>(dataset, decoders, options);
+        case 11: return replay<11>(dataset, decoders, options);
+        default:
+            throw std::invalid_argument("lib/dataset.cpp: invalid num_of_pucch_f2_bits");
+    }
+}
+
+} // namespace qpsk
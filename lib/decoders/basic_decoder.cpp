@@ -3,21 +3,12 @@
 namespace qpsk {
 
 template <int N>
-std::bitset<N> BasicDecoder<N>::decode(const std::vector<double>& llrs) const {
-    if (llrs.size() != CODEWORD_SIZE) {
-        throw std::invalid_argument("lib/decoders/basic_decoder.cpp: LLR vector must have 20 elements");
-    }
-
+template <typename Sink>
+void BasicDecoder<N>::scan(const std::vector<double>& llrs, Sink& sink) const {
     BlockEncoder<N> code;
 
-    size_t total = 1ULL << N;
-    double best_metric = -1e300;
-
-    std::bitset<N> best_word;
-
-    for (size_t i = 0; i < total; ++i) {
-        std::bitset<N> candidate(i);
-        std::bitset<CODEWORD_SIZE> codeword = code.encode(candidate);
+    for (size_t i = 0; i < (1ULL << N); ++i) {
+        std::bitset<CODEWORD_SIZE> codeword = code.encode(std::bitset<N>(i));
         double metric = 0.0;
 
         for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
@@ -26,13 +17,30 @@ std::bitset<N> BasicDecoder<N>::decode(const std::vector<double>& llrs) const {
             }
         }
 
-        if (metric > best_metric) {
-            best_metric = metric;
-            best_word = candidate;
-        }
+        sink.add(static_cast<uint32_t>(i), metric);
+    }
+}
+
+template <int N>
+std::bitset<N> BasicDecoder<N>::decode(const std::vector<double>& llrs) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/basic_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    BestCandidate<> best;
+    scan(llrs, best);
+    return std::bitset<N>(best.index());
+}
+
+template <int N>
+DecodeResult<N> BasicDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/basic_decoder.cpp: LLR vector must have 20 elements");
     }
 
-    return best_word;
+    CandidateRanking<N> ranking(soft);
+    scan(llrs, ranking);
+    return ranking.result(metric_span(llrs));
 }
 
 template class BasicDecoder<2>;
@@ -0,0 +1,71 @@
+#include "blind_detector.hpp"
+#include "codebook.hpp"
+
+#include <algorithm>
+
+namespace qpsk {
+
+BlindDetector::BlindDetector(std::vector<int> sizes, double margin)
+    : sizes_(std::move(sizes)), margin_(margin), codebook_(packed_codebook<11>().data()) {
+    if (sizes_.empty()) {
+        sizes_.assign(VALID_N_BITS.begin(), VALID_N_BITS.end());
+    }
+    std::sort(sizes_.begin(), sizes_.end());
+    sizes_.erase(std::unique(sizes_.begin(), sizes_.end()), sizes_.end());
+
+    for (int n : sizes_) {
+        if (std::find(VALID_N_BITS.begin(), VALID_N_BITS.end(), n) == VALID_N_BITS.end()) {
+            throw std::invalid_argument("lib/decoders/blind_detector.cpp: invalid num_of_pucch_f2_bits");
+        }
+    }
+    if (margin_ < 0.0) {
+        throw std::invalid_argument("lib/decoders/blind_detector.cpp: margin must be non-negative");
+    }
+}
+
+BlindDetection BlindDetector::detect(const std::vector<double>& llrs) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/blind_detector.cpp: LLR vector must have 20 elements");
+    }
+
+    PartialSumTables tables;
+    build_partial_sums(llrs.data(), tables);
+
+    BlindDetection detection;
+    detection.sizes.resize(sizes_.size());
+
+    double best = -1e300;
+    double second = -1e300;
+    uint32_t best_index = 0;
+    uint32_t i = 0;
+
+    for (size_t s = 0; s < sizes_.size(); ++s) {
+        const uint32_t end = 1U << sizes_[s];
+        for (; i < end; ++i) {
+            const double metric = partial_sum_score(tables, codebook_[i]);
+            if (metric > best) {
+                second = best;
+                best = metric;
+                best_index = i;
+            } else if (metric > second) {
+                second = metric;
+            }
+        }
+
+        SizeHypothesis& h = detection.sizes[s];
+        h.n = sizes_[s];
+        h.bits = best_index;
+        h.best_metric = best;
+        h.second_metric = second;
+        h.correlation = normalized_correlation(best, llrs);
+    }
+
+    const double top = detection.sizes.back().correlation;
+    while (detection.selected + 1 < detection.sizes.size() &&
+           detection.sizes[detection.selected].correlation < top - margin_) {
+        ++detection.selected;
+    }
+    return detection;
+}
+
+} // namespace qpsk
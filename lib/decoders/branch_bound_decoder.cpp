@@ -0,0 +1,228 @@
+#include "branch_bound_decoder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace qpsk {
+
+template <int N>
+struct BranchBoundDecoder<N>::Search {
+    const double* llrs;
+    std::array<int, N> order;
+    std::array<uint32_t, N + 1> determined;  // positions whose row is fully fixed at a given depth
+    std::array<double, N + 1> remaining;     // bound on the positions still open at a given depth
+    double slack;
+    double best_metric;
+    uint32_t best_info;
+    size_t nodes;
+    // decode_full() also tracks the runner-up and, for soft output, the best
+    // metric on each side of every bit. A subtree is pruned only when it
+    // cannot beat `floor`, the weakest of the values still being tracked.
+    bool full;
+    bool soft;
+    double second_metric;
+    std::array<std::array<double, N>, 2> side;
+    double floor;
+};
+
+template <int N>
+BranchBoundDecoder<N>::BranchBoundDecoder() {
+    columns_.fill(0);
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        rows_[j] = 0;
+        for (int i = 0; i < N; ++i) {
+            if (BASE_MATRIX[j][i]) {
+                rows_[j] |= 1U << i;
+                columns_[i] |= 1U << j;
+            }
+        }
+    }
+}
+
+template <int N>
+std::bitset<N> BranchBoundDecoder<N>::decode(const std::vector<double>& llrs) const {
+    size_t nodes_visited = 0;
+    return decode(llrs, nodes_visited);
+}
+
+template <int N>
+std::bitset<N> BranchBoundDecoder<N>::decode(const std::vector<double>& llrs, size_t& nodes_visited) const {
+    Search s;
+    s.full = false;
+    s.soft = false;
+    run(s, llrs);
+
+    nodes_visited = s.nodes;
+    return std::bitset<N>(s.best_info);
+}
+
+template <int N>
+DecodeResult<N> BranchBoundDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    Search s;
+    s.full = true;
+    s.soft = soft;
+    run(s, llrs);
+
+    const double span = metric_span(llrs);
+
+    DecodeResult<N> r;
+    r.index = s.best_info;
+    r.bits = std::bitset<N>(s.best_info);
+    r.best_metric = s.best_metric;
+    r.second_metric = std::isfinite(s.second_metric) ? s.second_metric : s.best_metric - span;
+
+    if (soft) {
+        r.soft.resize(N);
+        for (int i = 0; i < N; ++i) {
+            const bool one = (s.best_info >> i) & 1U;
+            const double other = s.side[!one][i];
+            const double gap = std::isfinite(other) ? s.best_metric - other : span;
+            r.soft[i] = one ? gap : -gap;
+        }
+    }
+    return r;
+}
+
+template <int N>
+void BranchBoundDecoder<N>::run(Search& s, const std::vector<double>& llrs) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/branch_bound_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    s.llrs = llrs.data();
+    s.best_metric = -std::numeric_limits<double>::infinity();
+    s.best_info = 0;
+    s.nodes = 0;
+    s.second_metric = -std::numeric_limits<double>::infinity();
+    for (auto& side : s.side) {
+        side.fill(-std::numeric_limits<double>::infinity());
+    }
+    s.floor = -std::numeric_limits<double>::infinity();
+
+    std::array<int, CODEWORD_SIZE> positions;
+    double total_abs = 0.0;
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        positions[j] = static_cast<int>(j);
+        total_abs += std::abs(llrs[j]);
+    }
+    std::stable_sort(positions.begin(), positions.end(), [&](int a, int b) {
+        return std::abs(llrs[a]) > std::abs(llrs[b]);
+    });
+
+    // Bound sums are accumulated in a different order than leaf metrics, so
+    // pruning keeps a small tolerance to stay exact.
+    s.slack = 1e-9 * (1.0 + total_abs);
+
+    std::array<int, N> rank;
+    rank.fill(-1);
+    int fixed = 0;
+    for (int j : positions) {
+        for (int i = 0; i < N; ++i) {
+            if (((rows_[j] >> i) & 1U) && rank[i] < 0) {
+                rank[i] = fixed;
+                s.order[fixed++] = i;
+            }
+        }
+    }
+    for (int i = 0; i < N; ++i) {
+        if (rank[i] < 0) {
+            rank[i] = fixed;
+            s.order[fixed++] = i;
+        }
+    }
+
+    s.determined.fill(0);
+    s.remaining.fill(0.0);
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        int depth = 0;
+        for (int i = 0; i < N; ++i) {
+            if ((rows_[j] >> i) & 1U) {
+                depth = std::max(depth, rank[i] + 1);
+            }
+        }
+        s.determined[depth] |= 1U << j;
+
+        for (int d = 0; d < depth; ++d) {
+            s.remaining[d] += std::max(0.0, llrs[j]);
+        }
+    }
+
+    search(s, 0, 0, 0, 0.0);
+}
+
+template <int N>
+void BranchBoundDecoder<N>::search(Search& s, int depth, uint32_t parity, uint32_t info, double partial) const {
+    ++s.nodes;
+
+    if (depth == N) {
+        double metric = 0.0;
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            if ((parity >> j) & 1U) {
+                metric += s.llrs[j];
+            }
+        }
+
+        if (metric > s.best_metric || (metric == s.best_metric && info < s.best_info)) {
+            s.second_metric = s.best_metric;
+            s.best_metric = metric;
+            s.best_info = info;
+        } else if (metric > s.second_metric) {
+            s.second_metric = metric;
+        }
+
+        if (!s.full) {
+            s.floor = s.best_metric;
+            return;
+        }
+
+        s.floor = s.second_metric;
+        if (s.soft) {
+            for (int i = 0; i < N; ++i) {
+                double& side = s.side[(info >> i) & 1U][i];
+                side = std::max(side, metric);
+            }
+            for (int i = 0; i < N; ++i) {
+                s.floor = std::min(s.floor, s.side[!((s.best_info >> i) & 1U)][i]);
+            }
+        }
+        return;
+    }
+
+    const int bit = s.order[depth];
+    const uint32_t newly = s.determined[depth + 1];
+
+    uint32_t child_parity[2] = {parity, parity ^ columns_[bit]};
+    double child_partial[2] = {partial, partial};
+
+    for (int b = 0; b < 2; ++b) {
+        uint32_t active = newly & child_parity[b];
+        while (active) {
+            child_partial[b] += s.llrs[__builtin_ctz(active)];
+            active &= active - 1;
+        }
+    }
+
+    // Follow the child that agrees better with the received signal first, so
+    // a strong incumbent is found early.
+    const int first = child_partial[1] > child_partial[0] ? 1 : 0;
+
+    for (int k = 0; k < 2; ++k) {
+        const int b = k == 0 ? first : 1 - first;
+        const double bound = child_partial[b] + s.remaining[depth + 1];
+
+        if (bound + s.slack < s.floor) {
+            continue;
+        }
+
+        search(s, depth + 1, child_parity[b], info | (static_cast<uint32_t>(b) << bit), child_partial[b]);
+    }
+}
+
+template class BranchBoundDecoder<2>;
+template class BranchBoundDecoder<4>;
+template class BranchBoundDecoder<6>;
+template class BranchBoundDecoder<8>;
+template class BranchBoundDecoder<11>;
+
+} // namespace qpsk
@@ -0,0 +1,131 @@
+#include "decoder_registry.hpp"
+#include "basic_decoder.hpp"
+#include "precomputed_decoder.hpp"
+#include "partial_sum_decoder.hpp"
+#include "unrolled_decoder.hpp"
+#include "simd_decoder.hpp"
+#include "fixed_point_decoder.hpp"
+#include "simd_fixed_point_decoder.hpp"
+#include "branch_bound_decoder.hpp"
+#include "early_exit_decoder.hpp"
+#include "osd_decoder.hpp"
+#include "hard_decision_decoder.hpp"
+#include "parallel_decoder.hpp"
+#include "utils/cpu_affinity.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace qpsk {
+
+const std::vector<DecoderInfo>& registered_decoders() {
+    static const std::vector<DecoderInfo> decoders = {
+        {"Basic", true},
+        {"Precomputed", true},
+        {"PartialSum", true},
+        {"Unrolled", true},
+#ifdef __AVX2__
+        {"SIMD", true},
+#endif
+        {"BranchBound", true},
+        {"EarlyExit", true},
+        {"OSD", false},
+        {"FixedPoint", false},
+#ifdef __AVX2__
+        {"SIMDFixedPoint", false},
+#endif
+        {"HardDecision", false},
+        {"HardDecisionSoftTie", false},
+        {"Parallel", true, false},
+    };
+    return decoders;
+}
+
+bool is_registered_decoder(const std::string& name) {
+    const auto& decoders = registered_decoders();
+    return std::any_of(decoders.begin(), decoders.end(),
+                       [&](const DecoderInfo& info) { return info.name == name; });
+}
+
+template <int N>
+std::unique_ptr<AbstractDecoder<N>> make_decoder(const std::string& name, const DecoderOptions& options) {
+    if (name == "Basic") {
+        return std::make_unique<BasicDecoder<N>>();
+    }
+    if (name == "Precomputed") {
+        return std::make_unique<PrecomputedDecoder<N>>();
+    }
+    if (name == "PartialSum") {
+        return std::make_unique<PartialSumDecoder<N>>();
+    }
+    if (name == "Unrolled") {
+        return std::make_unique<UnrolledDecoder<N>>();
+    }
+#ifdef __AVX2__
+    if (name == "SIMD") {
+        return std::make_unique<SimdDecoder<N>>();
+    }
+    if (name == "SIMDFixedPoint") {
+        return std::make_unique<SimdFixedPointDecoder<N>>();
+    }
+#endif
+    if (name == "BranchBound") {
+        return std::make_unique<BranchBoundDecoder<N>>();
+    }
+    if (name == "EarlyExit") {
+#ifdef __AVX2__
+        return std::make_unique<EarlyExitDecoder<N>>(std::make_unique<SimdDecoder<N>>());
+#else
+        return std::make_unique<EarlyExitDecoder<N>>(std::make_unique<PrecomputedDecoder<N>>());
+#endif
+    }
+    if (name == "OSD") {
+        return std::make_unique<OsdDecoder<N>>(options.budget);
+    }
+    if (name == "FixedPoint") {
+        return std::make_unique<FixedPointDecoder<N>>();
+    }
+    if (name == "HardDecision") {
+        return std::make_unique<HardDecisionDecoder<N>>();
+    }
+    if (name == "HardDecisionSoftTie") {
+        return std::make_unique<HardDecisionDecoder<N>>(HardTieBreak::SoftMetric);
+    }
+    if (name == "Parallel") {
+        const int spare = static_cast<int>(allowed_cpus().size()) - 1;
+        const int helpers = options.helpers > 0 ? options.helpers : std::max(1, std::min(3, spare));
+        return std::make_unique<ParallelDecoder<N>>(helpers, options.helper_cpus);
+    }
+
+    throw std::invalid_argument("lib/decoders/decoder_registry.cpp: unknown decoder '" + name + "'");
+}
+
+template <int N>
+const AbstractDecoder<N>& shared_decoder(const std::string& name, const DecoderOptions& options) {
+    static std::mutex mutex;
+    static std::map<std::tuple<std::string, int, int, std::vector<int>>, std::unique_ptr<AbstractDecoder<N>>> decoders;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto& decoder = decoders[{name, options.budget, options.helpers, options.helper_cpus}];
+    if (!decoder) {
+        decoder = make_decoder<N>(name, options);
+    }
+    return *decoder;
+}
+
+template std::unique_ptr<AbstractDecoder<2>> make_decoder<2>(const std::string&, const DecoderOptions&);
+template std::unique_ptr<AbstractDecoder<4>> make_decoder<4>(const std::string&, const DecoderOptions&);
+template std::unique_ptr<AbstractDecoder<6>> make_decoder<6>(const std::string&, const DecoderOptions&);
+template std::unique_ptr<AbstractDecoder<8>> make_decoder<8>(const std::string&, const DecoderOptions&);
+template std::unique_ptr<AbstractDecoder<11>> make_decoder<11>(const std::string&, const DecoderOptions&);
+
+template const AbstractDecoder<2>& shared_decoder<2>(const std::string&, const DecoderOptions&);
+template const AbstractDecoder<4>& shared_decoder<4>(const std::string&, const DecoderOptions&);
+template const AbstractDecoder<6>& shared_decoder<6>(const std::string&, const DecoderOptions&);
+template const AbstractDecoder<8>& shared_decoder<8>(const std::string&, const DecoderOptions&);
+template const AbstractDecoder<11>& shared_decoder<11>(const std::string&, const DecoderOptions&);
+
+} // namespace qpsk
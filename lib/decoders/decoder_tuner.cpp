@@ -0,0 +1,202 @@
+#include "decoder_tuner.hpp"
+#include "decoder_registry.hpp"
+#include "encoder.hpp"
+#include "qpsk.hpp"
+#include "channel.hpp"
+#include "random_bits.hpp"
+#include "utils/file_utils.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+namespace qpsk {
+
+namespace {
+
+constexpr size_t TUNE_BATCH = 64;
+constexpr double TUNE_SNR_DB = 0.0;
+constexpr auto TUNE_MIN_TIME = std::chrono::milliseconds(10);
+
+std::mutex tuner_mutex;
+std::map<std::pair<std::string, int>, std::string> selected_decoders;
+
+template <int N>
+std::vector<std::vector<double>> tuning_llrs() {
+    BlockEncoder<N> code;
+    QPSK mod;
+    Channel channel(TUNE_SNR_DB);
+    std::mt19937 rng = make_rng(N);
+
+    std::vector<std::vector<double>> llrs;
+    for (size_t i = 0; i < TUNE_BATCH; ++i) {
+        llrs.push_back(mod.demodulate(channel.apply(mod.modulate(code.encode(generate_random_bits<N>(rng))), rng)));
+    }
+    return llrs;
+}
+
+template <int N>
+double measure_ns(const AbstractDecoder<N>& decoder, const std::vector<std::vector<double>>& llrs) {
+    using clock = std::chrono::steady_clock;
+
+    for (const auto& v : llrs) {
+        decoder.decode(v);
+    }
+
+    size_t decodes = 0;
+    const auto start = clock::now();
+    auto now = start;
+    while (now - start < TUNE_MIN_TIME) {
+        for (const auto& v : llrs) {
+            volatile auto result = decoder.decode(v);
+            (void)result;
+        }
+        decodes += llrs.size();
+        now = clock::now();
+    }
+
+    return std::chrono::duration<double, std::nano>(now - start).count() / decodes;
+}
+
+template <int N>
+TuneResult tune() {
+    auto llrs = tuning_llrs<N>();
+
+    TuneResult result;
+    result.n = N;
+    double best_ns = 0.0;
+
+    for (const auto& info : registered_decoders()) {
+        if (!info.exact || !info.tunable) {
+            continue;
+        }
+
+        double ns = measure_ns<N>(*make_decoder<N>(info.name), llrs);
+        result.timings_ns.emplace_back(info.name, ns);
+
+        if (result.decoder.empty() || ns < best_ns) {
+            best_ns = ns;
+            result.decoder = info.name;
+        }
+    }
+
+    return result;
+}
+
+json load_cache() {
+    try {
+        json cache = json::parse(read_file(decoder_cache_path()));
+        if (cache.is_object()) {
+            return cache;
+        }
+    } catch (const std::exception&) {
+    }
+    return json::object();
+}
+
+void store_cache(const std::vector<TuneResult>& results) {
+    json cache = load_cache();
+    json& entry = cache[cpu_model()];
+
+    for (const auto& r : results) {
+        entry[std::to_string(r.n)] = r.decoder;
+    }
+
+    const std::string path = decoder_cache_path();
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    write_file_atomic(path, cache.dump(2) + "\n");
+}
+
+} // namespace
+
+std::string cpu_model() {
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+
+    while (std::getline(cpuinfo, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos && colon + 2 <= line.size()) {
+                return line.substr(colon + 2);
+            }
+        }
+    }
+
+    return "unknown";
+}
+
+std::string decoder_cache_path() {
+    if (const char* path = std::getenv("QPSK_DECODER_CACHE")) {
+        return path;
+    }
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
+        return std::string(xdg) + "/qpsk/decoders.json";
+    }
+    if (const char* home = std::getenv("HOME")) {
+        return std::string(home) + "/.cache/qpsk/decoders.json";
+    }
+    return ".qpsk_decoders.json";
+}
+
+TuneResult tune_decoder(int n) {
+    switch (n) {
+        case 2:  return tune<2>();
+        case 4:  return tune<4>();
+        case 6:  return tune<6>();
+        case 8:  return tune<8>();
+        case 11: return tune<11>();
+        default:
+            throw std::invalid_argument("lib/decoders/decoder_tuner.cpp: invalid num_of_pucch_f2_bits");
+    }
+}
+
+std::vector<TuneResult> tune_decoders() {
+    std::lock_guard<std::mutex> lock(tuner_mutex);
+
+    std::vector<TuneResult> results;
+    for (int n : VALID_N_BITS) {
+        results.push_back(tune_decoder(n));
+    }
+
+    store_cache(results);
+    for (const auto& r : results) {
+        selected_decoders[{decoder_cache_path(), r.n}] = r.decoder;
+    }
+    return results;
+}
+
+std::string select_decoder(int n) {
+    std::lock_guard<std::mutex> lock(tuner_mutex);
+
+    const auto memo_key = std::make_pair(decoder_cache_path(), n);
+    auto it = selected_decoders.find(memo_key);
+    if (it != selected_decoders.end()) {
+        return it->second;
+    }
+
+    json cache = load_cache();
+    const std::string model = cpu_model();
+    const std::string key = std::to_string(n);
+
+    if (cache.contains(model) && cache[model].contains(key)) {
+        std::string name = cache[model][key];
+        if (is_registered_decoder(name)) {
+            return selected_decoders[memo_key] = name;
+        }
+    }
+
+    TuneResult result = tune_decoder(n);
+    try {
+        store_cache({result});
+    } catch (const std::exception&) {
+        // A read-only cache location only costs a re-tune in the next process.
+    }
+
+    return selected_decoders[memo_key] = result.decoder;
+}
+
+} // namespace qpsk
@@ -0,0 +1,78 @@
+#include "early_exit_decoder.hpp"
+#include "precomputed_decoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace qpsk {
+
+template <int N>
+EarlyExitDecoder<N>::EarlyExitDecoder() : EarlyExitDecoder(std::make_unique<PrecomputedDecoder<N>>()) {}
+
+template <int N>
+EarlyExitDecoder<N>::EarlyExitDecoder(std::unique_ptr<AbstractDecoder<N>> fallback)
+    : min_distance_(minimum_distance(N)), fallback_(std::move(fallback)) {
+    if (!fallback_) {
+        throw std::invalid_argument("lib/decoders/early_exit_decoder.cpp: fallback decoder is required");
+    }
+}
+
+template <int N>
+std::bitset<N> EarlyExitDecoder<N>::decode(const std::vector<double>& llrs) const {
+    bool early_exit = false;
+    return decode(llrs, early_exit);
+}
+
+template <int N>
+std::bitset<N> EarlyExitDecoder<N>::decode(const std::vector<double>& llrs, bool& early_exit) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/early_exit_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    uint32_t word = 0;
+    std::array<double, CODEWORD_SIZE> reliability;
+    double total = 0.0;
+
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        word |= static_cast<uint32_t>(llrs[j] > 0.0) << j;
+        reliability[j] = std::abs(llrs[j]);
+        total += reliability[j];
+    }
+
+    early_exit = false;
+    int index = table_.find(word);
+
+    if (index >= 0) {
+        std::nth_element(reliability.begin(), reliability.begin() + min_distance_, reliability.end());
+
+        double margin = 0.0;
+        for (int k = 0; k < min_distance_; ++k) {
+            margin += reliability[k];
+        }
+
+        // The tolerance covers rounding in the exhaustive metric sums, so a
+        // near-tie is left to the fallback and the decision stays identical.
+        if (margin > 1e-9 * total) {
+            early_exit = true;
+            return std::bitset<N>(static_cast<unsigned long long>(index));
+        }
+    }
+
+    return fallback_->decode(llrs);
+}
+
+template <int N>
+DecodeResult<N> EarlyExitDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    // The sign-word shortcut says nothing about the runner-up, so the
+    // metrics always come from the fallback's full scan.
+    return fallback_->decode_full(llrs, soft);
+}
+
+template class EarlyExitDecoder<2>;
+template class EarlyExitDecoder<4>;
+template class EarlyExitDecoder<6>;
+template class EarlyExitDecoder<8>;
+template class EarlyExitDecoder<11>;
+
+} // namespace qpsk
@@ -0,0 +1,103 @@
+#include "fixed_point_decoder.hpp"
+#include "qpsk.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace qpsk {
+
+std::vector<int8_t> quantize_llrs(const std::vector<double>& llrs, int bits, double scale, double* applied_scale) {
+    if (bits < MIN_QUANTIZATION_BITS || bits > MAX_QUANTIZATION_BITS) {
+        throw std::invalid_argument("lib/decoders/fixed_point_decoder.cpp: quantization bits must be in [2, 8]");
+    }
+
+    const double max_level = static_cast<double>((1 << (bits - 1)) - 1);
+
+    if (scale <= 0.0) {
+        double max_abs = 0.0;
+        for (double llr : llrs) {
+            max_abs = std::max(max_abs, std::abs(llr));
+        }
+        scale = max_abs > 0.0 ? max_level / max_abs : 1.0;
+    }
+    if (applied_scale) {
+        *applied_scale = scale;
+    }
+
+    std::vector<int8_t> quantized(llrs.size());
+    for (size_t j = 0; j < llrs.size(); ++j) {
+        double level = std::clamp(std::nearbyint(llrs[j] * scale), -max_level, max_level);
+        quantized[j] = static_cast<int8_t>(level);
+    }
+
+    return quantized;
+}
+
+template <int N>
+FixedPointDecoder<N>::FixedPointDecoder(int bits, double scale) : bits_(bits), scale_(scale) {
+    BlockEncoder<N> encoder;
+    for (size_t i = 0; i < (1ULL << N); ++i) {
+        codewords_[i] = static_cast<uint32_t>(encoder.encode(std::bitset<N>(i)).to_ulong());
+    }
+}
+
+template <int N>
+template <typename Sink>
+void FixedPointDecoder<N>::scan(const std::vector<int8_t>& llrs, Sink& sink) const {
+    for (size_t i = 0; i < (1ULL << N); ++i) {
+        const uint32_t codeword = codewords_[i];
+
+        int32_t metric = 0;
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            if ((codeword >> j) & 1U) {
+                metric += llrs[j];
+            }
+        }
+
+        sink.add(static_cast<uint32_t>(i), metric);
+    }
+}
+
+template <int N>
+std::bitset<N> FixedPointDecoder<N>::decode(const std::vector<double>& llrs) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/fixed_point_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    return decode_quantized(quantize_llrs(llrs, bits_, scale_));
+}
+
+template <int N>
+std::bitset<N> FixedPointDecoder<N>::decode_quantized(const std::vector<int8_t>& llrs) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/fixed_point_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    BestCandidate<int32_t> best;
+    scan(llrs, best);
+    return std::bitset<N>(best.index());
+}
+
+template <int N>
+DecodeResult<N> FixedPointDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/fixed_point_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    double scale = 0.0;
+    const auto quantized = quantize_llrs(llrs, bits_, scale_, &scale);
+
+    // Integer metrics are ranked as they are and reported in LLR units.
+    CandidateRanking<N> ranking(soft);
+    ScaledRanking<N> scaled{ranking, scale};
+    scan(quantized, scaled);
+    return ranking.result(metric_span(llrs));
+}
+
+template class FixedPointDecoder<2>;
+template class FixedPointDecoder<4>;
+template class FixedPointDecoder<6>;
+template class FixedPointDecoder<8>;
+template class FixedPointDecoder<11>;
+
+} // namespace qpsk
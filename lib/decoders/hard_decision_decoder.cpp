@@ -0,0 +1,177 @@
+#include "hard_decision_decoder.hpp"
+
+#include <limits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace qpsk {
+
+namespace {
+
+// Candidates are ranked by (distance << INDEX_BITS) | index, so one unsigned
+// minimum gives the nearest codeword and, among equals, the lowest index.
+constexpr uint32_t INDEX_BITS = 16;
+
+#ifdef __AVX2__
+// Popcount of each 32-bit lane: vpshufb nibble lookups give per-byte counts,
+// and two multiply-adds by one sum the four bytes of every lane.
+inline __m256i popcount_epi32(__m256i x) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, _mm256_and_si256(x, nibble)),
+                                          _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi32(x, 4), nibble)));
+    return _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, _mm256_set1_epi8(1)), _mm256_set1_epi16(1));
+}
+#endif
+
+template <int N>
+uint32_t nearest_key(const std::array<uint32_t, 1ULL << N>& codebook, uint32_t word) {
+#ifdef __AVX2__
+    if constexpr ((1ULL << N) >= 8) {
+        const __m256i received = _mm256_set1_epi32(static_cast<int>(word));
+        const __m256i step = _mm256_set1_epi32(8);
+        __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i best = _mm256_set1_epi32(-1);
+
+        for (size_t i = 0; i < codebook.size(); i += 8) {
+            const __m256i codewords = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&codebook[i]));
+            const __m256i distance = popcount_epi32(_mm256_xor_si256(codewords, received));
+            best = _mm256_min_epu32(best, _mm256_or_si256(_mm256_slli_epi32(distance, INDEX_BITS), index));
+            index = _mm256_add_epi32(index, step);
+        }
+
+        best = _mm256_min_epu32(best, _mm256_permute2x128_si256(best, best, 0x01));
+        best = _mm256_min_epu32(best, _mm256_shuffle_epi32(best, _MM_SHUFFLE(1, 0, 3, 2)));
+        best = _mm256_min_epu32(best, _mm256_shuffle_epi32(best, _MM_SHUFFLE(2, 3, 0, 1)));
+        return static_cast<uint32_t>(_mm256_cvtsi256_si32(best));
+    }
+#endif
+    uint32_t best = std::numeric_limits<uint32_t>::max();
+    for (uint32_t i = 0; i < codebook.size(); ++i) {
+        const uint32_t key = (static_cast<uint32_t>(__builtin_popcount(codebook[i] ^ word)) << INDEX_BITS) | i;
+        best = key < best ? key : best;
+    }
+    return best;
+}
+
+// Calls f(i) for every candidate i at Hamming distance `distance` from word,
+// in ascending order.
+template <int N, typename F>
+void for_each_at_distance(const std::array<uint32_t, 1ULL << N>& codebook, uint32_t word, int distance, F&& f) {
+#ifdef __AVX2__
+    if constexpr ((1ULL << N) >= 8) {
+        const __m256i received = _mm256_set1_epi32(static_cast<int>(word));
+        const __m256i target = _mm256_set1_epi32(distance);
+        for (uint32_t i = 0; i < codebook.size(); i += 8) {
+            const __m256i codewords = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&codebook[i]));
+            const __m256i equal = _mm256_cmpeq_epi32(popcount_epi32(_mm256_xor_si256(codewords, received)), target);
+            for (int hits = _mm256_movemask_ps(_mm256_castsi256_ps(equal)); hits != 0; hits &= hits - 1) {
+                f(i + static_cast<uint32_t>(__builtin_ctz(hits)));
+            }
+        }
+        return;
+    }
+#endif
+    for (uint32_t i = 0; i < codebook.size(); ++i) {
+        if (__builtin_popcount(codebook[i] ^ word) == distance) {
+            f(i);
+        }
+    }
+}
+
+// Correlation over the codeword's ones, the metric of the soft decoders.
+double soft_metric(uint32_t codeword, const double* llrs) {
+    double metric = 0.0;
+    for (; codeword != 0; codeword &= codeword - 1) {
+        metric += llrs[__builtin_ctz(codeword)];
+    }
+    return metric;
+}
+
+} // namespace
+
+uint32_t hard_slice(const double* llrs) {
+    uint32_t word = 0;
+#ifdef __AVX2__
+    const __m256d zero = _mm256_setzero_pd();
+    for (size_t j = 0; j < CODEWORD_SIZE; j += 4) {
+        const int positive = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(llrs + j), zero, _CMP_GT_OQ));
+        word |= static_cast<uint32_t>(positive) << j;
+    }
+#else
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        word |= static_cast<uint32_t>(llrs[j] > 0.0) << j;
+    }
+#endif
+    return word;
+}
+
+template <int N>
+HardDecisionDecoder<N>::HardDecisionDecoder(HardTieBreak tie_break)
+    : codebook_(packed_codebook<N>()), tie_break_(tie_break) {}
+
+template <int N>
+uint32_t HardDecisionDecoder<N>::nearest(const double* llrs, uint32_t word) const {
+    const uint32_t key = nearest_key<N>(codebook_, word);
+    uint32_t best = key & ((1U << INDEX_BITS) - 1);
+    if (tie_break_ == HardTieBreak::LowestIndex) {
+        return best;
+    }
+
+    // A second pass over the codebook, for the candidates tied at the
+    // minimum distance only.
+    double best_metric = -std::numeric_limits<double>::infinity();
+    for_each_at_distance<N>(codebook_, word, static_cast<int>(key >> INDEX_BITS), [&](uint32_t i) {
+        const double metric = soft_metric(codebook_[i], llrs);
+        if (metric > best_metric) {
+            best_metric = metric;
+            best = i;
+        }
+    });
+    return best;
+}
+
+template <int N>
+std::bitset<N> HardDecisionDecoder<N>::decode(const std::vector<double>& llrs) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/hard_decision_decoder.cpp: LLR vector must have 20 elements");
+    }
+    return std::bitset<N>(nearest(llrs.data(), hard_slice(llrs.data())));
+}
+
+template <int N>
+DecodeResult<N> HardDecisionDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/hard_decision_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    // Over LLRs sliced to +-level, the correlation of a codeword at Hamming
+    // distance d from the sliced word is level * (popcount(word) - d).
+    const uint32_t word = hard_slice(llrs.data());
+    const double span = metric_span(llrs);
+    const double level = span / CODEWORD_SIZE;
+    const int ones = __builtin_popcount(word);
+
+    CandidateRanking<N> ranking(soft);
+    for (uint32_t i = 0; i < codebook_.size(); ++i) {
+        ranking.add(i, level * (ones - __builtin_popcount(codebook_[i] ^ word)));
+    }
+
+    DecodeResult<N> result = ranking.result(span);
+    if (tie_break_ == HardTieBreak::SoftMetric) {
+        result.index = nearest(llrs.data(), word);
+        result.bits = std::bitset<N>(result.index);
+    }
+    return result;
+}
+
+template class HardDecisionDecoder<2>;
+template class HardDecisionDecoder<4>;
+template class HardDecisionDecoder<6>;
+template class HardDecisionDecoder<8>;
+template class HardDecisionDecoder<11>;
+
+} // namespace qpsk
@@ -0,0 +1,114 @@
+#include "known_bits_decoder.hpp"
+#include "codebook.hpp"
+
+namespace qpsk {
+
+KnownBits make_known_bits(int n, const std::vector<int>& positions, const std::vector<int>& values) {
+    if (positions.size() != values.size()) {
+        throw std::invalid_argument("lib/decoders/known_bits_decoder.cpp: positions and values differ in length");
+    }
+
+    KnownBits known;
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const int position = positions[i];
+        if (position < 0 || position >= n) {
+            throw std::invalid_argument("lib/decoders/known_bits_decoder.cpp: known bit position out of range");
+        }
+        if (values[i] != 0 && values[i] != 1) {
+            throw std::invalid_argument("lib/decoders/known_bits_decoder.cpp: known bit value must be 0 or 1");
+        }
+        if (known.mask & (1U << position)) {
+            throw std::invalid_argument("lib/decoders/known_bits_decoder.cpp: duplicate known bit position");
+        }
+        known.mask |= 1U << position;
+        known.values |= static_cast<uint32_t>(values[i]) << position;
+    }
+    return known;
+}
+
+KnownBits parse_known_bits(const json& spec, int n) {
+    if (!spec.is_object() || !spec.contains("positions") || !spec.contains("values") ||
+        !spec["positions"].is_array() || !spec["values"].is_array()) {
+        throw std::invalid_argument("lib/decoders/known_bits_decoder.cpp: known bits must be {\"positions\": [...], \"values\": [...]}");
+    }
+    return make_known_bits(n, spec["positions"].get<std::vector<int>>(), spec["values"].get<std::vector<int>>());
+}
+
+template <int N>
+KnownBitsDecoder<N>::KnownBitsDecoder(const KnownBits& known) : known_(known) {
+    if (known.mask >= (1U << N) || (known.values & ~known.mask) != 0) {
+        throw std::invalid_argument("lib/decoders/known_bits_decoder.cpp: known bits do not fit N");
+    }
+
+    const auto& codebook = packed_codebook<N>();
+    offset_ = codebook[known.values];
+
+    const uint32_t free = ((1U << N) - 1) & ~known.mask;
+    const size_t count = 1ULL << (N - known.count());
+    subcode_.reserve(count);
+    words_.reserve(count);
+
+    // Enumerate the free-bit subsets in ascending order.
+    uint32_t x = 0;
+    do {
+        subcode_.push_back(codebook[x]);
+        words_.push_back(x | known.values);
+        x = (x - free) & free;
+    } while (x != 0);
+}
+
+template <int N>
+double KnownBitsDecoder<N>::fold(const std::vector<double>& llrs, PartialSumTables& tables) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/known_bits_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    double folded[CODEWORD_SIZE];
+    double constant = 0.0;
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        const bool flip = (offset_ >> j) & 1U;
+        folded[j] = flip ? -llrs[j] : llrs[j];
+        constant += flip ? llrs[j] : 0.0;
+    }
+
+    build_partial_sums(folded, tables);
+    return constant;
+}
+
+template <int N>
+std::bitset<N> KnownBitsDecoder<N>::decode(const std::vector<double>& llrs) const {
+    PartialSumTables tables;
+    fold(llrs, tables);
+
+    double best_metric = -1e300;
+    size_t best = 0;
+    for (size_t i = 0; i < subcode_.size(); ++i) {
+        const double metric = partial_sum_score(tables, subcode_[i]);
+        if (metric > best_metric) {
+            best_metric = metric;
+            best = i;
+        }
+    }
+
+    return std::bitset<N>(words_[best]);
+}
+
+template <int N>
+DecodeResult<N> KnownBitsDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    PartialSumTables tables;
+    const double constant = fold(llrs, tables);
+
+    CandidateRanking<N> ranking(soft);
+    for (size_t i = 0; i < subcode_.size(); ++i) {
+        ranking.add(words_[i], constant + partial_sum_score(tables, subcode_[i]));
+    }
+    return ranking.result(metric_span(llrs));
+}
+
+template class KnownBitsDecoder<2>;
+template class KnownBitsDecoder<4>;
+template class KnownBitsDecoder<6>;
+template class KnownBitsDecoder<8>;
+template class KnownBitsDecoder<11>;
+
+} // namespace qpsk
@@ -0,0 +1,151 @@
+#include "osd_decoder.hpp"
+#include "codebook.hpp"
+#include "partial_sum_decoder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace qpsk {
+
+template <int N>
+OsdDecoder<N>::OsdDecoder(int budget) {
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        rows_[j] = 0;
+        for (int i = 0; i < N; ++i) {
+            if (BASE_MATRIX[j][i]) {
+                rows_[j] |= 1U << i;
+            }
+        }
+    }
+
+    // Small codes get every pattern, which makes the search exhaustive.
+    const int max_order = N <= MAX_ORDER + 1 ? N : MAX_ORDER;
+    for (uint32_t mask = 0; mask < (1U << N); ++mask) {
+        if (__builtin_popcount(mask) <= max_order) {
+            patterns_.push_back(mask);
+        }
+    }
+
+    // Bit b of a pattern is the b-th least reliable information position, so
+    // a lower sum of (b + 1) flips less reliable positions.
+    auto cost = [](uint32_t mask) {
+        int sum = 0;
+        for (uint32_t m = mask; m; m &= m - 1) {
+            sum += __builtin_ctz(m) + 1;
+        }
+        return sum;
+    };
+    std::stable_sort(patterns_.begin(), patterns_.end(),
+                     [&](uint32_t a, uint32_t b) { return cost(a) < cost(b); });
+
+    const size_t limit = static_cast<size_t>(budget > 0 ? budget : DEFAULT_BUDGET);
+    if (patterns_.size() > limit) {
+        patterns_.resize(limit);
+    }
+}
+
+template <int N>
+std::bitset<N> OsdDecoder<N>::decode(const std::vector<double>& llrs) const {
+    return decode_full(llrs).bits;
+}
+
+template <int N>
+DecodeResult<N> OsdDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/osd_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    // Insertion sort by |LLR|: 20 keys are too few for std::sort to pay off.
+    std::array<double, CODEWORD_SIZE> magnitude;
+    std::array<int, CODEWORD_SIZE> order;
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        const double key = std::abs(llrs[j]);
+        size_t k = j;
+        for (; k > 0 && magnitude[k - 1] < key; --k) {
+            magnitude[k] = magnitude[k - 1];
+            order[k] = order[k - 1];
+        }
+        magnitude[k] = key;
+        order[k] = static_cast<int>(j);
+    }
+
+    // Gauss-Jordan over the most reliable independent rows: reduced[k] is the
+    // XOR of the selected rows in combos[k] and ends up as a single pivot bit.
+    std::array<uint32_t, N> reduced;
+    std::array<uint32_t, N> combos;
+    std::array<int, N> pivots;
+    std::array<int, N> positions;
+    int rank = 0;
+
+    for (int position : order) {
+        uint32_t row = rows_[position];
+        uint32_t combo = 1U << rank;
+        // Branchless: the pivot bits are data dependent and mispredict badly.
+        for (int k = 0; k < rank; ++k) {
+            const uint32_t hit = 0U - ((row >> pivots[k]) & 1U);
+            row ^= reduced[k] & hit;
+            combo ^= combos[k] & hit;
+        }
+        if (row == 0) {
+            continue;
+        }
+        reduced[rank] = row;
+        combos[rank] = combo;
+        pivots[rank] = __builtin_ctz(row);
+        positions[rank] = position;
+        if (++rank == N) {
+            break;
+        }
+    }
+
+    for (int k = 0; k < N; ++k) {
+        for (int j = 0; j < N; ++j) {
+            const uint32_t hit = j == k ? 0U : 0U - ((reduced[j] >> pivots[k]) & 1U);
+            reduced[j] ^= reduced[k] & hit;
+            combos[j] ^= combos[k] & hit;
+        }
+    }
+
+    // flips[b]: info word change that toggles only the b-th least reliable
+    // information position.
+    std::array<uint32_t, N> flips{};
+    for (int r = 0; r < N; ++r) {
+        for (uint32_t m = combos[r]; m; m &= m - 1) {
+            flips[N - 1 - __builtin_ctz(m)] |= 1U << pivots[r];
+        }
+    }
+
+    uint32_t base = 0;
+    for (int k = 0; k < N; ++k) {
+        base ^= flips[N - 1 - k] & (0U - static_cast<uint32_t>(llrs[positions[k]] > 0.0));
+    }
+
+    // Metric of any codeword as four lookups, as in PartialSumDecoder.
+    PartialSumTables tables;
+    build_partial_sums(llrs.data(), tables);
+
+    const auto& codebook = packed_codebook<N>();
+    // Runner-up and soft output only cover the scored patterns; unscored
+    // competitors are replaced by the metric span.
+    CandidateRanking<N> ranking(soft);
+
+    for (uint32_t pattern : patterns_) {
+        uint32_t info = base;
+        for (uint32_t m = pattern; m; m &= m - 1) {
+            info ^= flips[__builtin_ctz(m)];
+        }
+
+        ranking.add(info, partial_sum_score(tables, codebook[info]));
+    }
+
+    return ranking.result(metric_span(llrs));
+}
+
+template class OsdDecoder<2>;
+template class OsdDecoder<4>;
+template class OsdDecoder<6>;
+template class OsdDecoder<8>;
+template class OsdDecoder<11>;
+
+} // namespace qpsk
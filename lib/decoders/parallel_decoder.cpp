@@ -0,0 +1,232 @@
+#include "parallel_decoder.hpp"
+#include "codebook.hpp"
+#include "utils/cpu_affinity.hpp"
+#include "utils/tsc_clock.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+namespace qpsk {
+
+namespace {
+
+// How long a helper spins before it parks, and a waiting caller before it
+// starts yielding; longer than one N=11 scan.
+constexpr double SPIN_NS = 5000.0;
+constexpr int CALIBRATION_ROUNDS = 5;
+constexpr int CALIBRATION_DECODES = 64;
+
+void check_size(const std::vector<double>& llrs) {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/parallel_decoder.cpp: LLR vector must have 20 elements");
+    }
+}
+
+} // namespace
+
+template <int N>
+ParallelDecoder<N>::ParallelDecoder(int helpers, const std::vector<int>& cpus)
+    : codebook_(packed_codebook<N>()), helpers_(std::max(0, std::min(helpers, (1 << N) - 1))),
+      spin_ticks_(static_cast<uint64_t>(SPIN_NS * tsc_ticks_per_ns())) {
+    if (helpers < 0) {
+        throw std::invalid_argument("lib/decoders/parallel_decoder.cpp: helper count must be non-negative");
+    }
+
+    slots_ = std::make_unique<Slot[]>(static_cast<size_t>(helpers_));
+    for (int h = 0; h < helpers_; ++h) {
+        threads_.emplace_back(&ParallelDecoder::helper_loop, this, h, cpus.empty() ? -1 : cpus[h % cpus.size()]);
+    }
+
+    calibrate();
+}
+
+template <int N>
+ParallelDecoder<N>::~ParallelDecoder() {
+    {
+        std::lock_guard<std::mutex> lock(park_mutex_);
+        stop_.store(true);
+    }
+    park_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+template <int N>
+uint32_t ParallelDecoder<N>::slice_begin(int slice) const {
+    return static_cast<uint32_t>((static_cast<uint64_t>(1) << N) * slice / (helpers_ + 1));
+}
+
+template <int N>
+void ParallelDecoder<N>::scan(const PartialSumTables& tables, uint32_t begin, uint32_t end,
+                              double& metric, uint32_t& index) const {
+    double best_metric = -1e300;
+    uint32_t best_index = begin;
+
+    for (uint32_t i = begin; i < end; ++i) {
+        const double m = partial_sum_score(tables, codebook_[i]);
+        if (m > best_metric) {
+            best_metric = m;
+            best_index = i;
+        }
+    }
+
+    metric = best_metric;
+    index = best_index;
+}
+
+template <int N>
+uint64_t ParallelDecoder<N>::wait_for_work(uint64_t seen) const {
+    const uint64_t deadline = read_tsc() + spin_ticks_;
+    while (read_tsc() < deadline) {
+        const uint64_t generation = generation_.load(std::memory_order_acquire);
+        if (generation != seen || stop_.load(std::memory_order_relaxed)) {
+            return generation;
+        }
+        cpu_relax();
+    }
+
+    // generation_ and parked_ are both sequentially consistent, so either the
+    // caller sees this helper parked or the helper sees the new generation.
+    std::unique_lock<std::mutex> lock(park_mutex_);
+    parked_.fetch_add(1);
+    park_cv_.wait(lock, [&] { return generation_.load() != seen || stop_.load(); });
+    parked_.fetch_sub(1);
+    return generation_.load(std::memory_order_acquire);
+}
+
+template <int N>
+void ParallelDecoder<N>::helper_loop(int helper, int cpu) {
+    if (cpu >= 0) {
+        pin_current_thread(cpu);
+    }
+
+    Slot& slot = slots_[helper];
+    uint64_t seen = 0;
+    for (;;) {
+        const uint64_t generation = wait_for_work(seen);
+        if (stop_.load()) {
+            return;
+        }
+        scan(tables_, slice_begin(helper + 1), slice_begin(helper + 2), slot.metric, slot.index);
+        slot.done.store(generation, std::memory_order_release);
+        seen = generation;
+    }
+}
+
+template <int N>
+uint32_t ParallelDecoder<N>::decode_parallel(const std::vector<double>& llrs) const {
+    build_partial_sums(llrs.data(), tables_);
+
+    const uint64_t generation = generation_.load(std::memory_order_relaxed) + 1;
+    generation_.store(generation);
+    if (parked_.load() > 0) {
+        std::lock_guard<std::mutex> lock(park_mutex_);
+        park_cv_.notify_all();
+    }
+
+    double best_metric;
+    uint32_t best_index;
+    scan(tables_, 0, slice_begin(1), best_metric, best_index);
+
+    // Slots hold ascending slices; a strict comparison keeps the lowest index on ties.
+    for (int h = 0; h < helpers_; ++h) {
+        const Slot& slot = slots_[h];
+        const uint64_t deadline = read_tsc() + spin_ticks_;
+        while (slot.done.load(std::memory_order_acquire) != generation) {
+            if (read_tsc() < deadline) {
+                cpu_relax();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        if (slot.metric > best_metric) {
+            best_metric = slot.metric;
+            best_index = slot.index;
+        }
+    }
+
+    return best_index;
+}
+
+template <int N>
+std::bitset<N> ParallelDecoder<N>::decode(const std::vector<double>& llrs, bool parallel) const {
+    check_size(llrs);
+
+    if (parallel && helpers_ > 0 && !busy_.test_and_set(std::memory_order_acquire)) {
+        const uint32_t index = decode_parallel(llrs);
+        busy_.clear(std::memory_order_release);
+        return std::bitset<N>(index);
+    }
+
+    PartialSumTables tables;
+    build_partial_sums(llrs.data(), tables);
+    double metric;
+    uint32_t index;
+    scan(tables, 0, 1U << N, metric, index);
+    return std::bitset<N>(index);
+}
+
+template <int N>
+std::bitset<N> ParallelDecoder<N>::decode(const std::vector<double>& llrs) const {
+    return decode(llrs, parallel_);
+}
+
+template <int N>
+DecodeResult<N> ParallelDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    check_size(llrs);
+
+    PartialSumTables tables;
+    build_partial_sums(llrs.data(), tables);
+
+    CandidateRanking<N> ranking(soft);
+    for (uint32_t i = 0; i < (1U << N); ++i) {
+        ranking.add(i, partial_sum_score(tables, codebook_[i]));
+    }
+    return ranking.result(metric_span(llrs));
+}
+
+template <int N>
+void ParallelDecoder<N>::calibrate() {
+    // Without a free core per helper the caller ends up waiting for helpers
+    // to be scheduled; no need to measure that.
+    if (helpers_ == 0 || allowed_cpus().size() < static_cast<size_t>(helpers_) + 1) {
+        return;
+    }
+
+    std::mt19937 rng(N);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<std::vector<double>> inputs(CALIBRATION_DECODES, std::vector<double>(CODEWORD_SIZE));
+    for (auto& llrs : inputs) {
+        for (auto& llr : llrs) {
+            llr = noise(rng);
+        }
+    }
+
+    // Best of several interleaved rounds, so both paths see the same machine state.
+    auto time_ns = [&](bool parallel) {
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto& llrs : inputs) {
+            decode(llrs, parallel);
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+               CALIBRATION_DECODES;
+    };
+
+    serial_ns_ = 1e300;
+    parallel_ns_ = 1e300;
+    for (int round = 0; round < CALIBRATION_ROUNDS; ++round) {
+        serial_ns_ = std::min(serial_ns_, time_ns(false));
+        parallel_ns_ = std::min(parallel_ns_, time_ns(true));
+    }
+    parallel_ = parallel_ns_ < serial_ns_;
+}
+
+template class ParallelDecoder<2>;
+template class ParallelDecoder<4>;
+template class ParallelDecoder<6>;
+template class ParallelDecoder<8>;
+template class ParallelDecoder<11>;
+
+} // namespace qpsk
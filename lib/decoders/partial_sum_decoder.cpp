@@ -0,0 +1,81 @@
+#include "partial_sum_decoder.hpp"
+#include "codebook.hpp"
+
+namespace qpsk {
+
+namespace {
+
+void check_size(const std::vector<double>& llrs) {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/partial_sum_decoder.cpp: LLR vector must have 20 elements");
+    }
+}
+
+} // namespace
+
+void build_partial_sums(const double* llrs, PartialSumTables& tables) {
+    for (int g = 0; g < PARTIAL_SUM_GROUPS; ++g) {
+        const double* group = llrs + g * PARTIAL_SUM_GROUP_BITS;
+        auto& table = tables[g];
+        table[0] = 0.0;
+        // Subsets containing position b are the ones below 2^b plus that LLR;
+        // the inner loops are independent adds and vectorise.
+        for (int b = 0; b < PARTIAL_SUM_GROUP_BITS; ++b) {
+            const uint32_t half = 1U << b;
+            for (uint32_t m = 0; m < half; ++m) {
+                table[half + m] = table[m] + group[b];
+            }
+        }
+    }
+}
+
+template <int N>
+PartialSumDecoder<N>::PartialSumDecoder() : codebook_(packed_codebook<N>()) {}
+
+template <int N>
+uint32_t PartialSumDecoder<N>::decode_tables(const PartialSumTables& tables) const {
+    double best_metric = -1e300;
+    uint32_t best_word = 0;
+
+    for (uint32_t i = 0; i < (1U << N); ++i) {
+        const double metric = partial_sum_score(tables, codebook_[i]);
+        if (metric > best_metric) {
+            best_metric = metric;
+            best_word = i;
+        }
+    }
+
+    return best_word;
+}
+
+template <int N>
+std::bitset<N> PartialSumDecoder<N>::decode(const std::vector<double>& llrs) const {
+    check_size(llrs);
+
+    PartialSumTables tables;
+    build_partial_sums(llrs.data(), tables);
+    return std::bitset<N>(decode_tables(tables));
+}
+
+template <int N>
+DecodeResult<N> PartialSumDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    check_size(llrs);
+
+    PartialSumTables tables;
+    build_partial_sums(llrs.data(), tables);
+
+    CandidateRanking<N> ranking(soft);
+    for (uint32_t i = 0; i < (1U << N); ++i) {
+        ranking.add(i, partial_sum_score(tables, codebook_[i]));
+    }
+
+    return ranking.result(metric_span(llrs));
+}
+
+template class PartialSumDecoder<2>;
+template class PartialSumDecoder<4>;
+template class PartialSumDecoder<6>;
+template class PartialSumDecoder<8>;
+template class PartialSumDecoder<11>;
+
+} // namespace qpsk
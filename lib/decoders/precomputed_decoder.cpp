@@ -11,16 +11,9 @@ PrecomputedDecoder<N>::PrecomputedDecoder() {
 }
 
 template <int N>
-typename std::bitset<N> PrecomputedDecoder<N>::decode(const std::vector<double>& llrs) const {
-    if (llrs.size() != CODEWORD_SIZE) {
-        throw std::invalid_argument("lib/decoders/precomputed_decoder.cpp: LLR vector must have 20 elements");
-    }
-
-    size_t total = 1ULL << N;
-    double best_metric = -1e300;
-    std::bitset<N> best_word;
-
-    for (size_t i = 0; i < total; ++i) {
+template <typename Sink>
+void PrecomputedDecoder<N>::scan(const std::vector<double>& llrs, Sink& sink) const {
+    for (size_t i = 0; i < (1ULL << N); ++i) {
         const auto& codeword = codewords_[i];
 
         double metric = 0.0;
@@ -30,13 +23,30 @@ typename std::bitset<N> PrecomputedDecoder<N>::decode(const std::vector<double>&
             }
         }
 
-        if (metric > best_metric) {
-            best_metric = metric;
-            best_word = std::bitset<N>(i);
-        }
+        sink.add(static_cast<uint32_t>(i), metric);
+    }
+}
+
+template <int N>
+typename std::bitset<N> PrecomputedDecoder<N>::decode(const std::vector<double>& llrs) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/precomputed_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    BestCandidate<> best;
+    scan(llrs, best);
+    return std::bitset<N>(best.index());
+}
+
+template <int N>
+DecodeResult<N> PrecomputedDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/precomputed_decoder.cpp: LLR vector must have 20 elements");
     }
 
-    return best_word;
+    CandidateRanking<N> ranking(soft);
+    scan(llrs, ranking);
+    return ranking.result(metric_span(llrs));
 }
 
 template class PrecomputedDecoder<2>;
@@ -18,20 +18,12 @@ SimdDecoder<N>::SimdDecoder() {
 }
 
 template <int N>
-std::bitset<N> SimdDecoder<N>::decode(const std::vector<double>& llrs) const {
-    if (llrs.size() != CODEWORD_SIZE) {
-        throw std::invalid_argument("lib/decoders/simd_decoder.cpp: LLR vector must have 20 elements");
-    }
-
-    size_t total = 1ULL << N;
-    double best_metric = -1e300;
-    std::bitset<N> best_word;
-
-    __m256d sum;
+template <typename Sink>
+void SimdDecoder<N>::scan(const std::vector<double>& llrs, Sink& sink) const {
     const double* llr_data = llrs.data();
 
-    for (size_t i = 0; i < total; ++i) {
-        sum = _mm256_setzero_pd();
+    for (size_t i = 0; i < (1ULL << N); ++i) {
+        __m256d sum = _mm256_setzero_pd();
 
         for (size_t j = 0; j < CODEWORD_SIZE; j += 4) {
             __m256d llr_vec = _mm256_loadu_pd(llr_data + j);
@@ -41,16 +33,30 @@ std::bitset<N> SimdDecoder<N>::decode(const std::vector<double>& llrs) const {
 
         double metric_array[4];
         _mm256_storeu_pd(metric_array, sum);
-        double metric = metric_array[0] + metric_array[1] + 
-                        metric_array[2] + metric_array[3];
+        sink.add(static_cast<uint32_t>(i), metric_array[0] + metric_array[1] + metric_array[2] + metric_array[3]);
+    }
+}
 
-        if (metric > best_metric) {
-            best_metric = metric;
-            best_word = std::bitset<N>(i);
-        }
+template <int N>
+std::bitset<N> SimdDecoder<N>::decode(const std::vector<double>& llrs) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/simd_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    BestCandidate<> best;
+    scan(llrs, best);
+    return std::bitset<N>(best.index());
+}
+
+template <int N>
+DecodeResult<N> SimdDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/simd_decoder.cpp: LLR vector must have 20 elements");
     }
 
-    return best_word;
+    CandidateRanking<N> ranking(soft);
+    scan(llrs, ranking);
+    return ranking.result(metric_span(llrs));
 }
 
 template class SimdDecoder<2>;
@@ -0,0 +1,126 @@
+#include "simd_fixed_point_decoder.hpp"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+
+namespace qpsk {
+
+namespace {
+
+// Metrics of the 16 candidates of one mask block.
+inline __m256i score_block(const __m256i* llr_vecs,
+                           const std::array<std::array<int16_t, INT16_LANES>, CODEWORD_SIZE>& block) {
+    __m256i acc = _mm256_setzero_si256();
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(block[j].data()));
+        acc = _mm256_adds_epi16(acc, _mm256_and_si256(llr_vecs[j], mask));
+    }
+    return acc;
+}
+
+} // namespace
+
+template <int N>
+SimdFixedPointDecoder<N>::SimdFixedPointDecoder(int bits, double scale) : bits_(bits), scale_(scale) {
+    BlockEncoder<N> encoder;
+
+    // Padding lanes keep an all-zero mask: their metric is 0, the same as
+    // candidate 0, which wins the tie because it has the lower index.
+    for (auto& block : masks_) {
+        for (auto& lanes : block) {
+            lanes.fill(0);
+        }
+    }
+
+    for (size_t i = 0; i < (1ULL << N); ++i) {
+        auto codeword = encoder.encode(std::bitset<N>(i));
+
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            masks_[i / INT16_LANES][j][i % INT16_LANES] = codeword[j] ? -1 : 0;
+        }
+    }
+}
+
+template <int N>
+void SimdFixedPointDecoder<N>::score(const std::vector<int8_t>& llrs, int16_t* metrics) const {
+    __m256i llr_vecs[CODEWORD_SIZE];
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        llr_vecs[j] = _mm256_set1_epi16(llrs[j]);
+    }
+
+    for (size_t b = 0; b < BLOCKS; ++b) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(metrics + b * INT16_LANES), score_block(llr_vecs, masks_[b]));
+    }
+}
+
+template <int N>
+std::bitset<N> SimdFixedPointDecoder<N>::decode(const std::vector<double>& llrs) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/simd_fixed_point_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    return decode_quantized(quantize_llrs(llrs, bits_, scale_));
+}
+
+template <int N>
+std::bitset<N> SimdFixedPointDecoder<N>::decode_quantized(const std::vector<int8_t>& llrs) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/simd_fixed_point_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    alignas(32) int16_t metrics[BLOCKS * INT16_LANES];
+    score(llrs, metrics);
+
+    __m256i best = _mm256_set1_epi16(INT16_MIN);
+    for (size_t b = 0; b < BLOCKS; ++b) {
+        best = _mm256_max_epi16(best, _mm256_load_si256(reinterpret_cast<const __m256i*>(metrics + b * INT16_LANES)));
+    }
+
+    __m128i best128 = _mm_max_epi16(_mm256_castsi256_si128(best), _mm256_extracti128_si256(best, 1));
+    best128 = _mm_max_epi16(best128, _mm_shuffle_epi32(best128, _MM_SHUFFLE(1, 0, 3, 2)));
+    best128 = _mm_max_epi16(best128, _mm_shuffle_epi32(best128, _MM_SHUFFLE(2, 3, 0, 1)));
+    best128 = _mm_max_epi16(best128, _mm_shufflelo_epi16(_mm_shufflehi_epi16(best128, _MM_SHUFFLE(2, 3, 0, 1)),
+                                                         _MM_SHUFFLE(2, 3, 0, 1)));
+    const __m256i best_vec = _mm256_broadcastw_epi16(best128);
+
+    for (size_t b = 0; b < BLOCKS; ++b) {
+        __m256i acc = _mm256_load_si256(reinterpret_cast<const __m256i*>(metrics + b * INT16_LANES));
+        uint32_t hits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(acc, best_vec)));
+        if (hits != 0) {
+            return std::bitset<N>(b * INT16_LANES + __builtin_ctz(hits) / 2);
+        }
+    }
+
+    return std::bitset<N>();
+}
+
+template <int N>
+DecodeResult<N> SimdFixedPointDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/simd_fixed_point_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    double scale = 0.0;
+    const auto quantized = quantize_llrs(llrs, bits_, scale_, &scale);
+
+    alignas(32) int16_t metrics[BLOCKS * INT16_LANES];
+    score(quantized, metrics);
+
+    // Padding lanes are skipped, so they cannot pose as the runner-up.
+    CandidateRanking<N> ranking(soft);
+    for (size_t i = 0; i < (1ULL << N); ++i) {
+        ranking.add(static_cast<uint32_t>(i), metrics[i] / scale);
+    }
+
+    return ranking.result(metric_span(llrs));
+}
+
+template class SimdFixedPointDecoder<2>;
+template class SimdFixedPointDecoder<4>;
+template class SimdFixedPointDecoder<6>;
+template class SimdFixedPointDecoder<8>;
+template class SimdFixedPointDecoder<11>;
+
+} // namespace qpsk
+
+#endif
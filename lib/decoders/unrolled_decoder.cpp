@@ -0,0 +1,40 @@
+#include "unrolled_decoder.hpp"
+
+namespace qpsk {
+
+template <int N>
+std::bitset<N> UnrolledDecoder<N>::decode(const std::vector<double>& llrs) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/unrolled_decoder.cpp: LLR vector must have 20 elements");
+    }
+    return std::bitset<N>(unrolled_decode<N>(llrs.data()));
+}
+
+template <int N>
+DecodeResult<N> UnrolledDecoder<N>::decode_full(const std::vector<double>& llrs, bool soft) const {
+    if (llrs.size() != CODEWORD_SIZE) {
+        throw std::invalid_argument("lib/decoders/unrolled_decoder.cpp: LLR vector must have 20 elements");
+    }
+
+    std::array<double, 1U << N> h;
+    unrolled_correlations<N>(llrs.data(), h);
+
+    double sum = 0.0;
+    for (double llr : llrs) {
+        sum += llr;
+    }
+
+    CandidateRanking<N> ranking(soft);
+    for (uint32_t w = 0; w < h.size(); ++w) {
+        ranking.add(w, 0.5 * (sum + h[w]));
+    }
+    return ranking.result(metric_span(llrs));
+}
+
+template class UnrolledDecoder<2>;
+template class UnrolledDecoder<4>;
+template class UnrolledDecoder<6>;
+template class UnrolledDecoder<8>;
+template class UnrolledDecoder<11>;
+
+} // namespace qpsk
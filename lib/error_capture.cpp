@@ -0,0 +1,140 @@
+#include "error_capture.hpp"
+#include "codebook.hpp"
+#include "utils/file_utils.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace qpsk {
+
+namespace {
+
+constexpr char MAGIC[8] = {'Q', 'P', 'S', 'K', 'E', 'V', 'T', '1'};
+constexpr uint32_t VERSION = 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t failures_seen;
+    uint64_t successes_sampled;
+    uint64_t record_count;
+};
+
+static_assert(sizeof(FileHeader) == 40, "FileHeader layout is part of the capture file format");
+
+} // namespace
+
+ErrorCapture::ErrorCapture(const CaptureConfig& config)
+    : failures_(config.failures), successes_(config.successes),
+      period_(std::max(1LL, config.sample_period)), countdown_(period_) {}
+
+template <int N>
+void ErrorCapture::record(uint64_t trial, double snr_db, const std::bitset<N>& tx_bits,
+                          const std::bitset<N>& rx_bits, const std::vector<double>& llrs) {
+    TrialRecord r;
+    r.trial = trial;
+    r.tx_bits = static_cast<uint32_t>(tx_bits.to_ulong());
+    r.rx_bits = static_cast<uint32_t>(rx_bits.to_ulong());
+    r.snr_db = static_cast<float>(snr_db);
+    r.n = static_cast<uint8_t>(N);
+    r.failed = tx_bits != rx_bits;
+
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        r.rx[j] = static_cast<float>(llrs[j]);
+    }
+
+    // Captured trials are rare, so a full rescan of the codebook is cheaper
+    // than threading metrics out of every decoder.
+    double best = -1e300;
+    double runner_up = -1e300;
+    const auto& codebook = packed_codebook<N>();
+    for (size_t i = 0; i < codebook.size(); ++i) {
+        double metric = 0.0;
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            if ((codebook[i] >> j) & 1U) {
+                metric += llrs[j];
+            }
+        }
+        if (metric > best) {
+            runner_up = best;
+            r.runner_up_index = r.best_index;
+            best = metric;
+            r.best_index = static_cast<uint32_t>(i);
+        } else if (metric > runner_up) {
+            runner_up = metric;
+            r.runner_up_index = static_cast<uint32_t>(i);
+        }
+    }
+    r.best_metric = static_cast<float>(best);
+    r.runner_up_metric = static_cast<float>(runner_up);
+
+    (r.failed ? failures_ : successes_).push(r);
+}
+
+CaptureDump ErrorCapture::dump() const {
+    CaptureDump dump;
+    dump.failures_seen = failures_.pushed();
+    dump.successes_sampled = successes_.pushed();
+    dump.records = failures_.snapshot();
+
+    const auto samples = successes_.snapshot();
+    dump.records.insert(dump.records.end(), samples.begin(), samples.end());
+    return dump;
+}
+
+void write_capture(const std::string& path, const CaptureDump& dump) {
+    FileHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.record_size = sizeof(TrialRecord);
+    header.failures_seen = dump.failures_seen;
+    header.successes_sampled = dump.successes_sampled;
+    header.record_count = dump.records.size();
+
+    std::string content(sizeof(header) + dump.records.size() * sizeof(TrialRecord), '\0');
+    std::memcpy(content.data(), &header, sizeof(header));
+    if (!dump.records.empty()) {
+        std::memcpy(content.data() + sizeof(header), dump.records.data(),
+                    dump.records.size() * sizeof(TrialRecord));
+    }
+
+    write_file_atomic(path, content);
+}
+
+CaptureDump read_capture(const std::string& path) {
+    const std::string content = read_file(path);
+
+    FileHeader header;
+    if (content.size() < sizeof(header)) {
+        throw std::invalid_argument("lib/error_capture.cpp: truncated capture file " + path);
+    }
+    std::memcpy(&header, content.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.record_size != sizeof(TrialRecord)) {
+        throw std::invalid_argument("lib/error_capture.cpp: unsupported capture file " + path);
+    }
+    if (content.size() != sizeof(header) + header.record_count * sizeof(TrialRecord)) {
+        throw std::invalid_argument("lib/error_capture.cpp: truncated capture file " + path);
+    }
+
+    CaptureDump dump;
+    dump.failures_seen = header.failures_seen;
+    dump.successes_sampled = header.successes_sampled;
+    dump.records.resize(header.record_count);
+    if (header.record_count > 0) {
+        std::memcpy(dump.records.data(), content.data() + sizeof(header),
+                    header.record_count * sizeof(TrialRecord));
+    }
+    return dump;
+}
+
+template void ErrorCapture::record<2>(uint64_t, double, const std::bitset<2>&, const std::bitset<2>&, const std::vector<double>&);
+template void ErrorCapture::record<4>(uint64_t, double, const std::bitset<4>&, const std::bitset<4>&, const std::vector<double>&);
+template void ErrorCapture::record<6>(uint64_t, double, const std::bitset<6>&, const std::bitset<6>&, const std::vector<double>&);
+template void ErrorCapture::record<8>(uint64_t, double, const std::bitset<8>&, const std::bitset<8>&, const std::vector<double>&);
+template void ErrorCapture::record<11>(uint64_t, double, const std::bitset<11>&, const std::bitset<11>&, const std::vector<double>&);
+
+} // namespace qpsk
@@ -2,6 +2,8 @@
 #include "encoder.hpp"
 #include "qpsk.hpp"
 #include "json_helpers.hpp"
+#include "random_bits.hpp"
+#include "waveform.hpp"
 
 #include <iostream>
 
@@ -85,4 +87,60 @@ int run_coding_mode(const json& input, json& output) {
     return 0;
 }
 
+int run_bulk_coding_mode(const json& input, json& output) {
+    if (!input.contains("num_of_pucch_f2_bits") || !input.contains("file") ||
+        (!input.contains("messages_file") && !input.contains("iterations"))) {
+        std::cerr << "Error: missing fields for bulk coding\n";
+        return 1;
+    }
+    if (input.contains("iterations") &&
+        (!input["iterations"].is_number_integer() || input["iterations"].get<long long>() < 0)) {
+        std::cerr << "Error: 'iterations' must be non-negative integer\n";
+        return 1;
+    }
+
+    WaveformConfig config;
+    const std::string file = input["file"];
+    try {
+        config.n = input["num_of_pucch_f2_bits"];
+        config.format = parse_iq_format(input.value("format", "cf32"));
+        config.messages_file = input.value("messages_file", "");
+        config.count = input.value("iterations", 0LL);
+        config.seed = input.contains("seed") ? input["seed"].get<uint64_t>() : random_seed();
+        config.save_messages = input.value("save_messages", "");
+        if (input.contains("snr_db")) {
+            config.snr_db = input["snr_db"].get<double>();
+        }
+        config.ci16_scale = input.value("ci16_scale", config.ci16_scale);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    WaveformResult result;
+    try {
+        result = write_waveform(file, config);
+    } catch (const std::exception& e) {
+        std::cerr << "Error during bulk coding: " << e.what() << "\n";
+        return 1;
+    }
+
+    output["mode"] = "bulk coding";
+    output["num_of_pucch_f2_bits"] = config.n;
+    output["format"] = iq_format_name(config.format);
+    output["file"] = file;
+    output["messages"] = result.messages;
+    output["samples"] = result.messages * static_cast<long long>(QPSK_SYMBOLS_COUNT);
+    output["bytes"] = result.bytes;
+    if (config.messages_file.empty()) {
+        output["seed"] = config.seed;
+    }
+    if (config.snr_db) {
+        output["snr_db"] = *config.snr_db;
+    }
+    output["seconds"] = result.seconds;
+    output["gb_per_s"] = result.seconds > 0.0 ? static_cast<double>(result.bytes) / result.seconds / 1e9 : 0.0;
+    return 0;
+}
+
 } // namespace qpsk
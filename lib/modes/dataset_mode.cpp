@@ -0,0 +1,127 @@
+#include "system.hpp"
+#include "dataset.hpp"
+#include "random_bits.hpp"
+#include "decoder_registry.hpp"
+
+#include <iostream>
+
+namespace qpsk {
+
+int run_dataset_capture_mode(const json& input, json& output) {
+    if (!input.contains("num_of_pucch_f2_bits") || !input.contains("iterations") || !input.contains("file")) {
+        std::cerr << "Error: missing fields for dataset capture\n";
+        return 1;
+    }
+    if (!input["iterations"].is_number_integer() || input["iterations"].get<long long>() <= 0) {
+        std::cerr << "Error: 'iterations' must be positive integer\n";
+        return 1;
+    }
+
+    DatasetConfig config;
+    config.n = input["num_of_pucch_f2_bits"];
+    config.snr_db = input.value("snr_db", 10.0);
+    config.count = input["iterations"];
+    config.seed = input.contains("seed") ? input["seed"].get<uint64_t>() : random_seed();
+    const std::string file = input["file"];
+
+    size_t bytes = 0;
+    try {
+        bytes = write_dataset(file, config);
+    } catch (const std::exception& e) {
+        std::cerr << "Dataset error: " << e.what() << "\n";
+        return 1;
+    }
+
+    output["mode"] = "dataset capture";
+    output["num_of_pucch_f2_bits"] = config.n;
+    output["snr_db"] = config.snr_db;
+    output["seed"] = config.seed;
+    output["file"] = file;
+    output["records"] = config.count;
+    output["bytes"] = bytes;
+    return 0;
+}
+
+int run_dataset_replay_mode(const json& input, json& output) {
+    if (!input.contains("file")) {
+        std::cerr << "Error: missing fields for dataset replay\n";
+        return 1;
+    }
+
+    std::vector<std::string> decoders;
+    if (input.contains("decoders")) {
+        if (!input["decoders"].is_array() || input["decoders"].empty()) {
+            std::cerr << "Error: 'decoders' must be non-empty array of decoder names\n";
+            return 1;
+        }
+        for (const auto& name : input["decoders"]) {
+            if (!name.is_string() || !is_registered_decoder(name.get<std::string>())) {
+                std::cerr << "Error: unknown decoder " << name.dump() << "\n";
+                return 1;
+            }
+            decoders.push_back(name.get<std::string>());
+        }
+    } else {
+        for (const auto& info : registered_decoders()) {
+            decoders.push_back(info.name);
+        }
+    }
+
+    DecoderOptions options;
+    if (input.contains("decoder_budget")) {
+        if (!input["decoder_budget"].is_number_integer() || input["decoder_budget"].get<int>() <= 0) {
+            std::cerr << "Error: 'decoder_budget' must be positive integer\n";
+            return 1;
+        }
+        options.budget = input["decoder_budget"];
+    }
+
+    const std::string file = input["file"];
+    int n = 0;
+    double snr_db = 0.0;
+    ReplayResult result;
+
+    try {
+        const Dataset dataset(file);
+        n = dataset.n();
+        snr_db = dataset.snr_db();
+        result = replay_dataset(dataset, decoders, options);
+    } catch (const std::exception& e) {
+        std::cerr << "Dataset error: " << e.what() << "\n";
+        return 1;
+    }
+
+    const double records = static_cast<double>(result.records);
+
+    output["mode"] = "dataset replay";
+    output["num_of_pucch_f2_bits"] = n;
+    output["snr_db"] = snr_db;
+    output["records"] = result.records;
+
+    json per_decoder = json::array();
+    for (const auto& decoder : result.decoders) {
+        json entry;
+        entry["decoder"] = decoder.name;
+        entry["bler"] = records > 0 ? decoder.failed / records : 0.0;
+        entry["failed"] = decoder.failed;
+        entry["decode_ns"] = records > 0 ? decoder.decode_ns / records : 0.0;
+        entry["decodes_per_second"] = decoder.decode_ns > 0.0 ? records / decoder.decode_ns * 1e9 : 0.0;
+        per_decoder.push_back(entry);
+    }
+    output["decoders"] = per_decoder;
+
+    json disagreements = json::array();
+    for (size_t a = 0; a < decoders.size(); ++a) {
+        for (size_t b = a + 1; b < decoders.size(); ++b) {
+            json entry;
+            entry["decoders"] = {decoders[a], decoders[b]};
+            entry["count"] = result.disagreements[a][b];
+            disagreements.push_back(entry);
+        }
+    }
+    output["disagreements"] = disagreements;
+    output["any_disagreement"] = result.any_disagreement;
+    return 0;
+}
+
+} // namespace qpsk
@@ -1,17 +1,84 @@
 #include "system.hpp"
 #include "qpsk.hpp"
 #include "json_helpers.hpp"
-#include "precomputed_decoder.hpp"
+#include "decoder_registry.hpp"
+#include "decoder_tuner.hpp"
+#include "batch_scheduler.hpp"
+#include "blind_detector.hpp"
+#include "known_bits_decoder.hpp"
 
 #include <iostream>
+#include <optional>
 
 namespace qpsk {
 
+json bits_json(uint32_t word, int n) {
+    json bits = json::array();
+    for (int i = 0; i < n; ++i) {
+        bits.push_back((word >> i) & 1U);
+    }
+    return bits;
+}
+
+// Payload size unknown: one scan decides every size in "blind_sizes".
+void process_blind_decoding(const json& input, const std::vector<double>& llrs, json& output) {
+    const BlindDetector detector(input["blind_sizes"].get<std::vector<int>>(),
+                                 input.value("blind_margin", BlindDetector::DEFAULT_MARGIN));
+    const BlindDetection detection = detector.detect(llrs);
+
+    json hypotheses = json::array();
+    for (const auto& h : detection.sizes) {
+        json entry;
+        entry["num_of_pucch_f2_bits"] = h.n;
+        entry["pucch_f2_bits"] = bits_json(h.bits, h.n);
+        entry["best_metric"] = h.best_metric;
+        entry["second_metric"] = h.second_metric;
+        entry["correlation"] = h.correlation;
+        hypotheses.push_back(entry);
+    }
+
+    output["mode"] = "decoding";
+    output["num_of_pucch_f2_bits"] = detection.decision().n;
+    output["pucch_f2_bits"] = bits_json(detection.decision().bits, detection.decision().n);
+    output["blind_detection"] = hypotheses;
+}
+
+// Per-request extras of a single-report decode.
+struct DecodeSettings {
+    std::optional<double> dtx_threshold;
+    bool soft = false;
+    KnownBits known;
+};
+
 template<int N>
-json process_decoding(const std::vector<double>& llrs) {
-    PrecomputedDecoder<N> decoder;
+json process_decoding(const std::vector<double>& llrs, const std::string& decoder_name,
+                      const DecoderOptions& options, const DecodeSettings& settings) {
+    std::unique_ptr<KnownBitsDecoder<N>> subcode;
+    if (!settings.known.empty()) {
+        subcode = std::make_unique<KnownBitsDecoder<N>>(settings.known);
+    }
+    const AbstractDecoder<N>& decoder = subcode ? *subcode : shared_decoder<N>(decoder_name, options);
+
+    json result;
+    std::bitset<N> decoded;
 
-    auto decoded = decoder.decode(llrs);
+    if (settings.dtx_threshold || settings.soft) {
+        const auto full = decoder.decode_full(llrs, settings.soft);
+        decoded = full.bits;
+
+        const double correlation = normalized_correlation(full.best_metric, llrs);
+        result["best_metric"] = full.best_metric;
+        result["second_metric"] = full.second_metric;
+        result["correlation"] = correlation;
+        if (settings.dtx_threshold) {
+            result["dtx"] = correlation < *settings.dtx_threshold;
+        }
+        if (settings.soft) {
+            result["soft_bits"] = full.soft;
+        }
+    } else {
+        decoded = decoder.decode(llrs);
+    }
 
     json bits_array = json::array();
 
@@ -19,18 +86,137 @@ json process_decoding(const std::vector<double>& llrs) {
         bits_array.push_back(decoded[i] ? 1 : 0);
     }
 
-    return bits_array;
+    result["pucch_f2_bits"] = bits_array;
+    return result;
+}
+
+// "reports": [{"num_of_pucch_f2_bits": n, "qpsk_symbols": [...]}, ...] decoded
+// together through BatchScheduler on "threads" workers.
+int run_report_batch(const json& input, json& output, const std::string& decoder_name,
+                     const DecoderOptions& options) {
+    const auto& reports = input["reports"];
+    if (!reports.is_array()) {
+        std::cerr << "Error: 'reports' must be array of objects\n";
+        return 1;
+    }
+
+    const int threads = input.value("threads", 1);
+    if (threads <= 0) {
+        std::cerr << "Error: 'threads' must be positive integer\n";
+        return 1;
+    }
+
+    QPSK mod;
+    std::vector<DecodeRequest> requests;
+    try {
+        for (const auto& report : reports) {
+            if (!report.is_object() || !report.contains("num_of_pucch_f2_bits") || !report.contains("qpsk_symbols") ||
+                !report["qpsk_symbols"].is_array() ||
+                report["qpsk_symbols"].size() != qpsk::CODEWORD_SIZE / qpsk::QPSK_STD_SYMBOL_SIZE) {
+                std::cerr << "Error: each report needs 'num_of_pucch_f2_bits' and 10 'qpsk_symbols'\n";
+                return 1;
+            }
+
+            std::vector<Complex> symbols;
+            for (const auto& s_val : report["qpsk_symbols"]) {
+                symbols.push_back(parse_complex(s_val.get<std::string>()));
+            }
+            requests.push_back({report["num_of_pucch_f2_bits"].get<int>(), mod.demodulate(symbols)});
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error parsing symbol: " << e.what() << "\n";
+        return 1;
+    }
+
+    try {
+        BatchScheduler scheduler(static_cast<size_t>(threads), decoder_name, options);
+        const auto decoded = scheduler.decode(requests);
+
+        json results = json::array();
+        for (size_t i = 0; i < requests.size(); ++i) {
+            json bits_array = json::array();
+            for (int b = 0; b < requests[i].n; ++b) {
+                bits_array.push_back((decoded[i] >> b) & 1U);
+            }
+            results.push_back({{"num_of_pucch_f2_bits", requests[i].n}, {"pucch_f2_bits", bits_array}});
+        }
+
+        output["mode"] = "decoding";
+        output["reports"] = results;
+    } catch (const std::exception& e) {
+        std::cerr << "Error during decoding: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
 }
 
 int run_decoding_mode(const json& input, json& output) {
-    if (!input.contains("num_of_pucch_f2_bits") || !input.contains("qpsk_symbols")) {
+    const std::string decoder_name = input.value("decoder", "");
+
+    if (!decoder_name.empty() && !is_registered_decoder(decoder_name)) {
+        std::cerr << "Error: unknown decoder '" << decoder_name << "'\n";
+        return 1;
+    }
+
+    DecoderOptions options;
+    if (input.contains("decoder_budget")) {
+        if (!input["decoder_budget"].is_number_integer() || input["decoder_budget"].get<int>() <= 0) {
+            std::cerr << "Error: 'decoder_budget' must be positive integer\n";
+            return 1;
+        }
+        options.budget = input["decoder_budget"];
+    }
+
+    if (input.contains("decoder_helpers")) {
+        if (!input["decoder_helpers"].is_number_integer() || input["decoder_helpers"].get<int>() <= 0) {
+            std::cerr << "Error: 'decoder_helpers' must be positive integer\n";
+            return 1;
+        }
+        options.helpers = input["decoder_helpers"];
+    }
+    options.helper_cpus = input.value("helper_cpus", options.helper_cpus);
+
+    if (input.contains("reports")) {
+        return run_report_batch(input, output, decoder_name, options);
+    }
+
+    const bool blind = input.contains("blind_sizes");
+    if ((!blind && !input.contains("num_of_pucch_f2_bits")) || !input.contains("qpsk_symbols")) {
         std::cerr << "Error: missing 'num_of_pucch_f2_bits' or 'qpsk_symbols'\n";
         return 1;
     }
 
-    const int n = input["num_of_pucch_f2_bits"];
+    const int n = blind ? 0 : input["num_of_pucch_f2_bits"].get<int>();
     const auto sym_json = input["qpsk_symbols"];
 
+    DecodeSettings settings;
+    if (input.contains("dtx_threshold")) {
+        if (!input["dtx_threshold"].is_number()) {
+            std::cerr << "Error: 'dtx_threshold' must be number\n";
+            return 1;
+        }
+        settings.dtx_threshold = input["dtx_threshold"].get<double>();
+    }
+    settings.soft = input.value("soft_output", false);
+    if (input.contains("known_bits")) {
+        // The known bits pick both N and the decoder (KnownBitsDecoder).
+        if (blind) {
+            std::cerr << "Error: 'known_bits' cannot be combined with 'blind_sizes'\n";
+            return 1;
+        }
+        if (!decoder_name.empty()) {
+            std::cerr << "Error: 'known_bits' decodes with the known-bits subcode; 'decoder' is not used\n";
+            return 1;
+        }
+        try {
+            settings.known = parse_known_bits(input["known_bits"], n);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: invalid 'known_bits': " << e.what() << "\n";
+            return 1;
+        }
+    }
+
     if (!sym_json.is_array() || 
          sym_json.size() != qpsk::CODEWORD_SIZE / qpsk::QPSK_STD_SYMBOL_SIZE) {
         std::cerr << "Error: qpsk_symbols must be array of 10 strings like 'a+bj'\n";
@@ -56,21 +242,32 @@ int run_decoding_mode(const json& input, json& output) {
         QPSK mod;
         auto llrs = mod.demodulate(symbols);
 
-        json bits_array;
+        if (blind) {
+            process_blind_decoding(input, llrs, output);
+            return 0;
+        }
+
+        json decoded;
+        const std::string name = decoder_name.empty() ? select_decoder(n) : decoder_name;
 
         switch (n) {
-            case 2:  bits_array = process_decoding<2>(llrs); break;
-            case 4:  bits_array = process_decoding<4>(llrs); break;
-            case 6:  bits_array = process_decoding<6>(llrs); break;
-            case 8:  bits_array = process_decoding<8>(llrs); break;
-            case 11: bits_array = process_decoding<11>(llrs); break;
+            case 2:  decoded = process_decoding<2>(llrs, name, options, settings); break;
+            case 4:  decoded = process_decoding<4>(llrs, name, options, settings); break;
+            case 6:  decoded = process_decoding<6>(llrs, name, options, settings); break;
+            case 8:  decoded = process_decoding<8>(llrs, name, options, settings); break;
+            case 11: decoded = process_decoding<11>(llrs, name, options, settings); break;
             default:
                 throw std::invalid_argument("lib/modes/decoding_mode.cpp: invalid num_of_pucch_f2_bits");
         }
 
         output["mode"] = "decoding";
         output["num_of_pucch_f2_bits"] = n;
-        output["pucch_f2_bits"] = bits_array;
+        output["pucch_f2_bits"] = decoded["pucch_f2_bits"];
+        for (const auto& field : {"best_metric", "second_metric", "correlation", "dtx", "soft_bits"}) {
+            if (decoded.contains(field)) {
+                output[field] = decoded[field];
+            }
+        }
     } catch (const std::exception& e) {
         std::cerr << "Error during decoding: " << e.what() << "\n";
         return 1;
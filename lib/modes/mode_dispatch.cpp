@@ -0,0 +1,42 @@
+#include "system.hpp"
+
+#include <iostream>
+
+namespace qpsk {
+
+int run_mode(const json& input, json& output) {
+    const std::string mode = input.value("mode", "");
+
+    if (mode == "coding") {
+        return run_coding_mode(input, output);
+    } else if (mode == "bulk coding") {
+        return run_bulk_coding_mode(input, output);
+    } else if (mode == "decoding") {
+        return run_decoding_mode(input, output);
+    } else if (mode == "channel simulation") {
+        return run_simulation_mode(input, output);
+    } else if (mode == "sharded simulation") {
+        return run_sharded_simulation_mode(input, output);
+    } else if (mode == "shard worker") {
+        return run_shard_worker_mode(input, output);
+    } else if (mode == "shard merge") {
+        return run_shard_merge_mode(input, output);
+    } else if (mode == "tune") {
+        return run_tune_mode(input, output);
+    } else if (mode == "snr search") {
+        return run_snr_search_mode(input, output);
+    } else if (mode == "union bound") {
+        return run_union_bound_mode(input, output);
+    } else if (mode == "realtime") {
+        return run_realtime_mode(input, output);
+    } else if (mode == "dataset capture") {
+        return run_dataset_capture_mode(input, output);
+    } else if (mode == "dataset replay") {
+        return run_dataset_replay_mode(input, output);
+    }
+
+    std::cerr << "Invalid mode\n";
+    return 1;
+}
+
+} // namespace qpsk
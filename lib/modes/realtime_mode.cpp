@@ -0,0 +1,151 @@
+#include "system.hpp"
+#include "realtime.hpp"
+#include "random_bits.hpp"
+#include "decoder_registry.hpp"
+
+#include <iostream>
+#include <sstream>
+
+namespace qpsk {
+
+namespace {
+
+json summary_us(const LatencyHistogram& h, const std::vector<double>& percentiles) {
+    json summary;
+    summary["count"] = h.count();
+    if (h.count() == 0) {
+        return summary;
+    }
+    summary["min"] = h.min() / 1e3;
+    for (double p : percentiles) {
+        std::ostringstream key;
+        key << "p" << p;
+        summary[key.str()] = h.percentile(p) / 1e3;
+    }
+    summary["max"] = h.max() / 1e3;
+    return summary;
+}
+
+json buckets_us(const LatencyHistogram& h) {
+    json buckets = json::array();
+    for (size_t i = 0; i < LatencyHistogram::BUCKETS; ++i) {
+        if (h.bucket_count(i) > 0) {
+            buckets.push_back({{"upper_us", LatencyHistogram::bucket_upper(i) / 1e3}, {"count", h.bucket_count(i)}});
+        }
+    }
+    return buckets;
+}
+
+} // namespace
+
+int run_realtime_mode(const json& input, json& output) {
+    if (!input.contains("num_of_pucch_f2_bits") || !input.contains("reports_per_tti")) {
+        std::cerr << "Error: missing fields for realtime\n";
+        return 1;
+    }
+
+    RealtimeConfig config;
+    if (input["num_of_pucch_f2_bits"].is_array()) {
+        config.sizes = input["num_of_pucch_f2_bits"].get<std::vector<int>>();
+    } else {
+        config.sizes.push_back(input["num_of_pucch_f2_bits"].get<int>());
+    }
+
+    const double tti_us = input.value("tti_us", 1000.0);
+    if (tti_us <= 0.0) {
+        std::cerr << "Error: 'tti_us' must be positive\n";
+        return 1;
+    }
+    config.tti_ns = static_cast<int64_t>(tti_us * 1e3);
+
+    if (!input["reports_per_tti"].is_number_integer() || input["reports_per_tti"].get<int>() <= 0) {
+        std::cerr << "Error: 'reports_per_tti' must be positive integer\n";
+        return 1;
+    }
+    config.reports_per_tti = input["reports_per_tti"];
+    config.snr_db = input.value("snr_db", config.snr_db);
+    config.ttis = input.value("ttis", config.ttis);
+    config.workers = input.value("workers", config.workers);
+    config.pin = input.value("pin", config.pin);
+    config.cpus = input.value("cpus", config.cpus);
+    config.fifo_priority = input.value("sched_fifo_priority", config.fifo_priority);
+    config.lock_memory = input.value("lock_memory", config.lock_memory);
+    config.seed = input.contains("seed") ? input["seed"].get<uint64_t>() : random_seed();
+    config.decoder = input.value("decoder", "");
+
+    if (input.contains("decoder_budget")) {
+        if (!input["decoder_budget"].is_number_integer() || input["decoder_budget"].get<int>() <= 0) {
+            std::cerr << "Error: 'decoder_budget' must be positive integer\n";
+            return 1;
+        }
+        config.decoder_options.budget = input["decoder_budget"];
+    }
+
+    if (!config.decoder.empty() && !is_registered_decoder(config.decoder)) {
+        std::cerr << "Error: unknown decoder '" << config.decoder << "'\n";
+        return 1;
+    }
+
+    const bool find_max = input.value("find_max_reports", false);
+    const double max_miss_rate = input.value("max_miss_rate", 0.0);
+    const int max_reports_limit = input.value("max_reports_limit", 4096);
+
+    RealtimeResult result;
+    RealtimeCapacity capacity;
+    try {
+        result = run_realtime(config);
+        if (find_max) {
+            RealtimeConfig probe = config;
+            probe.ttis = input.value("probe_ttis", std::min<long long>(config.ttis, 500));
+            capacity = find_max_reports_per_tti(probe, max_miss_rate, max_reports_limit);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Realtime error: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (config.lock_memory && !result.memory_locked) {
+        std::cerr << "Warning: mlock failed, buffers are not locked in memory\n";
+    }
+    if (config.pin && !result.pinned) {
+        std::cerr << "Warning: could not pin workers to CPUs\n";
+    }
+    if (config.fifo_priority > 0 && !result.fifo) {
+        std::cerr << "Warning: SCHED_FIFO not permitted, workers run under the default policy\n";
+    }
+
+    output["mode"] = "realtime";
+    output["num_of_pucch_f2_bits"] = config.sizes;
+    output["tti_us"] = tti_us;
+    output["reports_per_tti"] = config.reports_per_tti;
+    output["workers"] = config.workers;
+    output["ttis"] = result.ttis;
+    output["reports"] = result.reports;
+    output["bler"] = static_cast<double>(result.failed) / result.reports;
+    output["deadline_misses"] = result.misses;
+    output["miss_rate"] = static_cast<double>(result.misses) / result.ttis;
+    output["slack_us"] = summary_us(result.slack, {0.1, 1.0, 50.0});
+    output["slack_histogram"] = buckets_us(result.slack);
+    output["lateness_us"] = summary_us(result.lateness, {50.0, 99.0});
+    output["processing_us"] = summary_us(result.processing, {50.0, 99.0, 99.9});
+    output["wakeup_us"] = summary_us(result.wakeup, {50.0, 99.0, 99.9});
+    output["environment"] = {
+        {"memory_locked", result.memory_locked},
+        {"pinned", result.pinned},
+        {"sched_fifo", result.fifo},
+    };
+
+    if (find_max) {
+        json probes = json::array();
+        for (const auto& p : capacity.probes) {
+            probes.push_back({{"reports_per_tti", p.reports_per_tti}, {"ttis", p.ttis}, {"misses", p.misses}});
+        }
+        output["max_reports_per_tti"] = capacity.max_reports_per_tti;
+        output["max_miss_rate"] = max_miss_rate;
+        output["probes"] = probes;
+    }
+
+    return 0;
+}
+
+} // namespace qpsk
@@ -0,0 +1,178 @@
+#include "system.hpp"
+#include "shard_queue.hpp"
+#include "random_bits.hpp"
+#include "decoder_registry.hpp"
+#include "json_helpers.hpp"
+
+#include <iostream>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace qpsk {
+
+namespace {
+
+constexpr double DEFAULT_LEASE_TIMEOUT_S = 3600.0;
+
+int fork_local_workers(const ShardQueue& queue, int workers, double lease_timeout_s) {
+    std::vector<pid_t> children;
+
+    std::cout.flush();
+    std::cerr.flush();
+
+    for (int w = 0; w < workers; ++w) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "Error: fork failed, running remaining shards in-process\n";
+            break;
+        }
+        if (pid == 0) {
+            int status = 0;
+            try {
+                run_shard_worker(queue, lease_timeout_s);
+            } catch (const std::exception& e) {
+                std::cerr << "Shard worker error: " << e.what() << "\n";
+                status = 1;
+            }
+            std::cerr.flush();
+            _exit(status);
+        }
+        children.push_back(pid);
+    }
+
+    int failures = 0;
+    for (pid_t pid : children) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            ++failures;
+        }
+    }
+
+    if (children.empty()) {
+        run_shard_worker(queue, lease_timeout_s);
+    }
+
+    return failures;
+}
+
+} // namespace
+
+int run_sharded_simulation_mode(const json& input, json& output) {
+    if (!input.contains("queue_dir")) {
+        std::cerr << "Error: missing 'queue_dir' for sharded simulation\n";
+        return 1;
+    }
+
+    const std::string dir = input["queue_dir"];
+    const int workers = input.value("workers", 1);
+    const double lease_timeout_s = input.value("lease_timeout", DEFAULT_LEASE_TIMEOUT_S);
+
+    if (workers < 0) {
+        std::cerr << "Error: 'workers' must be non-negative integer\n";
+        return 1;
+    }
+
+    try {
+        ShardQueue queue(dir);
+
+        if (!queue.exists()) {
+            if (!input.contains("num_of_pucch_f2_bits") || !input.contains("iterations")) {
+                std::cerr << "Error: missing fields for sharded simulation\n";
+                return 1;
+            }
+
+            ShardJob job;
+            job.sizes = scalar_or_array<int>(input["num_of_pucch_f2_bits"]);
+            job.snrs_db = scalar_or_array<double>(input.value("snr_db", json(10.0)));
+            job.iterations = input["iterations"];
+            job.shard_size = input.value("shard_size", job.iterations);
+            job.seed = input.contains("seed") ? input["seed"].get<uint64_t>() : random_seed();
+            job.decoder = input.value("decoder", "");
+
+            if (!job.decoder.empty() && !is_registered_decoder(job.decoder)) {
+                std::cerr << "Error: unknown decoder '" << job.decoder << "'\n";
+                return 1;
+            }
+
+            for (int n : job.sizes) {
+                if (n != 2 && n != 4 && n != 6 && n != 8 && n != 11) {
+                    std::cerr << "Error: invalid num_of_pucch_f2_bits " << n << "\n";
+                    return 1;
+                }
+            }
+
+            queue.create(job);
+        }
+
+        if (workers > 0) {
+            int failures = fork_local_workers(queue, workers, lease_timeout_s);
+            if (failures > 0) {
+                std::cerr << "Warning: " << failures << " shard worker(s) failed\n";
+            }
+        }
+
+        output = queue.merge();
+        output["queue_dir"] = dir;
+    } catch (const std::exception& e) {
+        std::cerr << "Sharded simulation error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+int run_shard_worker_mode(const json& input, json& output) {
+    if (!input.contains("queue_dir")) {
+        std::cerr << "Error: missing 'queue_dir' for shard worker\n";
+        return 1;
+    }
+
+    const std::string dir = input["queue_dir"];
+    const double lease_timeout_s = input.value("lease_timeout", DEFAULT_LEASE_TIMEOUT_S);
+
+    try {
+        ShardQueue queue(dir);
+        if (!queue.exists()) {
+            std::cerr << "Error: no shard queue in " << dir << "\n";
+            return 1;
+        }
+
+        output["mode"] = "shard worker";
+        output["queue_dir"] = dir;
+        output["completed_shards"] = run_shard_worker(queue, lease_timeout_s);
+    } catch (const std::exception& e) {
+        std::cerr << "Shard worker error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+int run_shard_merge_mode(const json& input, json& output) {
+    if (!input.contains("queue_dir")) {
+        std::cerr << "Error: missing 'queue_dir' for shard merge\n";
+        return 1;
+    }
+
+    const std::string dir = input["queue_dir"];
+
+    try {
+        ShardQueue queue(dir);
+        if (!queue.exists()) {
+            std::cerr << "Error: no shard queue in " << dir << "\n";
+            return 1;
+        }
+
+        output = queue.merge();
+        output["queue_dir"] = dir;
+    } catch (const std::exception& e) {
+        std::cerr << "Shard merge error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+} // namespace qpsk
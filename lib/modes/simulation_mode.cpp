@@ -1,41 +1,13 @@
 #include "system.hpp"
-#include "encoder.hpp"
-#include "qpsk.hpp"
-#include "channel.hpp"
+#include "simulation.hpp"
 #include "random_bits.hpp"
-#include "precomputed_decoder.hpp"
+#include "decoder_registry.hpp"
+#include "bler_bounds.hpp"
 
 #include <iostream>
 
 namespace qpsk {
 
-template<int N>
-int process_simulation(int iterations, double snr_db) {
-    BlockEncoder<N> code;
-
-    PrecomputedDecoder<N> decoder;
-    QPSK mod;
-    Channel channel(snr_db);
-    
-    int success = 0;
-    for (int i = 0; i < iterations; ++i) {
-        auto tx_bits = generate_random_bits<N>();
-
-        auto cw = code.encode(tx_bits);
-        auto symbols = mod.modulate(cw);
-
-        auto rx_symbols = channel.apply(symbols);
-
-        auto llrs = mod.demodulate(rx_symbols);
-        auto rx_bits = decoder.decode(llrs);
-
-        if (tx_bits == rx_bits) {
-            ++success;
-        }
-    }
-    return success;
-}
-
 int run_simulation_mode(const json& input, json& output) {
     if (!input.contains("num_of_pucch_f2_bits") ||
         !input.contains("iterations")) {
@@ -52,23 +24,106 @@ int run_simulation_mode(const json& input, json& output) {
         return 1;
     }
 
-    int success = 0;
+    SimulationConfig config;
+    config.n = n;
+    config.snr_db = snr_db;
+    config.iterations = iterations;
+    config.seed = input.contains("seed") ? input["seed"].get<uint64_t>() : random_seed();
+    config.decoder = input.value("decoder", "");
+    config.early_exit = input.value("early_exit", false);
+    config.compare_to_ml = input.value("compare_to_ml", false);
+    config.engine = input.value("engine", "");
+    config.pipeline_stages = input.value("pipeline_stages", config.pipeline_stages);
+    config.pipeline_cpus = input.value("pipeline_cpus", config.pipeline_cpus);
+
+    if (input.contains("decoder_budget")) {
+        if (!input["decoder_budget"].is_number_integer() || input["decoder_budget"].get<int>() <= 0) {
+            std::cerr << "Error: 'decoder_budget' must be positive integer\n";
+            return 1;
+        }
+        config.decoder_options.budget = input["decoder_budget"];
+    }
+
+    if (!config.decoder.empty() && !is_registered_decoder(config.decoder)) {
+        std::cerr << "Error: unknown decoder '" << config.decoder << "'\n";
+        return 1;
+    }
+
+    if (input.contains("quantization_bits")) {
+        const auto& widths = input["quantization_bits"];
+        if (!widths.is_array()) {
+            std::cerr << "Error: 'quantization_bits' must be array of integers in [2, 8]\n";
+            return 1;
+        }
+        for (const auto& w : widths) {
+            if (!w.is_number_integer() || w.get<int>() < 2 || w.get<int>() > 8) {
+                std::cerr << "Error: 'quantization_bits' must be array of integers in [2, 8]\n";
+                return 1;
+            }
+            config.quantization_bits.push_back(w.get<int>());
+        }
+    }
+
+    if (input.contains("dtx_threshold")) {
+        if (!input["dtx_threshold"].is_number()) {
+            std::cerr << "Error: 'dtx_threshold' must be number\n";
+            return 1;
+        }
+        config.dtx_threshold = input["dtx_threshold"].get<double>();
+        config.dtx_trials = input.value("dtx_trials", 0LL);
+    }
+
+    if (input.contains("known_bits")) {
+        try {
+            config.known_bits = parse_known_bits(input["known_bits"], n);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: invalid 'known_bits': " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    if (input.contains("blind_sizes")) {
+        const auto& sizes = input["blind_sizes"];
+        if (!sizes.is_array() || sizes.empty()) {
+            std::cerr << "Error: 'blind_sizes' must be non-empty array of payload sizes\n";
+            return 1;
+        }
+        for (const auto& size : sizes) {
+            if (!size.is_number_integer()) {
+                std::cerr << "Error: 'blind_sizes' must be non-empty array of payload sizes\n";
+                return 1;
+            }
+            config.blind_sizes.push_back(size.get<int>());
+        }
+        config.blind_margin = input.value("blind_margin", config.blind_margin);
+    }
+
+    std::string capture_file;
+    if (input.contains("capture")) {
+        const auto& capture = input["capture"];
+        if (!capture.is_object() || !capture.contains("file")) {
+            std::cerr << "Error: 'capture' must be object with 'file'\n";
+            return 1;
+        }
+        capture_file = capture["file"];
+        config.capture.failures = capture.value("failures", 1024);
+        config.capture.successes = capture.value("successes", 64);
+        config.capture.sample_period = capture.value("sample_period", config.capture.sample_period);
+    }
+
+    SimulationResult result;
 
     try {
-        switch (n) {
-            case 2:  success = process_simulation<2>(iterations, snr_db); break;
-            case 4:  success = process_simulation<4>(iterations, snr_db); break;
-            case 6:  success = process_simulation<6>(iterations, snr_db); break;
-            case 8:  success = process_simulation<8>(iterations, snr_db); break;
-            case 11: success = process_simulation<11>(iterations, snr_db); break;
-            default:
-                throw std::invalid_argument("lib/modes/simulation_mode.cpp: invalid num_of_pucch_f2_bits");
+        result = simulate(config);
+        if (!capture_file.empty()) {
+            write_capture(capture_file, result.capture);
         }
     } catch (const std::exception& e) {
         std::cerr << "Simulation error: " << e.what() << "\n";
         return 1;
     }
 
+    const int success = static_cast<int>(result.success);
     double bler = 1.0 - static_cast<double>(success) / iterations;
 
     output["mode"] = "channel simulation";
@@ -76,6 +131,115 @@ int run_simulation_mode(const json& input, json& output) {
     output["bler"] = bler;
     output["success"] = success;
     output["failed"] = iterations - success;
+    output["union_bound_bler"] = union_bound_bler(n, snr_db);
+    output["tangential_sphere_bound_bler"] = tangential_sphere_bound_bler(n, snr_db);
+
+    if (!capture_file.empty()) {
+        json capture;
+        capture["file"] = capture_file;
+        capture["failures_seen"] = result.capture.failures_seen;
+        capture["successes_sampled"] = result.capture.successes_sampled;
+        capture["records"] = result.capture.records.size();
+        output["capture"] = capture;
+    }
+
+    if (config.compare_to_ml) {
+        const double ml_bler = static_cast<double>(result.ml_failed) / iterations;
+
+        json comparison;
+        comparison["ml_decoder"] = result.ml_decoder;
+        comparison["ml_bler"] = ml_bler;
+        comparison["bler_penalty"] = bler - ml_bler;
+        comparison["disagreements"] = result.disagreements;
+        comparison["decode_ns"] = result.decode_ns / iterations;
+        comparison["ml_decode_ns"] = result.ml_decode_ns / iterations;
+        comparison["speedup"] = result.decode_ns > 0.0 ? result.ml_decode_ns / result.decode_ns : 0.0;
+        output["ml_comparison"] = comparison;
+    }
+
+    if (!config.known_bits.empty()) {
+        const double full_bler = static_cast<double>(result.full_search_failed) / iterations;
+
+        json known;
+        known["count"] = config.known_bits.count();
+        known["candidates"] = 1LL << (n - config.known_bits.count());
+        known["full_search_bler"] = full_bler;
+        known["bler_gain"] = full_bler - bler;
+        output["known_bits"] = known;
+    }
+
+    if (!config.blind_sizes.empty()) {
+        const BlindDetector detector(config.blind_sizes, config.blind_margin);
+
+        json selected = json::object();
+        for (size_t s = 0; s < detector.sizes().size(); ++s) {
+            selected[std::to_string(detector.sizes()[s])] = result.blind_selected[s];
+        }
+        long long correct_size = 0;
+        for (size_t s = 0; s < detector.sizes().size(); ++s) {
+            if (detector.sizes()[s] == n) {
+                correct_size = result.blind_selected[s];
+            }
+        }
+
+        json blind;
+        blind["sizes"] = detector.sizes();
+        blind["margin"] = detector.margin();
+        blind["selected"] = selected;
+        blind["size_error_rate"] = 1.0 - static_cast<double>(correct_size) / iterations;
+        blind["ambiguous_rate"] = static_cast<double>(result.blind_ambiguous) / iterations;
+        blind["bler"] = static_cast<double>(result.blind_failed) / iterations;
+        blind["bler_penalty"] = static_cast<double>(result.blind_failed) / iterations - bler;
+        output["blind_detection"] = blind;
+    }
+
+    if (config.dtx_threshold) {
+        json dtx;
+        dtx["threshold"] = *config.dtx_threshold;
+        dtx["missed_detections"] = result.missed_detections;
+        dtx["missed_detection_rate"] = static_cast<double>(result.missed_detections) / iterations;
+        dtx["dtx_trials"] = result.dtx_trials;
+        dtx["false_alarms"] = result.false_alarms;
+        dtx["false_alarm_rate"] = result.dtx_trials > 0 ?
+            static_cast<double>(result.false_alarms) / result.dtx_trials : 0.0;
+        output["dtx"] = dtx;
+    }
+
+    if (!result.stages.empty()) {
+        json stages = json::array();
+        for (const auto& stage : result.stages) {
+            json entry;
+            entry["stage"] = stage.name;
+            entry["blocks"] = stage.blocks;
+            entry["utilization"] = stage.wall_ns > 0.0 ? stage.busy_ns / stage.wall_ns : 0.0;
+            entry["busy_ms"] = stage.busy_ns / 1e6;
+            entry["input_stall_ms"] = stage.input_stall_ns / 1e6;
+            entry["output_stall_ms"] = stage.output_stall_ns / 1e6;
+            entry["wall_ms"] = stage.wall_ns / 1e6;
+            entry["pinned"] = stage.pinned;
+            stages.push_back(entry);
+        }
+        output["pipeline"] = stages;
+    }
+
+    if (config.early_exit) {
+        output["early_exit_hit_rate"] = static_cast<double>(result.early_exits) / iterations;
+    }
+
+    if (!config.quantization_bits.empty()) {
+        json quantization = json::array();
+        for (size_t q = 0; q < config.quantization_bits.size(); ++q) {
+            double q_bler = static_cast<double>(result.quantized_failed[q]) / iterations;
+
+            json entry;
+            entry["bits"] = config.quantization_bits[q];
+            entry["bler"] = q_bler;
+            entry["bler_delta"] = q_bler - bler;
+            entry["failed"] = result.quantized_failed[q];
+            quantization.push_back(entry);
+        }
+        output["quantization"] = quantization;
+    }
 
     return 0;
 }
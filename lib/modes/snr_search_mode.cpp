@@ -0,0 +1,93 @@
+#include "system.hpp"
+#include "snr_search.hpp"
+#include "random_bits.hpp"
+#include "decoder_registry.hpp"
+
+#include <iostream>
+
+namespace qpsk {
+
+int run_snr_search_mode(const json& input, json& output) {
+    if (!input.contains("num_of_pucch_f2_bits") || !input.contains("target_bler")) {
+        std::cerr << "Error: missing fields for snr search\n";
+        return 1;
+    }
+
+    std::vector<int> sizes;
+    if (input["num_of_pucch_f2_bits"].is_array()) {
+        sizes = input["num_of_pucch_f2_bits"].get<std::vector<int>>();
+    } else {
+        sizes.push_back(input["num_of_pucch_f2_bits"].get<int>());
+    }
+
+    SnrSearchConfig base;
+    base.target_bler = input["target_bler"];
+    base.tolerance_db = input.value("tolerance_db", base.tolerance_db);
+    base.confidence = input.value("confidence", base.confidence);
+    base.relative_precision = input.value("relative_precision", base.relative_precision);
+    base.max_trials = input.value("max_trials", base.max_trials);
+    base.sweep_points = input.value("sweep_points", base.sweep_points);
+    base.decoder = input.value("decoder", "");
+
+    if (input.contains("snr_range")) {
+        const auto& range = input["snr_range"];
+        if (!range.is_array() || range.size() != 2) {
+            std::cerr << "Error: 'snr_range' must be array [low, high]\n";
+            return 1;
+        }
+        base.snr_low_db = range[0];
+        base.snr_high_db = range[1];
+    }
+
+    if (!base.decoder.empty() && !is_registered_decoder(base.decoder)) {
+        std::cerr << "Error: unknown decoder '" << base.decoder << "'\n";
+        return 1;
+    }
+
+    const uint64_t seed = input.contains("seed") ? input["seed"].get<uint64_t>() : random_seed();
+
+    json results = json::array();
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        SnrSearchConfig config = base;
+        config.n = sizes[i];
+        config.seed = derive_seed(seed, i);
+
+        SnrSearchResult result;
+        try {
+            result = search_snr(config);
+        } catch (const std::exception& e) {
+            std::cerr << "SNR search error: " << e.what() << "\n";
+            return 1;
+        }
+
+        json points = json::array();
+        for (const auto& point : result.points) {
+            json entry;
+            entry["snr_db"] = point.snr_db;
+            entry["trials"] = point.trials;
+            entry["failed"] = point.failed;
+            entry["bler"] = static_cast<double>(point.failed) / point.trials;
+            points.push_back(entry);
+        }
+
+        json entry;
+        entry["num_of_pucch_f2_bits"] = config.n;
+        entry["snr_db"] = result.snr_db;
+        entry["snr_ci_db"] = {result.snr_low_db, result.snr_high_db};
+        entry["converged"] = result.converged;
+        entry["trials"] = result.trials;
+        entry["sweep_trials"] = result.sweep_trials;
+        entry["trials_fraction"] = static_cast<double>(result.trials) / result.sweep_trials;
+        entry["points"] = points;
+        results.push_back(entry);
+    }
+
+    output["mode"] = "snr search";
+    output["target_bler"] = base.target_bler;
+    output["confidence"] = base.confidence;
+    output["results"] = results;
+
+    return 0;
+}
+
+} // namespace qpsk
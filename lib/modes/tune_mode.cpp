@@ -0,0 +1,38 @@
+#include "system.hpp"
+#include "decoder_tuner.hpp"
+
+#include <iostream>
+
+namespace qpsk {
+
+int run_tune_mode(const json& input, json& output) {
+    try {
+        auto results = tune_decoders();
+
+        json table = json::array();
+        for (const auto& r : results) {
+            json timings = json::object();
+            for (const auto& [name, ns] : r.timings_ns) {
+                timings[name] = ns;
+            }
+
+            json row;
+            row["num_of_pucch_f2_bits"] = r.n;
+            row["decoder"] = r.decoder;
+            row["ns_per_decode"] = timings;
+            table.push_back(row);
+        }
+
+        output["mode"] = "tune";
+        output["cpu"] = cpu_model();
+        output["cache"] = decoder_cache_path();
+        output["decoders"] = table;
+    } catch (const std::exception& e) {
+        std::cerr << "Tuning error: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
+
+} // namespace qpsk
@@ -0,0 +1,58 @@
+#include "system.hpp"
+#include "bler_bounds.hpp"
+#include "codebook.hpp"
+#include "json_helpers.hpp"
+
+#include <iostream>
+
+namespace qpsk {
+
+int run_union_bound_mode(const json& input, json& output) {
+    if (!input.contains("num_of_pucch_f2_bits") || !input.contains("snr_db")) {
+        std::cerr << "Error: missing fields for union bound\n";
+        return 1;
+    }
+
+    const auto sizes = scalar_or_array<int>(input["num_of_pucch_f2_bits"]);
+    const auto snrs_db = scalar_or_array<double>(input["snr_db"]);
+
+    json results = json::array();
+    try {
+        for (int n : sizes) {
+            const auto& distribution = weight_distribution(n);
+
+            json weights = json::array();
+            for (size_t w = 0; w < distribution.size(); ++w) {
+                if (distribution[w] > 0) {
+                    weights.push_back({{"weight", w}, {"count", distribution[w]}});
+                }
+            }
+
+            json points = json::array();
+            for (double snr_db : snrs_db) {
+                json point;
+                point["snr_db"] = snr_db;
+                point["union_bound_bler"] = union_bound_bler(n, snr_db);
+                point["tangential_sphere_bound_bler"] = tangential_sphere_bound_bler(n, snr_db);
+                points.push_back(point);
+            }
+
+            json entry;
+            entry["num_of_pucch_f2_bits"] = n;
+            entry["minimum_distance"] = minimum_distance(n);
+            entry["weight_distribution"] = weights;
+            entry["points"] = points;
+            results.push_back(entry);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Union bound error: " << e.what() << "\n";
+        return 1;
+    }
+
+    output["mode"] = "union bound";
+    output["results"] = results;
+
+    return 0;
+}
+
+} // namespace qpsk
@@ -0,0 +1,267 @@
+#include "simulation.hpp"
+#include "encoder.hpp"
+#include "qpsk.hpp"
+#include "channel.hpp"
+#include "random_bits.hpp"
+#include "decoder_tuner.hpp"
+#include "utils/cpu_affinity.hpp"
+#include "utils/spsc_ring.hpp"
+#include "utils/trace.hpp"
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace qpsk {
+
+const std::vector<std::string> PIPELINE_STAGES = {"bits", "encode", "modulate", "channel", "demodulate", "decode"};
+const std::vector<std::string> DEFAULT_PIPELINE = {"bits+encode+modulate", "channel", "demodulate+decode"};
+
+namespace {
+
+constexpr size_t BLOCK_TRIALS = 256;
+// Blocks a stage may run ahead of the next one before it is held back.
+constexpr size_t RING_BLOCKS = 4;
+
+using Clock = std::chrono::steady_clock;
+
+enum Stage { BITS, ENCODE, MODULATE, CHANNEL, DEMODULATE, DECODE };
+
+template <int N>
+struct TrialBlock {
+    size_t count = 0;
+    long long failed = 0;
+    std::array<std::bitset<N>, BLOCK_TRIALS> tx_bits;
+    std::array<std::bitset<CODEWORD_SIZE>, BLOCK_TRIALS> codewords;
+    std::vector<std::vector<Complex>> symbols = std::vector<std::vector<Complex>>(BLOCK_TRIALS);
+    std::vector<std::vector<double>> llrs = std::vector<std::vector<double>>(BLOCK_TRIALS);
+};
+
+// Each member other than mod is used by a single stage, hence by a single
+// thread. mod is shared by the modulate and demodulate stages; QPSK is
+// stateless and both only call its const methods.
+template <int N>
+struct StageState {
+    BlockEncoder<N> code;
+    QPSK mod;
+    Channel channel;
+    std::mt19937 bits_rng;
+    std::mt19937 noise_rng;
+    std::unique_ptr<AbstractDecoder<N>> decoder;
+
+    explicit StageState(const SimulationConfig& config)
+        : channel(config.snr_db),
+          bits_rng(make_rng(derive_seed(config.seed, 0))),
+          noise_rng(make_rng(derive_seed(config.seed, 1))),
+          decoder(make_decoder<N>(config.decoder.empty() ? select_decoder(N) : config.decoder,
+                                  config.decoder_options)) {}
+};
+
+template <int N>
+void run_stage(int stage, StageState<N>& state, TrialBlock<N>& block) {
+    switch (stage) {
+        case BITS:
+            for (size_t t = 0; t < block.count; ++t) {
+                block.tx_bits[t] = generate_random_bits<N>(state.bits_rng);
+            }
+            break;
+        case ENCODE:
+            for (size_t t = 0; t < block.count; ++t) {
+                block.codewords[t] = state.code.encode(block.tx_bits[t]);
+            }
+            break;
+        case MODULATE:
+            for (size_t t = 0; t < block.count; ++t) {
+                block.symbols[t] = state.mod.modulate(block.codewords[t]);
+            }
+            break;
+        case CHANNEL:
+            for (size_t t = 0; t < block.count; ++t) {
+                block.symbols[t] = state.channel.apply(block.symbols[t], state.noise_rng);
+            }
+            break;
+        case DEMODULATE:
+            for (size_t t = 0; t < block.count; ++t) {
+                block.llrs[t] = state.mod.demodulate(block.symbols[t]);
+            }
+            break;
+        case DECODE:
+            block.failed = 0;
+            for (size_t t = 0; t < block.count; ++t) {
+                block.failed += state.decoder->decode(block.llrs[t]) != block.tx_bits[t];
+            }
+            break;
+    }
+}
+
+std::vector<std::vector<int>> parse_pipeline(const std::vector<std::string>& groups) {
+    std::vector<std::vector<int>> stages;
+    int expected = 0;
+
+    for (const auto& group : groups) {
+        stages.emplace_back();
+        size_t begin = 0;
+        for (;;) {
+            const size_t end = group.find('+', begin);
+            const std::string name = group.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+            if (expected >= static_cast<int>(PIPELINE_STAGES.size()) || name != PIPELINE_STAGES[expected]) {
+                throw std::invalid_argument("lib/pipelined_simulation.cpp: pipeline must list "
+                                            "bits, encode, modulate, channel, demodulate, decode in order");
+            }
+            stages.back().push_back(expected++);
+            if (end == std::string::npos) {
+                break;
+            }
+            begin = end + 1;
+        }
+    }
+
+    if (expected != static_cast<int>(PIPELINE_STAGES.size())) {
+        throw std::invalid_argument("lib/pipelined_simulation.cpp: pipeline must list "
+                                    "bits, encode, modulate, channel, demodulate, decode in order");
+    }
+    return stages;
+}
+
+template <typename T>
+double wait_pop(SpscRing<T*>& ring, T*& value) {
+    if (ring.try_pop(value)) {
+        return 0.0;
+    }
+    TRACE_SPAN("input stall");
+    const auto start = Clock::now();
+    while (!ring.try_pop(value)) {
+        std::this_thread::yield();
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+template <typename T>
+double wait_push(SpscRing<T*>& ring, T* value) {
+    if (ring.try_push(value)) {
+        return 0.0;
+    }
+    TRACE_SPAN("output stall");
+    const auto start = Clock::now();
+    while (!ring.try_push(value)) {
+        std::this_thread::yield();
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+template <int N>
+SimulationResult process_pipelined(const SimulationConfig& config) {
+    const std::vector<std::string> names = config.pipeline_stages.empty() ? DEFAULT_PIPELINE : config.pipeline_stages;
+    const auto groups = parse_pipeline(names);
+    const size_t group_count = groups.size();
+
+    StageState<N> state(config);
+
+    const size_t block_count = RING_BLOCKS * group_count;
+    std::vector<std::unique_ptr<TrialBlock<N>>> blocks;
+    for (size_t i = 0; i < block_count; ++i) {
+        blocks.push_back(std::make_unique<TrialBlock<N>>());
+    }
+
+    // rings[g] feeds group g; rings[0] carries finished blocks back to the
+    // first group and can hold all of them, so recycling never blocks.
+    std::vector<std::unique_ptr<SpscRing<TrialBlock<N>*>>> rings;
+    rings.push_back(std::make_unique<SpscRing<TrialBlock<N>*>>(block_count));
+    for (size_t g = 1; g < group_count; ++g) {
+        rings.push_back(std::make_unique<SpscRing<TrialBlock<N>*>>(RING_BLOCKS));
+    }
+    for (auto& block : blocks) {
+        rings[0]->try_push(block.get());
+    }
+
+    const long long iterations = config.iterations;
+    const long long total_blocks = (iterations + BLOCK_TRIALS - 1) / static_cast<long long>(BLOCK_TRIALS);
+
+    SimulationResult result;
+    result.stages.resize(group_count);
+
+    auto run_group = [&](size_t g) {
+        StageStats& stats = result.stages[g];
+        stats.name = names[g];
+        set_trace_thread_name("pipeline " + stats.name);
+        if (!config.pipeline_cpus.empty()) {
+            stats.pinned = pin_current_thread(config.pipeline_cpus[g % config.pipeline_cpus.size()]);
+        }
+
+        SpscRing<TrialBlock<N>*>& input = *rings[g];
+        SpscRing<TrialBlock<N>*>& output = *rings[(g + 1) % group_count];
+        const bool first = g == 0;
+        const bool last = g + 1 == group_count;
+
+        const auto start = Clock::now();
+        for (long long b = 0;; ++b) {
+            if (first && b == total_blocks) {
+                if (!last) {
+                    stats.output_stall_ns += wait_push<TrialBlock<N>>(output, nullptr);
+                }
+                break;
+            }
+
+            TrialBlock<N>* block = nullptr;
+            stats.input_stall_ns += wait_pop(input, block);
+            if (block == nullptr) {
+                if (!last) {
+                    stats.output_stall_ns += wait_push<TrialBlock<N>>(output, nullptr);
+                }
+                break;
+            }
+
+            const auto busy_start = Clock::now();
+            if (first) {
+                const long long remaining = iterations - b * static_cast<long long>(BLOCK_TRIALS);
+                block->count = static_cast<size_t>(std::min<long long>(remaining, BLOCK_TRIALS));
+            }
+            for (int stage : groups[g]) {
+                TRACE_SPAN(PIPELINE_STAGES[stage].c_str());
+                run_stage(stage, state, *block);
+            }
+            if (last) {
+                result.failed += block->failed;
+            }
+            stats.busy_ns += std::chrono::duration<double, std::nano>(Clock::now() - busy_start).count();
+            ++stats.blocks;
+
+            stats.output_stall_ns += wait_push(output, block);
+        }
+        stats.wall_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t g = 0; g < group_count; ++g) {
+        threads.emplace_back(run_group, g);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    result.success = iterations - result.failed;
+    return result;
+}
+
+} // namespace
+
+SimulationResult simulate_pipelined(const SimulationConfig& config) {
+    if (config.capture.enabled() || config.compare_to_ml || config.early_exit || !config.quantization_bits.empty() ||
+        config.dtx_threshold || !config.known_bits.empty() || !config.blind_sizes.empty()) {
+        throw std::invalid_argument("lib/pipelined_simulation.cpp: pipelined engine supports plain BLER runs only");
+    }
+
+    switch (config.n) {
+        case 2:  return process_pipelined<2>(config);
+        case 4:  return process_pipelined<4>(config);
+        case 6:  return process_pipelined<6>(config);
+        case 8:  return process_pipelined<8>(config);
+        case 11: return process_pipelined<11>(config);
+        default:
+            throw std::invalid_argument("lib/pipelined_simulation.cpp: invalid num_of_pucch_f2_bits");
+    }
+}
+
+} // namespace qpsk
@@ -2,6 +2,8 @@
 #include "system.hpp"
 
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 namespace qpsk {
 
@@ -50,4 +52,42 @@ std::vector<double> QPSK::demodulate(const std::vector<Complex>& symbols) const
     return llrs;
 }
 
+std::vector<int8_t> QPSK::demodulate_quantized(const std::vector<Complex>& symbols,
+                                               int bits, double scale) const {
+    if (symbols.size() != QPSK_SYMBOLS_COUNT) {
+        throw std::invalid_argument("lib/qpsk.cpp: expected 10 QPSK symbols");
+    }
+    if (bits < MIN_QUANTIZATION_BITS || bits > MAX_QUANTIZATION_BITS) {
+        throw std::invalid_argument("lib/qpsk.cpp: quantization bits must be in [2, 8]");
+    }
+
+    const double max_level = static_cast<double>((1 << (bits - 1)) - 1);
+
+    auto quantize = [&](double value) {
+        double level = std::clamp(std::nearbyint(value * scale), -max_level, max_level);
+        return static_cast<int8_t>(level);
+    };
+
+    std::vector<int8_t> llrs;
+    llrs.reserve(CODEWORD_SIZE);
+
+    for (const auto& s : symbols) {
+        llrs.push_back(quantize(s.real()));
+        llrs.push_back(quantize(s.imag()));
+    }
+
+    return llrs;
+}
+
+double QPSK::quantization_scale(double snr_db, int bits) {
+    if (bits < MIN_QUANTIZATION_BITS || bits > MAX_QUANTIZATION_BITS) {
+        throw std::invalid_argument("lib/qpsk.cpp: quantization bits must be in [2, 8]");
+    }
+
+    const double max_level = static_cast<double>((1 << (bits - 1)) - 1);
+    const double sigma = std::sqrt(1.0 / (2.0 * std::pow(10.0, snr_db / 10.0)));
+
+    return max_level / (NORM + QUANTIZATION_CLIP_SIGMAS * sigma);
+}
+
 } // namespace qpsk
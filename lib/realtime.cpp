@@ -0,0 +1,345 @@
+#include "realtime.hpp"
+#include "encoder.hpp"
+#include "qpsk.hpp"
+#include "channel.hpp"
+#include "random_bits.hpp"
+#include "decoder_tuner.hpp"
+#include "utils/cpu_affinity.hpp"
+#include "utils/trace.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace qpsk {
+
+namespace {
+
+// Distinct inputs cycled through by the TTIs; large enough that consecutive
+// batches do not hit the same LLRs in cache.
+constexpr size_t POOL_SIZE = 4096;
+// Delay between the workers being ready and the first release.
+constexpr int64_t START_DELAY_NS = 2000000;
+
+using ReportDecoder = std::function<uint32_t(const std::vector<double>&)>;
+
+int64_t now_ns() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+void sleep_until(int64_t deadline_ns) {
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(deadline_ns / 1000000000LL);
+    ts.tv_nsec = static_cast<long>(deadline_ns % 1000000000LL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+}
+
+template <typename T>
+bool lock_buffer(const std::vector<T>& buffer) {
+    return buffer.empty() || mlock(buffer.data(), buffer.size() * sizeof(T)) == 0;
+}
+
+template <typename T>
+void unlock_buffer(const std::vector<T>& buffer) {
+    if (!buffer.empty()) {
+        munlock(buffer.data(), buffer.size() * sizeof(T));
+    }
+}
+
+int size_index(int n) {
+    switch (n) {
+        case 2:  return 0;
+        case 4:  return 1;
+        case 6:  return 2;
+        case 8:  return 3;
+        case 11: return 4;
+        default:
+            throw std::invalid_argument("lib/realtime.cpp: invalid num_of_pucch_f2_bits");
+    }
+}
+
+struct InputPool {
+    std::vector<uint8_t> sizes;
+    std::vector<uint32_t> tx_bits;
+    std::vector<double> llrs;
+};
+
+template <int N>
+void generate_report(InputPool& pool, size_t index, const Channel& channel, std::mt19937& rng) {
+    BlockEncoder<N> code;
+    QPSK mod;
+
+    const auto tx_bits = generate_random_bits<N>(rng);
+    const auto llrs = mod.demodulate(channel.apply(mod.modulate(code.encode(tx_bits)), rng));
+
+    pool.tx_bits[index] = static_cast<uint32_t>(tx_bits.to_ulong());
+    std::copy(llrs.begin(), llrs.end(), pool.llrs.begin() + index * CODEWORD_SIZE);
+}
+
+InputPool generate_pool(const RealtimeConfig& config) {
+    InputPool pool;
+    pool.sizes.resize(POOL_SIZE);
+    pool.tx_bits.resize(POOL_SIZE);
+    pool.llrs.resize(POOL_SIZE * CODEWORD_SIZE);
+
+    Channel channel(config.snr_db);
+    std::mt19937 rng = make_rng(config.seed);
+    std::uniform_int_distribution<size_t> pick(0, config.sizes.size() - 1);
+
+    for (size_t i = 0; i < POOL_SIZE; ++i) {
+        const int n = config.sizes[pick(rng)];
+        pool.sizes[i] = static_cast<uint8_t>(size_index(n));
+        switch (n) {
+            case 2:  generate_report<2>(pool, i, channel, rng); break;
+            case 4:  generate_report<4>(pool, i, channel, rng); break;
+            case 6:  generate_report<6>(pool, i, channel, rng); break;
+            case 8:  generate_report<8>(pool, i, channel, rng); break;
+            case 11: generate_report<11>(pool, i, channel, rng); break;
+        }
+    }
+
+    return pool;
+}
+
+template <int N>
+ReportDecoder bind_decoder(const RealtimeConfig& config) {
+    const auto& decoder = shared_decoder<N>(config.decoder.empty() ? select_decoder(N) : config.decoder,
+                                            config.decoder_options);
+    return [&decoder](const std::vector<double>& llrs) {
+        return static_cast<uint32_t>(decoder.decode(llrs).to_ulong());
+    };
+}
+
+std::vector<ReportDecoder> bind_decoders(const RealtimeConfig& config) {
+    std::vector<ReportDecoder> decoders(5);
+    for (int n : config.sizes) {
+        auto& decoder = decoders[size_index(n)];
+        if (decoder) {
+            continue;
+        }
+        switch (n) {
+            case 2:  decoder = bind_decoder<2>(config); break;
+            case 4:  decoder = bind_decoder<4>(config); break;
+            case 6:  decoder = bind_decoder<6>(config); break;
+            case 8:  decoder = bind_decoder<8>(config); break;
+            case 11: decoder = bind_decoder<11>(config); break;
+        }
+    }
+    return decoders;
+}
+
+std::vector<int> worker_cpus(const RealtimeConfig& config) {
+    return config.cpus.empty() ? allowed_cpus() : config.cpus;
+}
+
+bool make_current_thread_fifo(int priority) {
+    sched_param param{};
+    param.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+}
+
+void validate(const RealtimeConfig& config) {
+    if (config.sizes.empty()) {
+        throw std::invalid_argument("lib/realtime.cpp: no report sizes");
+    }
+    for (int n : config.sizes) {
+        size_index(n);
+    }
+    if (config.tti_ns <= 0 || config.reports_per_tti <= 0 || config.ttis <= 0 || config.workers <= 0) {
+        throw std::invalid_argument("lib/realtime.cpp: tti, reports per TTI, TTI count and workers must be positive");
+    }
+    if (config.fifo_priority < 0 || (config.fifo_priority > 0 &&
+        (config.fifo_priority < sched_get_priority_min(SCHED_FIFO) ||
+         config.fifo_priority > sched_get_priority_max(SCHED_FIFO)))) {
+        throw std::invalid_argument("lib/realtime.cpp: SCHED_FIFO priority out of range");
+    }
+}
+
+} // namespace
+
+RealtimeResult run_realtime(const RealtimeConfig& config) {
+    validate(config);
+
+    const InputPool pool = generate_pool(config);
+    const std::vector<ReportDecoder> decoders = bind_decoders(config);
+
+    const size_t workers = static_cast<size_t>(config.workers);
+    const size_t ttis = static_cast<size_t>(config.ttis);
+    const size_t reports = static_cast<size_t>(config.reports_per_tti);
+    const std::vector<int> cpus = worker_cpus(config);
+
+    // Everything the workers touch after the start is allocated here.
+    // Timestamps are worker-major (w * ttis + t): workers released together
+    // write to their own cache lines rather than sharing one per TTI.
+    std::vector<int64_t> wake_ns(ttis * workers);
+    std::vector<int64_t> finish_ns(ttis * workers);
+    std::vector<long long> failed(workers, 0);
+    std::vector<uint8_t> pinned(workers, 0);
+    std::vector<uint8_t> fifo(workers, 0);
+    std::vector<std::vector<double>> scratch(workers, std::vector<double>(CODEWORD_SIZE));
+
+    RealtimeResult result;
+    if (config.lock_memory) {
+        result.memory_locked = lock_buffer(pool.sizes) && lock_buffer(pool.tx_bits) && lock_buffer(pool.llrs) &&
+                               lock_buffer(wake_ns) && lock_buffer(finish_ns);
+        for (const auto& buffer : scratch) {
+            result.memory_locked = lock_buffer(buffer) && result.memory_locked;
+        }
+    }
+
+    // Warm the decoders and their tables before any deadline counts.
+    for (size_t i = 0; i < std::min(POOL_SIZE, reports * 2); ++i) {
+        std::copy_n(pool.llrs.begin() + i * CODEWORD_SIZE, CODEWORD_SIZE, scratch[0].begin());
+        decoders[pool.sizes[i]](scratch[0]);
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t ready = 0;
+    int64_t start_ns = 0;
+
+    auto worker = [&](size_t w) {
+        set_trace_thread_name("realtime worker " + std::to_string(w));
+        if (config.pin && !cpus.empty()) {
+            pinned[w] = pin_current_thread(cpus[w % cpus.size()]);
+        }
+        if (config.fifo_priority > 0) {
+            fifo[w] = make_current_thread_fifo(config.fifo_priority);
+        }
+
+        int64_t start;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ++ready;
+            cv.notify_all();
+            cv.wait(lock, [&] { return start_ns != 0; });
+            start = start_ns;
+        }
+
+        auto& llrs = scratch[w];
+        long long errors = 0;
+        for (size_t t = 0; t < ttis; ++t) {
+            const int64_t release = start + static_cast<int64_t>(t) * config.tti_ns;
+            sleep_until(release);
+            wake_ns[w * ttis + t] = now_ns();
+
+            TRACE_SPAN("tti");
+            for (size_t k = w; k < reports; k += workers) {
+                const size_t index = (t * reports + k) % POOL_SIZE;
+                std::copy_n(pool.llrs.begin() + index * CODEWORD_SIZE, CODEWORD_SIZE, llrs.begin());
+                errors += decoders[pool.sizes[index]](llrs) != pool.tx_bits[index];
+            }
+            finish_ns[w * ttis + t] = now_ns();
+        }
+        failed[w] = errors;
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t w = 0; w < workers; ++w) {
+        threads.emplace_back(worker, w);
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return ready == workers; });
+        start_ns = now_ns() + START_DELAY_NS;
+    }
+    cv.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    result.ttis = config.ttis;
+    result.reports = config.ttis * config.reports_per_tti;
+    result.pinned = config.pin && std::all_of(pinned.begin(), pinned.end(), [](uint8_t v) { return v != 0; });
+    result.fifo = config.fifo_priority > 0 && std::all_of(fifo.begin(), fifo.end(), [](uint8_t v) { return v != 0; });
+    for (long long errors : failed) {
+        result.failed += errors;
+    }
+
+    for (size_t t = 0; t < ttis; ++t) {
+        const int64_t release = start_ns + static_cast<int64_t>(t) * config.tti_ns;
+        const int64_t deadline = release + config.tti_ns;
+
+        int64_t completion = release;
+        for (size_t w = 0; w < workers; ++w) {
+            completion = std::max(completion, finish_ns[w * ttis + t]);
+            result.wakeup.record(static_cast<uint64_t>(std::max<int64_t>(0, wake_ns[w * ttis + t] - release)));
+        }
+
+        result.processing.record(static_cast<uint64_t>(completion - release));
+        if (completion > deadline) {
+            ++result.misses;
+            result.lateness.record(static_cast<uint64_t>(completion - deadline));
+        } else {
+            result.slack.record(static_cast<uint64_t>(deadline - completion));
+        }
+    }
+
+    if (config.lock_memory) {
+        unlock_buffer(pool.sizes);
+        unlock_buffer(pool.tx_bits);
+        unlock_buffer(pool.llrs);
+        unlock_buffer(wake_ns);
+        unlock_buffer(finish_ns);
+        for (const auto& buffer : scratch) {
+            unlock_buffer(buffer);
+        }
+    }
+
+    return result;
+}
+
+RealtimeCapacity find_max_reports_per_tti(const RealtimeConfig& config, double max_miss_rate, int limit) {
+    if (limit <= 0) {
+        throw std::invalid_argument("lib/realtime.cpp: reports per TTI limit must be positive");
+    }
+
+    RealtimeCapacity capacity;
+    auto sustainable = [&](int reports) {
+        RealtimeConfig probe = config;
+        probe.reports_per_tti = reports;
+        const RealtimeResult result = run_realtime(probe);
+        capacity.probes.push_back({reports, result.ttis, result.misses});
+        return static_cast<double>(result.misses) <= max_miss_rate * static_cast<double>(result.ttis);
+    };
+
+    // `low` is known to be sustainable, `high` is known not to be (or is past the limit).
+    int low = 0;
+    int high = limit + 1;
+    for (int reports = 1; reports <= limit; reports *= 2) {
+        if (!sustainable(reports)) {
+            high = reports;
+            break;
+        }
+        low = reports;
+        if (reports > limit / 2) {
+            break;
+        }
+    }
+
+    while (high - low > 1) {
+        const int middle = low + (high - low) / 2;
+        if (sustainable(middle)) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    capacity.max_reports_per_tti = low;
+    return capacity;
+}
+
+} // namespace qpsk
@@ -0,0 +1,289 @@
+#include "shard_queue.hpp"
+#include "simulation.hpp"
+#include "random_bits.hpp"
+#include "bler_bounds.hpp"
+#include "utils/file_utils.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace qpsk {
+
+namespace {
+
+std::string shard_name(int id) {
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%06d", id);
+    return buf;
+}
+
+std::string lease_owner() {
+    char host[64] = {};
+    gethostname(host, sizeof(host) - 1);
+    return std::string(host) + " " + std::to_string(getpid()) + "\n";
+}
+
+json load_json(const std::string& path) {
+    return json::parse(read_file(path));
+}
+
+bool lease_expired(const std::string& path, double lease_timeout_s) {
+    std::error_code ec;
+    auto mtime = fs::last_write_time(path, ec);
+    if (ec) {
+        return false;
+    }
+    auto age = fs::file_time_type::clock::now() - mtime;
+    return std::chrono::duration<double>(age).count() > lease_timeout_s;
+}
+
+} // namespace
+
+uint64_t shard_seed(uint64_t job_seed, int shard_id) {
+    return derive_seed(job_seed, static_cast<uint64_t>(shard_id));
+}
+
+std::string ShardQueue::shard_path(int id) const {
+    return dir_ + "/shards/" + shard_name(id) + ".json";
+}
+
+std::string ShardQueue::lease_path(int id) const {
+    return dir_ + "/leases/" + shard_name(id) + ".lease";
+}
+
+std::string ShardQueue::result_path(int id) const {
+    return dir_ + "/results/" + shard_name(id) + ".json";
+}
+
+bool ShardQueue::exists() const {
+    return fs::exists(dir_ + "/job.json");
+}
+
+void ShardQueue::create(const ShardJob& job) const {
+    if (job.sizes.empty() || job.snrs_db.empty() || job.iterations <= 0 || job.shard_size <= 0) {
+        throw std::invalid_argument("lib/shard_queue.cpp: empty job or non-positive iterations/shard_size");
+    }
+    if (exists()) {
+        throw std::invalid_argument("lib/shard_queue.cpp: queue already exists in " + dir_);
+    }
+
+    fs::create_directories(dir_ + "/shards");
+    fs::create_directories(dir_ + "/leases");
+    fs::create_directories(dir_ + "/results");
+
+    int id = 0;
+    for (int n : job.sizes) {
+        for (double snr_db : job.snrs_db) {
+            for (long long first = 0; first < job.iterations; first += job.shard_size) {
+                json shard;
+                shard["id"] = id;
+                shard["num_of_pucch_f2_bits"] = n;
+                shard["snr_db"] = snr_db;
+                shard["first_trial"] = first;
+                shard["trials"] = std::min(job.shard_size, job.iterations - first);
+                shard["seed"] = shard_seed(job.seed, id);
+                shard["decoder"] = job.decoder;
+                write_file_atomic(shard_path(id), shard.dump(2) + "\n");
+                ++id;
+            }
+        }
+    }
+
+    json desc;
+    desc["num_of_pucch_f2_bits"] = job.sizes;
+    desc["snr_db"] = job.snrs_db;
+    desc["iterations"] = job.iterations;
+    desc["shard_size"] = job.shard_size;
+    desc["seed"] = job.seed;
+    desc["decoder"] = job.decoder;
+    desc["shard_count"] = id;
+
+    // job.json is written last: its presence marks the queue as ready.
+    write_file_atomic(dir_ + "/job.json", desc.dump(2) + "\n");
+}
+
+ShardJob ShardQueue::job() const {
+    json desc = load_json(dir_ + "/job.json");
+
+    ShardJob job;
+    job.sizes = desc["num_of_pucch_f2_bits"].get<std::vector<int>>();
+    job.snrs_db = desc["snr_db"].get<std::vector<double>>();
+    job.iterations = desc["iterations"];
+    job.shard_size = desc["shard_size"];
+    job.seed = desc["seed"];
+    job.decoder = desc.value("decoder", "");
+    return job;
+}
+
+int ShardQueue::shard_count() const {
+    return load_json(dir_ + "/job.json")["shard_count"];
+}
+
+ShardSpec ShardQueue::shard(int id) const {
+    json shard = load_json(shard_path(id));
+
+    ShardSpec spec;
+    spec.id = shard["id"];
+    spec.n = shard["num_of_pucch_f2_bits"];
+    spec.snr_db = shard["snr_db"];
+    spec.first_trial = shard["first_trial"];
+    spec.trials = shard["trials"];
+    spec.seed = shard["seed"];
+    spec.decoder = shard.value("decoder", "");
+    return spec;
+}
+
+std::optional<ShardSpec> ShardQueue::claim(double lease_timeout_s) const {
+    const int count = shard_count();
+    const std::string owner = lease_owner();
+
+    for (int id = 0; id < count; ++id) {
+        if (fs::exists(result_path(id))) {
+            continue;
+        }
+
+        const std::string lease = lease_path(id);
+        int fd = open(lease.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+        if (fd >= 0) {
+            ssize_t written = write(fd, owner.data(), owner.size());
+            (void)written;
+            close(fd);
+        } else if (errno == EEXIST) {
+            if (!lease_expired(lease, lease_timeout_s)) {
+                continue;
+            }
+            // Stale lease: take it over. Two workers may race here, which is
+            // harmless because shard results are deterministic.
+            write_file_atomic(lease, owner);
+        } else {
+            throw std::runtime_error("lib/shard_queue.cpp: cannot create lease " + lease +
+                                     ": " + std::strerror(errno));
+        }
+
+        if (fs::exists(result_path(id))) {
+            fs::remove(lease);
+            continue;
+        }
+
+        return shard(id);
+    }
+
+    return std::nullopt;
+}
+
+void ShardQueue::complete(const ShardResult& result) const {
+    json out;
+    out["id"] = result.id;
+    out["num_of_pucch_f2_bits"] = result.n;
+    out["snr_db"] = result.snr_db;
+    out["success"] = result.success;
+    out["failed"] = result.failed;
+
+    write_file_atomic(result_path(result.id), out.dump(2) + "\n");
+
+    std::error_code ec;
+    fs::remove(lease_path(result.id), ec);
+}
+
+std::vector<ShardResult> ShardQueue::results() const {
+    std::vector<ShardResult> out;
+    const int count = shard_count();
+
+    for (int id = 0; id < count; ++id) {
+        if (!fs::exists(result_path(id))) {
+            continue;
+        }
+        json r = load_json(result_path(id));
+
+        ShardResult result;
+        result.id = r["id"];
+        result.n = r["num_of_pucch_f2_bits"];
+        result.snr_db = r["snr_db"];
+        result.success = r["success"];
+        result.failed = r["failed"];
+        out.push_back(result);
+    }
+
+    return out;
+}
+
+json ShardQueue::merge() const {
+    const ShardJob desc = job();
+    const auto partial = results();
+
+    std::map<std::pair<int, double>, ShardResult> totals;
+    for (const auto& r : partial) {
+        auto& t = totals[{r.n, r.snr_db}];
+        t.success += r.success;
+        t.failed += r.failed;
+    }
+
+    json table = json::array();
+    for (int n : desc.sizes) {
+        for (double snr_db : desc.snrs_db) {
+            const auto& t = totals[{n, snr_db}];
+            const long long trials = t.success + t.failed;
+
+            json row;
+            row["num_of_pucch_f2_bits"] = n;
+            row["snr_db"] = snr_db;
+            row["bler"] = trials > 0 ? static_cast<double>(t.failed) / trials : 0.0;
+            row["success"] = t.success;
+            row["failed"] = t.failed;
+            row["union_bound_bler"] = union_bound_bler(n, snr_db);
+            row["tangential_sphere_bound_bler"] = tangential_sphere_bound_bler(n, snr_db);
+            table.push_back(row);
+        }
+    }
+
+    const int count = shard_count();
+
+    json output;
+    output["mode"] = "sharded simulation";
+    output["complete"] = static_cast<int>(partial.size()) == count;
+    output["shards"] = count;
+    output["completed_shards"] = partial.size();
+    output["results"] = table;
+    return output;
+}
+
+ShardResult run_shard(const ShardSpec& spec) {
+    SimulationConfig config;
+    config.n = spec.n;
+    config.snr_db = spec.snr_db;
+    config.iterations = spec.trials;
+    config.seed = spec.seed;
+    config.decoder = spec.decoder;
+
+    SimulationResult sim = simulate(config);
+
+    ShardResult result;
+    result.id = spec.id;
+    result.n = spec.n;
+    result.snr_db = spec.snr_db;
+    result.success = sim.success;
+    result.failed = sim.failed;
+    return result;
+}
+
+int run_shard_worker(const ShardQueue& queue, double lease_timeout_s) {
+    int completed = 0;
+
+    while (auto spec = queue.claim(lease_timeout_s)) {
+        queue.complete(run_shard(*spec));
+        ++completed;
+    }
+
+    return completed;
+}
+
+} // namespace qpsk
@@ -0,0 +1,240 @@
+#include "simulation.hpp"
+#include "encoder.hpp"
+#include "qpsk.hpp"
+#include "channel.hpp"
+#include "random_bits.hpp"
+#include "decoder_registry.hpp"
+#include "decoder_tuner.hpp"
+#include "early_exit_decoder.hpp"
+#include "codebook.hpp"
+#include "fixed_point_decoder.hpp"
+#include "simd_fixed_point_decoder.hpp"
+#include "utils/trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+namespace qpsk {
+
+#ifdef __AVX2__
+template<int N>
+using QuantizedDecoder = SimdFixedPointDecoder<N>;
+#else
+template<int N>
+using QuantizedDecoder = FixedPointDecoder<N>;
+#endif
+
+template<int N>
+SimulationResult process_simulation(const SimulationConfig& config) {
+    BlockEncoder<N> code;
+
+    using Clock = std::chrono::steady_clock;
+
+    std::unique_ptr<AbstractDecoder<N>> decoder =
+        make_decoder<N>(config.decoder.empty() ? select_decoder(N) : config.decoder, config.decoder_options);
+    std::unique_ptr<AbstractDecoder<N>> ml_decoder;
+    if (config.compare_to_ml) {
+        ml_decoder = make_decoder<N>(select_decoder(N));
+    }
+    std::unique_ptr<AbstractDecoder<N>> full_search;
+    if (!config.known_bits.empty()) {
+        full_search = std::move(decoder);
+        decoder = std::make_unique<KnownBitsDecoder<N>>(config.known_bits);
+    }
+    std::optional<BlindDetector> blind;
+    // Words below this are also words of the next smaller candidate size.
+    unsigned long ambiguous_below = 0;
+    if (!config.blind_sizes.empty()) {
+        blind.emplace(config.blind_sizes, config.blind_margin);
+        const auto& sizes = blind->sizes();
+        const auto it = std::find(sizes.begin(), sizes.end(), N);
+        if (it == sizes.end()) {
+            throw std::invalid_argument("lib/simulation.cpp: blind detection sizes must include num_of_pucch_f2_bits");
+        }
+        ambiguous_below = it == sizes.begin() ? 0 : 1UL << *(it - 1);
+    }
+    std::unique_ptr<EarlyExitDecoder<N>> early_exit;
+    if (config.early_exit) {
+        early_exit = std::make_unique<EarlyExitDecoder<N>>(std::move(decoder));
+    }
+    QPSK mod;
+    Channel channel(config.snr_db);
+    std::mt19937 rng = make_rng(config.seed);
+
+    // Decision and its metric, the DTX statistic. DTX needs no runner-up, so
+    // with early exit the metric comes straight from the decided codeword and
+    // the shortcut still skips the search.
+    auto dtx_decide = [&](const std::vector<double>& llrs, double& metric, bool& hit) {
+        if (early_exit) {
+            const std::bitset<N> bits = early_exit->decode(llrs, hit);
+            metric = codeword_metric(packed_codebook<N>()[bits.to_ulong()], llrs);
+            return bits;
+        }
+        const auto full = decoder->decode_full(llrs);
+        metric = full.best_metric;
+        return full.bits;
+    };
+
+    const size_t widths = config.quantization_bits.size();
+    std::vector<double> scales;
+    for (int bits : config.quantization_bits) {
+        scales.push_back(QPSK::quantization_scale(config.snr_db, bits));
+    }
+    // Its mask tables are large for N=11; built only when quantization is simulated.
+    std::optional<QuantizedDecoder<N>> quantized_decoder;
+    if (widths > 0) {
+        quantized_decoder.emplace();
+    }
+
+    SimulationResult result;
+    result.quantized_failed.assign(widths, 0);
+    if (blind) {
+        result.blind_selected.assign(blind->sizes().size(), 0);
+    }
+
+    std::optional<ErrorCapture> capture;
+    if (config.capture.enabled()) {
+        capture.emplace(config.capture);
+    }
+
+    for (long long i = 0; i < config.iterations; ++i) {
+        TRACE_SPAN_SAMPLED("trial");
+        std::bitset<N> tx_bits;
+        {
+            TRACE_SPAN_SAMPLED("bits");
+            tx_bits = generate_random_bits<N>(rng);
+        }
+        if (full_search) {
+            tx_bits = std::bitset<N>(config.known_bits.apply(static_cast<uint32_t>(tx_bits.to_ulong())));
+        }
+
+        std::bitset<CODEWORD_SIZE> cw;
+        {
+            TRACE_SPAN_SAMPLED("encode");
+            cw = code.encode(tx_bits);
+        }
+        std::vector<Complex> symbols;
+        {
+            TRACE_SPAN_SAMPLED("modulate");
+            symbols = mod.modulate(cw);
+        }
+
+        std::vector<Complex> rx_symbols;
+        {
+            TRACE_SPAN_SAMPLED("channel");
+            rx_symbols = channel.apply(symbols, rng);
+        }
+
+        std::vector<double> llrs;
+        {
+            TRACE_SPAN_SAMPLED("demodulate");
+            llrs = mod.demodulate(rx_symbols);
+        }
+        const auto start = ml_decoder ? Clock::now() : Clock::time_point();
+        std::bitset<N> rx_bits;
+        {
+            TRACE_SPAN_SAMPLED("decode");
+            if (config.dtx_threshold) {
+                bool hit = false;
+                double metric = 0.0;
+                rx_bits = dtx_decide(llrs, metric, hit);
+                result.early_exits += hit;
+                result.missed_detections += normalized_correlation(metric, llrs) < *config.dtx_threshold;
+            } else if (early_exit) {
+                bool hit = false;
+                rx_bits = early_exit->decode(llrs, hit);
+                result.early_exits += hit;
+            } else {
+                rx_bits = decoder->decode(llrs);
+            }
+        }
+        // decode_ns covers the decision alone, not the side statistics below.
+        const auto decoded_at = ml_decoder ? Clock::now() : Clock::time_point();
+
+        if (blind) {
+            const BlindDetection detection = blind->detect(llrs);
+            const SizeHypothesis& decision = detection.decision();
+            ++result.blind_selected[detection.selected];
+            result.blind_failed += decision.n != N || decision.bits != tx_bits.to_ulong();
+            result.blind_ambiguous += tx_bits.to_ulong() < ambiguous_below;
+        }
+
+        if (full_search) {
+            result.full_search_failed += full_search->decode(llrs) != tx_bits;
+        }
+
+        if (ml_decoder) {
+            const auto ml_start = Clock::now();
+            const auto ml_bits = ml_decoder->decode(llrs);
+            const auto end = Clock::now();
+
+            result.decode_ns += std::chrono::duration<double, std::nano>(decoded_at - start).count();
+            result.ml_decode_ns += std::chrono::duration<double, std::nano>(end - ml_start).count();
+            result.ml_failed += ml_bits != tx_bits;
+            result.disagreements += ml_bits != rx_bits;
+        }
+
+        const bool failed = tx_bits != rx_bits;
+        if (failed) {
+            ++result.failed;
+        } else {
+            ++result.success;
+        }
+
+        if (capture && capture->wants(failed)) {
+            capture->record<N>(i, config.snr_db, tx_bits, rx_bits, llrs);
+        }
+
+        for (size_t q = 0; q < widths; ++q) {
+            auto quantized = mod.demodulate_quantized(rx_symbols, config.quantization_bits[q], scales[q]);
+            if (quantized_decoder->decode_quantized(quantized) != tx_bits) {
+                ++result.quantized_failed[q];
+            }
+        }
+    }
+
+    if (config.dtx_threshold) {
+        result.dtx_trials = config.dtx_trials > 0 ? config.dtx_trials : config.iterations;
+        for (long long i = 0; i < result.dtx_trials; ++i) {
+            const auto llrs = mod.demodulate(channel.noise(QPSK_SYMBOLS_COUNT, rng));
+            bool hit = false;
+            double metric = 0.0;
+            dtx_decide(llrs, metric, hit);
+            result.false_alarms += normalized_correlation(metric, llrs) >= *config.dtx_threshold;
+        }
+    }
+
+    if (capture) {
+        result.capture = capture->dump();
+    }
+    if (ml_decoder) {
+        result.ml_decoder = ml_decoder->name();
+    }
+    return result;
+}
+
+SimulationResult simulate(const SimulationConfig& config) {
+    if (config.engine == "pipelined") {
+        return simulate_pipelined(config);
+    }
+    if (!config.engine.empty() && config.engine != "serial") {
+        throw std::invalid_argument("lib/simulation.cpp: unknown engine " + config.engine);
+    }
+    // The early-exit fast path accepts any codeword, including ones the known bits rule out.
+    if (!config.known_bits.empty() && config.early_exit) {
+        throw std::invalid_argument("lib/simulation.cpp: known bits cannot be combined with early exit");
+    }
+
+    switch (config.n) {
+        case 2:  return process_simulation<2>(config);
+        case 4:  return process_simulation<4>(config);
+        case 6:  return process_simulation<6>(config);
+        case 8:  return process_simulation<8>(config);
+        case 11: return process_simulation<11>(config);
+        default:
+            throw std::invalid_argument("lib/simulation.cpp: invalid num_of_pucch_f2_bits");
+    }
+}
+
+} // namespace qpsk
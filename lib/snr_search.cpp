@@ -0,0 +1,218 @@
+#include "snr_search.hpp"
+#include "simulation.hpp"
+#include "random_bits.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+
+namespace qpsk {
+
+namespace {
+
+constexpr int MAX_BRACKET_STEPS = 8;
+constexpr long long MIN_BATCH = 64;
+// A handful of early failures at a point near the target is common; do not
+// let them alone classify the point as above the target.
+constexpr long long MIN_DECISION_FAILURES = 5;
+// Secant candidates are kept this fraction of the bracket away from its ends.
+constexpr double SECANT_MARGIN = 0.1;
+
+double log_bler(const SnrSearchPoint& point) {
+    return std::log((point.failed + 0.5) / (point.trials + 1.0));
+}
+
+double secant(const SnrSearchPoint& lo, const SnrSearchPoint& hi, double log_target) {
+    const double rise = log_bler(hi) - log_bler(lo);
+    if (!(rise < 0.0)) {
+        return 0.5 * (lo.snr_db + hi.snr_db);
+    }
+    return lo.snr_db + (log_target - log_bler(lo)) * (hi.snr_db - lo.snr_db) / rise;
+}
+
+// Runs doubling batches at one SNR until the Wilson interval either excludes
+// the target or is tight enough that the point cannot be classified.
+class PointEvaluator {
+public:
+    PointEvaluator(const SnrSearchConfig& config, double z)
+        : config_(config), z_(z),
+          initial_batch_(std::max(MIN_BATCH, static_cast<long long>(std::ceil(1.0 / config.target_bler)))) {}
+
+    SnrSearchPoint evaluate(double snr_db) {
+        SnrSearchPoint point;
+        point.snr_db = snr_db;
+
+        long long batch = initial_batch_;
+        while (used_ < config_.max_trials) {
+            SimulationConfig sim;
+            sim.n = config_.n;
+            sim.snr_db = snr_db;
+            sim.iterations = std::min(batch, config_.max_trials - used_);
+            sim.seed = derive_seed(config_.seed, stream_++);
+            sim.decoder = config_.decoder;
+
+            const SimulationResult run = simulate(sim);
+            point.trials += sim.iterations;
+            point.failed += run.failed;
+            used_ += sim.iterations;
+
+            const auto [low, high] = wilson_interval(point.failed, point.trials, z_);
+            if (low > config_.target_bler && point.failed >= MIN_DECISION_FAILURES) {
+                point.side = 1;
+                break;
+            }
+            if (high < config_.target_bler) {
+                point.side = -1;
+                break;
+            }
+            const double bler = static_cast<double>(point.failed) / point.trials;
+            if (point.failed > 0 && 0.5 * (high - low) <= config_.relative_precision * bler) {
+                break;
+            }
+            batch = point.trials;
+        }
+        return point;
+    }
+
+    long long used() const { return used_; }
+    bool exhausted() const { return used_ >= config_.max_trials; }
+
+private:
+    const SnrSearchConfig& config_;
+    double z_;
+    long long initial_batch_;
+    long long used_ = 0;
+    uint64_t stream_ = 0;
+};
+
+} // namespace
+
+double normal_quantile(double p) {
+    if (!(p > 0.0 && p < 1.0)) {
+        throw std::invalid_argument("lib/snr_search.cpp: quantile probability must be in (0, 1)");
+    }
+    double low = -40.0;
+    double high = 40.0;
+    for (int i = 0; i < 200; ++i) {
+        const double mid = 0.5 * (low + high);
+        if (0.5 * std::erfc(-mid / std::sqrt(2.0)) < p) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    return 0.5 * (low + high);
+}
+
+std::pair<double, double> wilson_interval(long long failed, long long trials, double z) {
+    if (trials <= 0) {
+        return {0.0, 1.0};
+    }
+    const double n = static_cast<double>(trials);
+    const double p = failed / n;
+    const double z2 = z * z;
+    const double center = (p + z2 / (2.0 * n)) / (1.0 + z2 / n);
+    const double half = z / (1.0 + z2 / n) * std::sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n));
+    return {std::max(0.0, center - half), std::min(1.0, center + half)};
+}
+
+SnrSearchResult search_snr(const SnrSearchConfig& config) {
+    if (!(config.target_bler > 0.0 && config.target_bler < 1.0)) {
+        throw std::invalid_argument("lib/snr_search.cpp: target BLER must be in (0, 1)");
+    }
+    if (!(config.snr_low_db < config.snr_high_db)) {
+        throw std::invalid_argument("lib/snr_search.cpp: SNR range must be increasing");
+    }
+    if (!(config.tolerance_db > 0.0) || !(config.relative_precision > 0.0) ||
+        !(config.confidence > 0.0 && config.confidence < 1.0)) {
+        throw std::invalid_argument("lib/snr_search.cpp: invalid search precision");
+    }
+    if (config.max_trials <= 0 || config.sweep_points < 1) {
+        throw std::invalid_argument("lib/snr_search.cpp: invalid trial budget");
+    }
+
+    const double z = normal_quantile(0.5 + 0.5 * config.confidence);
+    const double log_target = std::log(config.target_bler);
+    const double width = config.snr_high_db - config.snr_low_db;
+
+    SnrSearchResult result;
+    PointEvaluator evaluator(config, z);
+    auto evaluate = [&](double snr_db) {
+        result.points.push_back(evaluator.evaluate(snr_db));
+        return result.points.back();
+    };
+
+    SnrSearchPoint lo = evaluate(config.snr_low_db);
+    SnrSearchPoint hi = evaluate(config.snr_high_db);
+
+    for (int step = 0; lo.side != 1 && step < MAX_BRACKET_STEPS && !evaluator.exhausted(); ++step) {
+        if (lo.side == -1 && lo.snr_db < hi.snr_db) {
+            hi = lo;
+        }
+        lo = evaluate(lo.snr_db - width);
+    }
+    for (int step = 0; hi.side != -1 && step < MAX_BRACKET_STEPS && !evaluator.exhausted(); ++step) {
+        if (hi.side == 1 && hi.snr_db > lo.snr_db) {
+            lo = hi;
+        }
+        hi = evaluate(hi.snr_db + width);
+    }
+    if (lo.side != 1 || hi.side != -1) {
+        throw std::invalid_argument("lib/snr_search.cpp: cannot bracket target BLER");
+    }
+
+    std::optional<SnrSearchPoint> resolved;
+    int last_side = 0;
+    int repeats = 0;
+
+    while (hi.snr_db - lo.snr_db > config.tolerance_db && !evaluator.exhausted()) {
+        const double span = hi.snr_db - lo.snr_db;
+        double x = 0.5 * (lo.snr_db + hi.snr_db);
+        // Regula falsi stalls when one end keeps moving; fall back to bisection.
+        if (repeats < 2) {
+            x = std::clamp(secant(lo, hi, log_target),
+                           lo.snr_db + SECANT_MARGIN * span, hi.snr_db - SECANT_MARGIN * span);
+        }
+
+        const SnrSearchPoint point = evaluate(x);
+        if (point.side == 0) {
+            resolved = point;
+            break;
+        }
+
+        repeats = point.side == last_side ? repeats + 1 : 1;
+        last_side = point.side;
+        (point.side == 1 ? lo : hi) = point;
+    }
+
+    result.snr_low_db = lo.snr_db;
+    result.snr_high_db = hi.snr_db;
+    result.snr_db = std::clamp(secant(lo, hi, log_target), lo.snr_db, hi.snr_db);
+
+    // A point that cannot be classified pins the target within its Wilson
+    // interval; map that interval to SNR through the local log-BLER slope.
+    const double slope = (log_bler(hi) - log_bler(lo)) / (hi.snr_db - lo.snr_db);
+    if (resolved && slope < 0.0) {
+        const auto [low, high] = wilson_interval(resolved->failed, resolved->trials, z);
+        auto crossing = [&](double bler) {
+            return resolved->snr_db + (log_target - std::log(bler)) / slope;
+        };
+
+        result.snr_low_db = std::clamp(crossing(low), lo.snr_db, hi.snr_db);
+        result.snr_high_db = std::clamp(crossing(high), lo.snr_db, hi.snr_db);
+        result.snr_db = std::clamp(crossing(std::exp(log_bler(*resolved))),
+                                   result.snr_low_db, result.snr_high_db);
+    }
+
+    result.converged = !evaluator.exhausted() || hi.snr_db - lo.snr_db <= config.tolerance_db;
+    result.trials = evaluator.used();
+
+    const double t = config.target_bler;
+    const double per_point = z * z * (1.0 - t) / (t * config.relative_precision * config.relative_precision);
+    result.sweep_trials = config.sweep_points * static_cast<long long>(std::ceil(per_point));
+
+    return result;
+}
+
+} // namespace qpsk
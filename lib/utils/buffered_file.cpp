@@ -0,0 +1,77 @@
+#include "utils/buffered_file.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace qpsk {
+
+BufferedFile::BufferedFile(const std::string& path, size_t buffer_bytes)
+    : path_(path), tmp_(path + ".tmp." + std::to_string(getpid())), buffer_(buffer_bytes) {
+    fd_ = open(tmp_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("lib/utils/buffered_file.cpp: cannot open " + tmp_);
+    }
+}
+
+BufferedFile::~BufferedFile() {
+    if (fd_ >= 0) {
+        close(fd_);
+        unlink(tmp_.c_str());
+    }
+}
+
+void BufferedFile::append(const void* data, size_t bytes) {
+    if (used_ + bytes > buffer_.size()) {
+        flush();
+    }
+    // Larger than the whole buffer: write it through.
+    if (bytes > buffer_.size()) {
+        write_all(static_cast<const char*>(data), bytes);
+        written_ += bytes;
+        return;
+    }
+    std::memcpy(buffer_.data() + used_, data, bytes);
+    used_ += bytes;
+}
+
+size_t BufferedFile::commit() {
+    flush();
+    if (close(fd_) != 0) {
+        fd_ = -1;
+        unlink(tmp_.c_str());
+        throw std::runtime_error("lib/utils/buffered_file.cpp: cannot write " + tmp_);
+    }
+    fd_ = -1;
+    if (std::rename(tmp_.c_str(), path_.c_str()) != 0) {
+        unlink(tmp_.c_str());
+        throw std::runtime_error("lib/utils/buffered_file.cpp: cannot rename " + tmp_ + " to " + path_);
+    }
+    return written_;
+}
+
+void BufferedFile::flush() {
+    write_all(buffer_.data(), used_);
+    written_ += used_;
+    used_ = 0;
+}
+
+void BufferedFile::write_all(const char* data, size_t bytes) {
+    size_t done = 0;
+    while (done < bytes) {
+        const ssize_t n = write(fd_, data + done, bytes - done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            throw std::runtime_error("lib/utils/buffered_file.cpp: cannot write " + tmp_);
+        }
+        done += static_cast<size_t>(n);
+    }
+}
+
+} // namespace qpsk
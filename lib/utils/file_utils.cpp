@@ -0,0 +1,46 @@
+#include "utils/file_utils.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstdio>
+
+#include <unistd.h>
+
+namespace qpsk {
+
+void write_file_atomic(const std::string& path, const std::string& content) {
+    char host[64] = {};
+    gethostname(host, sizeof(host) - 1);
+    const std::string tmp = path + ".tmp." + host + "." + std::to_string(getpid());
+
+    {
+        std::ofstream ofs(tmp, std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open()) {
+            throw std::runtime_error("lib/utils/file_utils.cpp: cannot open " + tmp);
+        }
+        ofs << content;
+        ofs.flush();
+        if (!ofs) {
+            throw std::runtime_error("lib/utils/file_utils.cpp: cannot write " + tmp);
+        }
+    }
+
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        throw std::runtime_error("lib/utils/file_utils.cpp: cannot rename " + tmp + " to " + path);
+    }
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs.is_open()) {
+        throw std::runtime_error("lib/utils/file_utils.cpp: cannot open " + path);
+    }
+
+    std::ostringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+} // namespace qpsk
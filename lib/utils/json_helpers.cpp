@@ -39,4 +39,15 @@ std::string format_complex(const Complex& c) {
     }
 }
 
+template<typename T>
+std::vector<T> scalar_or_array(const json& value) {
+    if (value.is_array()) {
+        return value.get<std::vector<T>>();
+    }
+    return {value.get<T>()};
+}
+
+template std::vector<int> scalar_or_array<int>(const json& value);
+template std::vector<double> scalar_or_array<double>(const json& value);
+
 } // namespace qpsk
@@ -0,0 +1,72 @@
+#include "utils/latency_histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace qpsk {
+
+size_t LatencyHistogram::bucket_index(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+
+    const int msb = 63 - __builtin_clzll(value);
+    const int shift = msb - (SUB_BUCKET_BITS - 1);
+    const size_t sub = static_cast<size_t>(value >> shift);
+
+    return static_cast<size_t>(shift) * HALF_SUB_BUCKETS + sub;
+}
+
+uint64_t LatencyHistogram::bucket_upper(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+
+    const size_t shift = index / HALF_SUB_BUCKETS - 1;
+    const uint64_t sub = index % HALF_SUB_BUCKETS + HALF_SUB_BUCKETS;
+
+    return ((sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value) {
+    ++counts_[bucket_index(value)];
+    ++count_;
+    sum_ += value;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::reset() {
+    *this = LatencyHistogram();
+}
+
+uint64_t LatencyHistogram::percentile(double p) const {
+    if (count_ == 0) {
+        return 0;
+    }
+
+    const double clamped = std::clamp(p, 0.0, 100.0);
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * count_)));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            return std::min(bucket_upper(i), max_);
+        }
+    }
+
+    return max_;
+}
+
+} // namespace qpsk
@@ -0,0 +1,214 @@
+#include "utils/trace.hpp"
+#include "utils/file_utils.hpp"
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace qpsk {
+
+namespace trace_detail {
+
+std::atomic<bool> enabled{false};
+
+} // namespace trace_detail
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    uint64_t start_ticks;
+    uint64_t end_ticks;
+};
+
+// Written only by its thread; read by stop_tracing() once recording is off.
+struct ThreadTrace {
+    uint32_t tid = 0;
+    std::string name;
+    std::vector<TraceEvent> events;
+    size_t count = 0;
+    size_t dropped = 0;
+};
+
+struct Session {
+    bool active = false;
+    TraceConfig config;
+    uint64_t start_ticks = 0;
+    std::vector<std::unique_ptr<ThreadTrace>> threads;
+};
+
+std::mutex session_mutex;
+Session session;
+// Bumped on start and stop so threads re-register instead of writing into
+// buffers of an earlier session.
+std::atomic<uint64_t> session_id{0};
+std::atomic<uint32_t> sample_period{1};
+
+struct ThreadState {
+    ThreadTrace* trace = nullptr;
+    uint64_t session = 0;
+    // Open sampled spans and the decision of the outermost one.
+    int sampled_depth = 0;
+    bool sampled_keep = false;
+    uint32_t rng = 0;
+};
+
+thread_local ThreadState thread_state;
+
+ThreadTrace& thread_trace() {
+    ThreadState& state = thread_state;
+    const uint64_t id = session_id.load(std::memory_order_acquire);
+    if (state.session != id || state.trace == nullptr) {
+        std::lock_guard<std::mutex> lock(session_mutex);
+        auto trace = std::make_unique<ThreadTrace>();
+        trace->tid = static_cast<uint32_t>(session.threads.size()) + 1;
+        trace->name = "thread " + std::to_string(trace->tid);
+        trace->events.resize(session.config.buffer_spans);
+        state.trace = trace.get();
+        state.session = id;
+        // Any non-zero xorshift seed; distinct per thread.
+        state.rng = 0x9e3779b9U * trace->tid;
+        session.threads.push_back(std::move(trace));
+    }
+    return *state.trace;
+}
+
+double ticks_to_us(uint64_t ticks) {
+    return static_cast<double>(ticks) / tsc_ticks_per_ns() / 1000.0;
+}
+
+} // namespace
+
+namespace trace_detail {
+
+bool enter_sampled() {
+    ThreadState& state = thread_state;
+    if (state.sampled_depth++ == 0) {
+        const uint32_t period = sample_period.load(std::memory_order_relaxed);
+        if (period <= 1) {
+            state.sampled_keep = true;
+        } else {
+            thread_trace();
+            uint32_t x = state.rng;
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            state.rng = x;
+            state.sampled_keep = x % period == 0;
+        }
+    }
+    return state.sampled_keep;
+}
+
+void leave_sampled() {
+    --thread_state.sampled_depth;
+}
+
+void record(const char* name, uint64_t start_ticks, uint64_t end_ticks) {
+    if (!enabled.load(std::memory_order_relaxed)) {
+        return;
+    }
+    ThreadTrace& trace = thread_trace();
+    if (trace.count == trace.events.size()) {
+        ++trace.dropped;
+        return;
+    }
+    trace.events[trace.count++] = {name, start_ticks, end_ticks};
+}
+
+} // namespace trace_detail
+
+TraceConfig parse_trace_config(const json& spec) {
+    TraceConfig config;
+    if (spec.is_string()) {
+        config.file = spec.get<std::string>();
+        return config;
+    }
+    if (!spec.is_object() || !spec.contains("file") || !spec["file"].is_string()) {
+        throw std::invalid_argument("lib/utils/trace.cpp: trace must be a file name or {\"file\": ...}");
+    }
+    config.file = spec["file"].get<std::string>();
+    config.sample_period = spec.value("sample_period", config.sample_period);
+    config.buffer_spans = spec.value("buffer_spans", config.buffer_spans);
+    return config;
+}
+
+void start_tracing(const TraceConfig& config) {
+    if (config.file.empty()) {
+        throw std::invalid_argument("lib/utils/trace.cpp: trace file is empty");
+    }
+    if (config.sample_period == 0 || config.buffer_spans == 0) {
+        throw std::invalid_argument("lib/utils/trace.cpp: sample period and buffer size must be positive");
+    }
+
+    trace_detail::enabled.store(false, std::memory_order_relaxed);
+    // Calibrate outside any span.
+    tsc_ticks_per_ns();
+    {
+        std::lock_guard<std::mutex> lock(session_mutex);
+        session.active = true;
+        session.config = config;
+        session.threads.clear();
+        session.start_ticks = read_tsc();
+        sample_period.store(config.sample_period, std::memory_order_relaxed);
+        session_id.fetch_add(1, std::memory_order_release);
+    }
+    thread_trace().name = "main";
+    trace_detail::enabled.store(true, std::memory_order_release);
+}
+
+TraceSummary stop_tracing() {
+    trace_detail::enabled.store(false, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(session_mutex);
+    if (!session.active) {
+        throw std::logic_error("lib/utils/trace.cpp: tracing was not started");
+    }
+    session.active = false;
+
+    json events = json::array();
+    events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", 1}, {"args", {{"name", "qpsk"}}}});
+
+    TraceSummary summary;
+    summary.threads = session.threads.size();
+    for (const auto& trace : session.threads) {
+        events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", trace->tid},
+                          {"args", {{"name", trace->name}}}});
+        for (size_t i = 0; i < trace->count; ++i) {
+            const TraceEvent& event = trace->events[i];
+            // Opened before this session started.
+            if (event.start_ticks < session.start_ticks) {
+                continue;
+            }
+            events.push_back({{"name", event.name},
+                              {"cat", "qpsk"},
+                              {"ph", "X"},
+                              {"ts", ticks_to_us(event.start_ticks - session.start_ticks)},
+                              {"dur", ticks_to_us(event.end_ticks - event.start_ticks)},
+                              {"pid", 1},
+                              {"tid", trace->tid}});
+        }
+        summary.spans += trace->count;
+        summary.dropped += trace->dropped;
+    }
+
+    json output;
+    output["traceEvents"] = std::move(events);
+    output["displayTimeUnit"] = "ns";
+    output["otherData"] = {{"sample_period", session.config.sample_period},
+                           {"buffer_spans", session.config.buffer_spans},
+                           {"dropped_spans", summary.dropped}};
+
+    session.threads.clear();
+    session_id.fetch_add(1, std::memory_order_release);
+    write_file_atomic(session.config.file, output.dump() + "\n");
+    return summary;
+}
+
+void set_trace_thread_name(const std::string& name) {
+    if (tracing_enabled()) {
+        thread_trace().name = name;
+    }
+}
+
+} // namespace qpsk
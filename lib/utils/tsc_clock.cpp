@@ -0,0 +1,34 @@
+#include "utils/tsc_clock.hpp"
+
+#include <chrono>
+
+namespace qpsk {
+
+namespace {
+
+constexpr auto CALIBRATION_TIME = std::chrono::milliseconds(50);
+
+double calibrate() {
+    using clock = std::chrono::steady_clock;
+
+    const auto start = clock::now();
+    const uint64_t start_ticks = read_tsc();
+
+    auto now = start;
+    while (now - start < CALIBRATION_TIME) {
+        now = clock::now();
+    }
+    const uint64_t end_ticks = read_tsc();
+
+    const double ns = std::chrono::duration<double, std::nano>(now - start).count();
+    return static_cast<double>(end_ticks - start_ticks) / ns;
+}
+
+} // namespace
+
+double tsc_ticks_per_ns() {
+    static const double ticks_per_ns = calibrate();
+    return ticks_per_ns;
+}
+
+} // namespace qpsk
@@ -0,0 +1,103 @@
+#include "utils/work_stealing_pool.hpp"
+
+namespace qpsk {
+
+WorkStealingPool::WorkStealingPool(size_t threads) {
+    if (threads == 0) {
+        threads = 1;
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    task_ready_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::submit(size_t worker, std::function<void()> task) {
+    // Counted before it becomes visible, so a worker that takes it at once
+    // cannot decrement queued_ first.
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++queued_;
+    }
+    Queue& queue = *queues_[worker % queues_.size()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    task_ready_.notify_all();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    all_done_.wait(lock, [this] { return queued_ == 0 && active_ == 0; });
+}
+
+uint64_t WorkStealingPool::steals() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return steals_;
+}
+
+bool WorkStealingPool::take(size_t self, std::function<void()>& task) {
+    for (size_t k = 0; k < queues_.size(); ++k) {
+        Queue& queue = *queues_[(self + k) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            continue;
+        }
+
+        if (k == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+
+        std::lock_guard<std::mutex> state(mutex_);
+        --queued_;
+        ++active_;
+        steals_ += k != 0;
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::worker_loop(size_t self) {
+    for (;;) {
+        std::function<void()> task;
+        if (!take(self, task)) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            task_ready_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+            if (stopping_ && queued_ == 0) {
+                return;
+            }
+            continue;
+        }
+
+        task();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --active_;
+            if (queued_ == 0 && active_ == 0) {
+                all_done_.notify_all();
+            }
+        }
+    }
+}
+
+} // namespace qpsk
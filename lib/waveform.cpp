@@ -0,0 +1,239 @@
+#include "waveform.hpp"
+#include "encoder.hpp"
+#include "qpsk.hpp"
+#include "channel.hpp"
+#include "random_bits.hpp"
+#include "utils/buffered_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace qpsk {
+
+namespace {
+
+struct Cf32 { float re, im; };
+struct Cf64 { double re, im; };
+struct Ci16 { int16_t re, im; };
+
+static_assert(sizeof(Cf32) == 8 && sizeof(Cf64) == 16 && sizeof(Ci16) == 4, "IQ samples must be packed pairs");
+
+template <typename Sample>
+Sample to_sample(const Complex& s, double ci16_scale);
+
+template <>
+Cf32 to_sample<Cf32>(const Complex& s, double) {
+    return {static_cast<float>(s.real()), static_cast<float>(s.imag())};
+}
+
+template <>
+Cf64 to_sample<Cf64>(const Complex& s, double) {
+    return {s.real(), s.imag()};
+}
+
+template <>
+Ci16 to_sample<Ci16>(const Complex& s, double ci16_scale) {
+    auto level = [ci16_scale](double value) {
+        return static_cast<int16_t>(std::clamp(std::nearbyint(value * ci16_scale), -32767.0, 32767.0));
+    };
+    return {level(s.real()), level(s.imag())};
+}
+
+// Read-only mapping of a packed message file.
+class MessageFile {
+public:
+    explicit MessageFile(const std::string& path) {
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("lib/waveform.cpp: cannot open " + path);
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size % sizeof(uint16_t) != 0) {
+            close(fd);
+            throw std::invalid_argument("lib/waveform.cpp: message file size must be a multiple of 2: " + path);
+        }
+        bytes_ = static_cast<size_t>(st.st_size);
+        if (bytes_ > 0) {
+            data_ = mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        if (data_ == MAP_FAILED) {
+            data_ = nullptr;
+            throw std::runtime_error("lib/waveform.cpp: cannot map " + path);
+        }
+        if (data_ != nullptr) {
+            madvise(data_, bytes_, MADV_SEQUENTIAL);
+        }
+    }
+
+    ~MessageFile() {
+        if (data_ != nullptr) {
+            munmap(data_, bytes_);
+        }
+    }
+
+    MessageFile(const MessageFile&) = delete;
+    MessageFile& operator=(const MessageFile&) = delete;
+
+    const uint16_t* data() const { return static_cast<const uint16_t*>(data_); }
+    long long size() const { return static_cast<long long>(bytes_ / sizeof(uint16_t)); }
+
+private:
+    void* data_ = nullptr;
+    size_t bytes_ = 0;
+};
+
+template <int N, typename Sample>
+void generate(const WaveformConfig& config, const uint16_t* messages, long long count,
+              BufferedFile& out, BufferedFile* saved) {
+    constexpr uint32_t WORDS = 1U << N;
+
+    // Modulated symbols of every message, as Complex for the channel and in
+    // the output layout for the clean path.
+    BlockEncoder<N> code;
+    QPSK mod;
+    std::vector<Complex> symbols(WORDS * QPSK_SYMBOLS_COUNT);
+    std::vector<Sample> samples(WORDS * QPSK_SYMBOLS_COUNT);
+    for (uint32_t m = 0; m < WORDS; ++m) {
+        const auto block = mod.modulate(code.encode(std::bitset<N>(m)));
+        for (size_t k = 0; k < QPSK_SYMBOLS_COUNT; ++k) {
+            symbols[m * QPSK_SYMBOLS_COUNT + k] = block[k];
+            samples[m * QPSK_SYMBOLS_COUNT + k] = to_sample<Sample>(block[k], config.ci16_scale);
+        }
+    }
+
+    std::mt19937 rng = make_rng(config.seed);
+    std::optional<Channel> channel;
+    if (config.snr_db) {
+        channel.emplace(*config.snr_db);
+    }
+    std::vector<Complex> noisy(QPSK_SYMBOLS_COUNT);
+    Sample block[QPSK_SYMBOLS_COUNT];
+
+    for (long long i = 0; i < count; ++i) {
+        uint32_t m;
+        if (messages != nullptr) {
+            m = messages[i];
+            if (m >= WORDS) {
+                throw std::invalid_argument("lib/waveform.cpp: message " + std::to_string(i) +
+                                            " has bits above num_of_pucch_f2_bits");
+            }
+        } else {
+            // mt19937 output is uniform over 32 bits, so its low N bits are too.
+            m = rng() & (WORDS - 1);
+            if (saved != nullptr) {
+                const uint16_t word = static_cast<uint16_t>(m);
+                saved->append(&word, sizeof(word));
+            }
+        }
+
+        if (!channel) {
+            out.append(&samples[m * QPSK_SYMBOLS_COUNT], sizeof(block));
+            continue;
+        }
+
+        std::copy_n(&symbols[m * QPSK_SYMBOLS_COUNT], QPSK_SYMBOLS_COUNT, noisy.begin());
+        channel->apply_in_place(noisy, rng);
+        for (size_t k = 0; k < QPSK_SYMBOLS_COUNT; ++k) {
+            block[k] = to_sample<Sample>(noisy[k], config.ci16_scale);
+        }
+        out.append(block, sizeof(block));
+    }
+}
+
+template <int N>
+void generate(const WaveformConfig& config, const uint16_t* messages, long long count,
+              BufferedFile& out, BufferedFile* saved) {
+    switch (config.format) {
+        case IqFormat::CF32: generate<N, Cf32>(config, messages, count, out, saved); break;
+        case IqFormat::CF64: generate<N, Cf64>(config, messages, count, out, saved); break;
+        case IqFormat::CI16: generate<N, Ci16>(config, messages, count, out, saved); break;
+    }
+}
+
+} // namespace
+
+IqFormat parse_iq_format(const std::string& name) {
+    if (name == "cf32") {
+        return IqFormat::CF32;
+    }
+    if (name == "cf64") {
+        return IqFormat::CF64;
+    }
+    if (name == "ci16") {
+        return IqFormat::CI16;
+    }
+    throw std::invalid_argument("lib/waveform.cpp: IQ format must be cf32, cf64 or ci16");
+}
+
+const char* iq_format_name(IqFormat format) {
+    switch (format) {
+        case IqFormat::CF32: return "cf32";
+        case IqFormat::CF64: return "cf64";
+        case IqFormat::CI16: return "ci16";
+    }
+    return "";
+}
+
+size_t iq_sample_bytes(IqFormat format) {
+    switch (format) {
+        case IqFormat::CF32: return sizeof(Cf32);
+        case IqFormat::CF64: return sizeof(Cf64);
+        case IqFormat::CI16: return sizeof(Ci16);
+    }
+    return 0;
+}
+
+WaveformResult write_waveform(const std::string& path, const WaveformConfig& config) {
+    if (config.messages_file.empty() && config.count < 0) {
+        throw std::invalid_argument("lib/waveform.cpp: message count must be non-negative");
+    }
+    if (!(config.ci16_scale > 0.0)) {
+        throw std::invalid_argument("lib/waveform.cpp: ci16 scale must be positive");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::optional<MessageFile> messages;
+    if (!config.messages_file.empty()) {
+        messages.emplace(config.messages_file);
+    }
+    const uint16_t* words = messages ? messages->data() : nullptr;
+    const long long count = messages ? messages->size() : config.count;
+
+    BufferedFile out(path);
+    std::optional<BufferedFile> saved;
+    if (!messages && !config.save_messages.empty()) {
+        saved.emplace(config.save_messages);
+    }
+    BufferedFile* saved_ptr = saved ? &*saved : nullptr;
+
+    switch (config.n) {
+        case 2:  generate<2>(config, words, count, out, saved_ptr); break;
+        case 4:  generate<4>(config, words, count, out, saved_ptr); break;
+        case 6:  generate<6>(config, words, count, out, saved_ptr); break;
+        case 8:  generate<8>(config, words, count, out, saved_ptr); break;
+        case 11: generate<11>(config, words, count, out, saved_ptr); break;
+        default:
+            throw std::invalid_argument("lib/waveform.cpp: invalid num_of_pucch_f2_bits");
+    }
+
+    WaveformResult result;
+    result.messages = count;
+    result.bytes = out.commit();
+    if (saved) {
+        saved->commit();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+} // namespace qpsk
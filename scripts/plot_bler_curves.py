@@ -1,8 +1,8 @@
 #!/usr/bin/env python3
 # plot_bler_curves.py
 
+import ctypes
 import json
-import subprocess
 import numpy as np
 import matplotlib.pyplot as plt
 import os
@@ -11,51 +11,75 @@ import sys
 SNR_VALUES = np.arange(-20, 10, 1.0)
 CODE_SIZES = [2, 4, 6, 8, 11]
 ITERATIONS = 1000
-EXECUTABLE = "../build/qpsk"
-TEMP_INPUT = "temp_input.json"
-TEMP_OUTPUT = "result.json"
+SEED = 1
+DECODER = None  # None - декодер, выбранный автотюнером
+LIBRARY_PATHS = [
+    os.environ.get("QPSK_LIB", ""),
+    "./libqpsk_core.so",
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), "../build/libqpsk_core.so"),
+]
 
 COLORS = ['blue', 'green', 'red', 'purple', 'orange']
 MARKERS = ['o', 's', '^', 'D', 'v']
 
 
-def run_simulation(n, snr_db, iterations):
-    input_data = {
-        "mode": "channel simulation",
-        "num_of_pucch_f2_bits": n,
-        "snr_db": float(snr_db),
-        "iterations": iterations
-    }
+def load_library():
+    for path in LIBRARY_PATHS:
+        if path and os.path.exists(path):
+            lib = ctypes.CDLL(os.path.abspath(path))
+            break
+    else:
+        return None
 
-    with open(TEMP_INPUT, 'w') as f:
-        json.dump(input_data, f, indent=2)
+    double_p = ctypes.POINTER(ctypes.c_double)
+
+    lib.qpsk_last_error.restype = ctypes.c_char_p
+    lib.qpsk_simulate_sweep.argtypes = [
+        ctypes.c_int, double_p, ctypes.c_size_t, ctypes.c_longlong,
+        ctypes.c_uint64, ctypes.c_char_p, double_p
+    ]
+    lib.qpsk_simulate_sweep.restype = ctypes.c_int
+    lib.qpsk_bler_bounds.argtypes = [
+        ctypes.c_int, double_p, ctypes.c_size_t, double_p, double_p
+    ]
+    lib.qpsk_bler_bounds.restype = ctypes.c_int
+    return lib
+
+
+def run_sweep(lib, n, snr_values, iterations):
+    snr = np.ascontiguousarray(snr_values, dtype=np.float64)
+    bler = np.empty_like(snr)
+    double_p = ctypes.POINTER(ctypes.c_double)
+    decoder = DECODER.encode() if DECODER else None
+
+    status = lib.qpsk_simulate_sweep(
+        n, snr.ctypes.data_as(double_p), len(snr), iterations,
+        SEED, decoder, bler.ctypes.data_as(double_p)
+    )
+
+    if status != 0:
+        print(f"  [n={n}] Error: {lib.qpsk_last_error().decode()}")
+        return None
 
-    try:
-        result = subprocess.run(
-            [EXECUTABLE, TEMP_INPUT],
-            capture_output=True,
-            text=True,
-            timeout=60
-        )
+    return bler.tolist()
 
-        if result.returncode != 0:
-            print(f"  [n={n}, SNR={snr_db:.1f}] Error: {result.stderr.strip()}")
-            return None
 
-        with open(TEMP_OUTPUT, 'r') as f:
-            output_data = json.load(f)
+def run_bounds(lib, n, snr_values):
+    snr = np.ascontiguousarray(snr_values, dtype=np.float64)
+    union_bound = np.empty_like(snr)
+    tangential = np.empty_like(snr)
+    double_p = ctypes.POINTER(ctypes.c_double)
 
-        return output_data['bler']
+    status = lib.qpsk_bler_bounds(
+        n, snr.ctypes.data_as(double_p), len(snr),
+        union_bound.ctypes.data_as(double_p), tangential.ctypes.data_as(double_p)
+    )
 
-    except subprocess.TimeoutExpired:
-        print(f"  [n={n}, SNR={snr_db:.1f}] Timeout")
+    if status != 0:
+        print(f"  [n={n}] Error: {lib.qpsk_last_error().decode()}")
         return None
-    except Exception as e:
-        print(f"  [n={n}, SNR={snr_db:.1f}] Exception: {e}")
-        return None
-    finally:
-        if os.path.exists(TEMP_INPUT):
-            os.remove(TEMP_INPUT)
+
+    return np.minimum(union_bound, tangential).tolist()
 
 
 def main():
@@ -68,30 +92,26 @@ def main():
     print(f"Iterations per point: {ITERATIONS}")
     print("=" * 60)
 
-    if not os.path.exists(EXECUTABLE):
-        print(f"Error: executable {EXECUTABLE} not found")
+    lib = load_library()
+    if lib is None:
+        print("Error: libqpsk_core.so not found (set QPSK_LIB)")
         sys.exit(1)
 
     results = {n: [] for n in CODE_SIZES}
-    total_points = len(CODE_SIZES) * len(SNR_VALUES)
-    current_point = 0
+    bounds = {n: run_bounds(lib, n, SNR_VALUES) for n in CODE_SIZES}
 
     print(f"\nStarting simulation...")
 
     for n in CODE_SIZES:
         print(f"\nCode size: {n} bits")
-        for snr in SNR_VALUES:
-            current_point += 1
-            # print(f"  [{current_point}/{total_points}] SNR = {snr:.1f} dB -> ", end="")
 
-            bler = run_simulation(n, snr, ITERATIONS)
+        bler = run_sweep(lib, n, SNR_VALUES, ITERATIONS)
 
-            if bler is not None:
-                results[n].append(bler)
-                # print(f"BLER = {bler:.6f}")
-            else:
-                results[n].append(1.0)
-                print("FAILED")
+        if bler is not None:
+            results[n] = bler
+        else:
+            results[n] = [1.0] * len(SNR_VALUES)
+            print("FAILED")
 
     output_file = "bler_results.json"
     with open(output_file, 'w') as f:
@@ -99,6 +119,7 @@ def main():
             "snr_values": SNR_VALUES.tolist(),
             "code_sizes": CODE_SIZES,
             "results": {str(n): results[n] for n in CODE_SIZES},
+            "bounds": {str(n): bounds[n] for n in CODE_SIZES},
             "iterations": ITERATIONS
         }, f, indent=2)
     print(f"\nResults saved to {output_file}")
@@ -119,6 +140,15 @@ def main():
                 markeredgewidth=2,
                 label=f'n = {n} бит'
             )
+        if bounds[n]:
+            plt.semilogy(
+                SNR_VALUES,
+                bounds[n],
+                linestyle='--',
+                color=COLORS[idx],
+                linewidth=1,
+                label=f'n = {n} бит, граница'
+            )
 
     plt.grid(True, which="both", ls="-", alpha=0.2)
     plt.grid(True, which="major", ls="-", alpha=0.4)
@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+# read_error_capture.py - печать файла захвата ошибок симуляции (capture.file)
+
+import struct
+import sys
+
+HEADER = struct.Struct('<8sIIQQQ')
+RECORD = struct.Struct('<QIIIIfffBBH20f')
+MAGIC = b'QPSKEVT1'
+FIELDS = ['trial', 'tx_bits', 'rx_bits', 'best_index', 'runner_up_index',
+          'best_metric', 'runner_up_metric', 'snr_db', 'n', 'failed']
+
+
+def read_capture(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    magic, version, record_size, failures_seen, successes_sampled, count = HEADER.unpack_from(data)
+    if magic != MAGIC or version != 1 or record_size != RECORD.size:
+        raise ValueError(f"{path}: unsupported capture file")
+    if len(data) != HEADER.size + count * RECORD.size:
+        raise ValueError(f"{path}: truncated capture file")
+
+    records = []
+    for i in range(count):
+        values = RECORD.unpack_from(data, HEADER.size + i * RECORD.size)
+        record = dict(zip(FIELDS, values[:10]))
+        record['rx'] = list(values[11:])
+        records.append(record)
+
+    return {
+        'failures_seen': failures_seen,
+        'successes_sampled': successes_sampled,
+        'records': records,
+    }
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(f"Usage: {sys.argv[0]} <capture.bin>")
+        sys.exit(1)
+
+    capture = read_capture(sys.argv[1])
+    records = capture['records']
+    failures = [r for r in records if r['failed']]
+
+    print(f"Failures seen: {capture['failures_seen']}, kept: {len(failures)}")
+    print(f"Successes sampled: {capture['successes_sampled']}, kept: {len(records) - len(failures)}")
+
+    for r in records:
+        gap = r['best_metric'] - r['runner_up_metric']
+        kind = 'FAIL' if r['failed'] else 'ok  '
+        print(f"{kind} trial={r['trial']:<10} n={r['n']:<2} snr={r['snr_db']:6.2f} "
+              f"tx={r['tx_bits']:#06x} rx={r['rx_bits']:#06x} "
+              f"best={r['best_index']:#06x} ({r['best_metric']:.3f}) "
+              f"runner_up={r['runner_up_index']:#06x} (gap {gap:.3f})")
+
+
+if __name__ == "__main__":
+    main()
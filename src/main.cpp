@@ -1,51 +1,190 @@
 #include "system.hpp"
+#include "batch.hpp"
+#include "utils/trace.hpp"
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 using namespace qpsk;
 
-int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <input.json>\n";
-        return 1;
+namespace {
+
+void print_usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--trace file] [--trace-sample k] <input.json> | tune\n"
+              << "       " << program << " [--trace file] [--trace-sample k] -o <output_dir> [-j threads] <input.json|dir>...\n";
+}
+
+bool begin_trace(const TraceConfig& config) {
+    try {
+        start_tracing(config);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return false;
     }
+    return true;
+}
 
-    std::ifstream ifs(argv[1]);
-    if (!ifs.is_open()) {
-        std::cerr << "Cannot open input file\n";
-        return 1;
+void end_trace() {
+    if (!tracing_enabled()) {
+        return;
+    }
+    try {
+        const TraceSummary summary = stop_tracing();
+        if (summary.dropped > 0) {
+            std::cerr << "Trace buffers full: dropped " << summary.dropped << " spans\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Cannot write trace: " << e.what() << "\n";
     }
+}
 
+int run_single(const std::string& path, TraceConfig trace) {
     json input;
+
+    if (path == "tune") {
+        input["mode"] = "tune";
+    } else {
+        std::stringstream text;
+        {
+            TRACE_SPAN("read input");
+            std::ifstream ifs(path);
+            if (!ifs.is_open()) {
+                std::cerr << "Cannot open input file\n";
+                return 1;
+            }
+            text << ifs.rdbuf();
+        }
+
+        try {
+            TRACE_SPAN("parse input");
+            text >> input;
+        } catch (const std::exception& e) {
+            std::cerr << "Invalid JSON: " << e.what() << "\n";
+            return 1;
+        }
+    }
+
+    // The command line wins over the input's "trace" field.
+    if (trace.file.empty() && input.contains("trace")) {
+        try {
+            trace = parse_trace_config(input["trace"]);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        if (!begin_trace(trace)) {
+            return 1;
+        }
+    }
+
+    json output;
+    int result;
+    {
+        TRACE_SPAN("run mode");
+        result = run_mode(input, output);
+    }
+
+    if (result == 0) {
+        std::string text;
+        {
+            TRACE_SPAN("serialize output");
+            text = output.dump(2);
+        }
+        TRACE_SPAN("write output");
+        std::ofstream ofs("result.json");
+        ofs << text << "\n";
+    }
+
+    return result;
+}
+
+int run_many(const std::vector<std::string>& paths, const std::string& output_dir, size_t threads) {
+    std::vector<std::string> inputs;
+
     try {
-        ifs >> input;
+        inputs = collect_batch_inputs(paths);
     } catch (const std::exception& e) {
-        std::cerr << "Invalid JSON: " << e.what() << "\n";
+        std::cerr << "Cannot list inputs: " << e.what() << "\n";
         return 1;
     }
 
-    json output;
-    std::string mode = input.value("mode", "");
-
-    int result = 1;
-    if (mode == "coding") {
-        result = run_coding_mode(input, output);
-    } else if (mode == "decoding") {
-        result = run_decoding_mode(input, output);
-    } else if (mode == "channel simulation") {
-        result = run_simulation_mode(input, output);
-    } else {
-        std::cerr << "Invalid mode\n";
+    BatchSummary summary;
+    try {
+        summary = run_batch(inputs, output_dir, threads);
+    } catch (const std::exception& e) {
+        std::cerr << "Batch error: " << e.what() << "\n";
         return 1;
     }
 
-    if (result != 0) {
+    const double rate = summary.seconds > 0.0 ? summary.jobs / summary.seconds : 0.0;
+    std::cout << "Processed " << summary.jobs << " jobs in " << summary.seconds << " s ("
+              << rate << " jobs/s) on " << threads << " threads, failed: " << summary.failed << "\n";
+
+    return summary.failed == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output_dir;
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> paths;
+    TraceConfig trace;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if ((arg == "-o" || arg == "-j" || arg == "--trace" || arg == "--trace-sample") && i + 1 >= argc) {
+            print_usage(argv[0]);
+            return 1;
+        }
+
+        if (arg == "-o") {
+            output_dir = argv[++i];
+        } else if (arg == "-j" || arg == "--trace-sample") {
+            try {
+                const unsigned long value = std::stoul(argv[++i]);
+                if (arg == "-j") {
+                    threads = value;
+                } else {
+                    trace.sample_period = static_cast<uint32_t>(value);
+                }
+            } catch (const std::exception&) {
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--trace") {
+            trace.file = argv[++i];
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    if (output_dir.empty()) {
+        if (paths.size() != 1) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        if (!trace.file.empty() && !begin_trace(trace)) {
+            return 1;
+        }
+        const int result = run_single(paths[0], trace);
+        end_trace();
         return result;
     }
 
-    std::ofstream ofs("result.json");
-    ofs << output.dump(2) << "\n";
+    if (paths.empty()) {
+        print_usage(argv[0]);
+        return 1;
+    }
 
-    return 0;
+    if (!trace.file.empty() && !begin_trace(trace)) {
+        return 1;
+    }
+    const int result = run_many(paths, output_dir, threads);
+    end_trace();
+    return result;
 }
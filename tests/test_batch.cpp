@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+
+#include "system.hpp"
+#include "batch.hpp"
+#include "utils/file_utils.hpp"
+#include "utils/thread_pool.hpp"
+
+using namespace qpsk;
+
+namespace fs = std::filesystem;
+
+TEST(ThreadPoolTest, RunsEveryTask) {
+    std::atomic<int> sum{0};
+
+    ThreadPool pool(3);
+    for (int i = 1; i <= 100; ++i) {
+        pool.submit([&sum, i] { sum += i; });
+    }
+    pool.wait();
+
+    EXPECT_EQ(sum.load(), 5050);
+    EXPECT_EQ(pool.size(), 3u);
+}
+
+class BatchTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root_ = fs::temp_directory_path() /
+                ("qpsk_batch_test_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        fs::remove_all(root_);
+        fs::create_directories(root_ / "jobs");
+    }
+
+    void TearDown() override {
+        fs::remove_all(root_);
+    }
+
+    void write_job(const std::string& name, const json& job) {
+        write_file_atomic((root_ / "jobs" / name).string(), job.dump());
+    }
+
+    fs::path root_;
+};
+
+TEST_F(BatchTest, ProcessesDirectoryConcurrently) {
+    for (int i = 0; i < 20; ++i) {
+        json job;
+        job["mode"] = "coding";
+        job["num_of_pucch_f2_bits"] = 4;
+        job["pucch_f2_bits"] = {i & 1, (i >> 1) & 1, (i >> 2) & 1, (i >> 3) & 1};
+        write_job("job" + std::to_string(i) + ".json", job);
+    }
+    write_job("broken.json", json{{"mode", "no such mode"}});
+    write_file_atomic((root_ / "jobs" / "notes.txt").string(), "ignored");
+
+    auto inputs = collect_batch_inputs({(root_ / "jobs").string()});
+    ASSERT_EQ(inputs.size(), 21u);
+
+    BatchSummary summary = run_batch(inputs, (root_ / "out").string(), 4);
+    EXPECT_EQ(summary.jobs, 21u);
+    EXPECT_EQ(summary.failed, 1u);
+
+    for (const auto& input : inputs) {
+        bool broken = fs::path(input).filename() == "broken.json";
+        EXPECT_EQ(fs::exists(batch_output_path(input, (root_ / "out").string())), !broken) << input;
+    }
+
+    json expected;
+    json job = json::parse(read_file((root_ / "jobs" / "job5.json").string()));
+    ASSERT_EQ(run_mode(job, expected), 0);
+    json actual = json::parse(read_file(batch_output_path((root_ / "jobs" / "job5.json").string(),
+                                                          (root_ / "out").string())));
+    EXPECT_EQ(actual, expected);
+}
+
+TEST_F(BatchTest, RejectsModesThatNeedTheWholeProcess) {
+    json sharded;
+    sharded["mode"] = "sharded simulation";
+    sharded["num_of_pucch_f2_bits"] = 2;
+    sharded["snr_db"] = 0.0;
+    sharded["iterations"] = 100;
+    sharded["queue_dir"] = (root_ / "queue").string();
+    write_job("sharded.json", sharded);
+    write_job("tune.json", json{{"mode", "tune"}});
+
+    auto inputs = collect_batch_inputs({(root_ / "jobs").string()});
+    BatchSummary summary = run_batch(inputs, (root_ / "out").string(), 2);
+    EXPECT_EQ(summary.failed, 2u);
+    for (const auto& input : inputs) {
+        EXPECT_FALSE(fs::exists(batch_output_path(input, (root_ / "out").string()))) << input;
+    }
+    EXPECT_FALSE(fs::exists(root_ / "queue"));
+}
+
+TEST_F(BatchTest, RejectsCollidingOutputNames) {
+    std::vector<std::string> inputs = {"a/job.json", "b/job.json"};
+    EXPECT_THROW(run_batch(inputs, (root_ / "out").string(), 2), std::invalid_argument);
+}
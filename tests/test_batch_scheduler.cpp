@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <random>
+
+#include "batch_scheduler.hpp"
+#include "channel.hpp"
+#include "encoder.hpp"
+#include "qpsk.hpp"
+#include "random_bits.hpp"
+
+using namespace qpsk;
+
+namespace {
+
+template <int N>
+DecodeRequest make_request(const Channel& channel, std::mt19937& rng, uint32_t& tx) {
+    BlockEncoder<N> code;
+    QPSK mod;
+    const auto bits = generate_random_bits<N>(rng);
+    tx = static_cast<uint32_t>(bits.to_ulong());
+    return {N, mod.demodulate(channel.apply(mod.modulate(code.encode(bits)), rng))};
+}
+
+std::vector<DecodeRequest> mixed_batch(size_t size, std::vector<uint32_t>& tx) {
+    Channel channel(20.0);
+    std::mt19937 rng(3);
+    std::vector<DecodeRequest> batch;
+    tx.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        switch (i % 5) {
+            case 0: batch.push_back(make_request<2>(channel, rng, tx[i])); break;
+            case 1: batch.push_back(make_request<11>(channel, rng, tx[i])); break;
+            case 2: batch.push_back(make_request<4>(channel, rng, tx[i])); break;
+            case 3: batch.push_back(make_request<8>(channel, rng, tx[i])); break;
+            case 4: batch.push_back(make_request<6>(channel, rng, tx[i])); break;
+        }
+    }
+    return batch;
+}
+
+} // namespace
+
+TEST(WorkStealingPoolTest, RunsEveryTask) {
+    WorkStealingPool pool(3);
+    std::atomic<int> done{0};
+
+    // Everything on one worker: the others can only help by stealing.
+    for (int i = 0; i < 200; ++i) {
+        pool.submit(0, [&done] { ++done; });
+    }
+    pool.wait();
+    EXPECT_EQ(done.load(), 200);
+
+    for (int i = 0; i < 50; ++i) {
+        pool.submit(static_cast<size_t>(i), [&done] { ++done; });
+    }
+    pool.wait();
+    EXPECT_EQ(done.load(), 250);
+}
+
+TEST(BatchSchedulerTest, DecodesMixedBatchInRequestOrder) {
+    std::vector<uint32_t> tx;
+    const auto batch = mixed_batch(500, tx);
+
+    for (size_t threads : {1, 3}) {
+        BatchScheduler scheduler(threads, "Precomputed");
+        EXPECT_EQ(scheduler.decode(batch), tx);
+        EXPECT_EQ(scheduler.last_stats().groups, 5u);
+        EXPECT_GE(scheduler.last_stats().tasks, 5u);
+    }
+}
+
+TEST(BatchSchedulerTest, CostGrowsWithN) {
+    BatchScheduler scheduler(1, "Precomputed");
+    EXPECT_GT(scheduler.cost_ns(11), scheduler.cost_ns(2));
+}
+
+TEST(BatchSchedulerTest, RejectsInvalidRequests) {
+    BatchScheduler scheduler(2, "Precomputed");
+    EXPECT_TRUE(scheduler.decode({}).empty());
+    EXPECT_THROW(scheduler.decode({{5, std::vector<double>(CODEWORD_SIZE)}}), std::invalid_argument);
+    EXPECT_THROW(scheduler.decode({{4, std::vector<double>(3)}}), std::invalid_argument);
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "bler_bounds.hpp"
+#include "codebook.hpp"
+#include "simulation.hpp"
+
+using namespace qpsk;
+
+TEST(BlerBoundsTest, BoundsAreMonotoneAndClamped) {
+    for (int n : {2, 4, 6, 8, 11}) {
+        double previous_union = 1.0;
+        double previous_tangential = 1.0;
+        for (double snr_db = -12.0; snr_db <= 12.0; snr_db += 2.0) {
+            const double ub = union_bound_bler(n, snr_db);
+            const double tsb = tangential_sphere_bound_bler(n, snr_db);
+
+            EXPECT_LE(ub, previous_union + 1e-12) << "n=" << n << " snr=" << snr_db;
+            EXPECT_LE(tsb, previous_tangential + 1e-12) << "n=" << n << " snr=" << snr_db;
+            EXPECT_GT(tsb, 0.0);
+            EXPECT_LE(tsb, 1.0);
+
+            previous_union = ub;
+            previous_tangential = tsb;
+        }
+    }
+}
+
+TEST(BlerBoundsTest, UnionBoundIsDominatedByMinimumDistance) {
+    const int n = 11;
+    const int d = minimum_distance(n);
+    const double snr = std::pow(10.0, 10.0 / 10.0);
+    const double leading = weight_distribution(n)[d] * 0.5 * std::erfc(std::sqrt(d * snr / 2.0));
+
+    EXPECT_NEAR(union_bound_bler(n, 10.0) / leading, 1.0, 0.01);
+}
+
+TEST(BlerBoundsTest, TangentialSphereBoundIsTighterAtLowSnr) {
+    EXPECT_DOUBLE_EQ(union_bound_bler(11, -4.0), 1.0);
+    EXPECT_LT(tangential_sphere_bound_bler(11, -4.0), 0.95);
+}
+
+TEST(BlerBoundsTest, BoundsAreAboveSimulatedBler) {
+    for (double snr_db : {-6.0, 0.0, 3.0}) {
+        SimulationConfig config;
+        config.n = 8;
+        config.snr_db = snr_db;
+        config.iterations = 5000;
+        config.seed = 5;
+        config.decoder = "Precomputed";
+
+        const double bler = static_cast<double>(simulate(config).failed) / config.iterations;
+        const double margin = 4.0 * std::sqrt(bler * (1.0 - bler) / config.iterations) + 1e-3;
+
+        EXPECT_GE(tangential_sphere_bound_bler(8, snr_db) + margin, bler) << "snr=" << snr_db;
+        EXPECT_GE(union_bound_bler(8, snr_db) + margin, bler) << "snr=" << snr_db;
+    }
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "qpsk_capi.h"
+#include "bler_bounds.hpp"
+
+TEST(CapiTest, EncodeDecodeRoundtrip) {
+    const int n = 11;
+    const size_t count = 64;
+
+    std::vector<uint8_t> bits(count * n);
+    for (size_t i = 0; i < bits.size(); ++i) {
+        bits[i] = static_cast<uint8_t>((i * 7 + i / 3) % 2);
+    }
+
+    std::vector<double> symbols(count * QPSK_CAPI_SYMBOLS * 2);
+    ASSERT_EQ(qpsk_encode_batch(n, bits.data(), count, symbols.data()), 0);
+
+    std::vector<uint8_t> decoded(count * n, 2);
+    ASSERT_EQ(qpsk_decode_batch(n, symbols.data(), count, decoded.data(), "Precomputed"), 0);
+
+    EXPECT_EQ(decoded, bits);
+}
+
+TEST(CapiTest, ErrorsAreReportedNotThrown) {
+    std::vector<uint8_t> bits(3, 0);
+    std::vector<double> symbols(QPSK_CAPI_SYMBOLS * 2);
+
+    EXPECT_EQ(qpsk_encode_batch(3, bits.data(), 1, symbols.data()), -1);
+    EXPECT_NE(std::string(qpsk_last_error()), "");
+
+    EXPECT_EQ(qpsk_decode_batch(4, symbols.data(), 1, bits.data(), "NoSuchDecoder"), -1);
+    EXPECT_NE(std::string(qpsk_last_error()).find("NoSuchDecoder"), std::string::npos);
+
+    bits[0] = 5;
+    EXPECT_EQ(qpsk_encode_batch(2, bits.data(), 1, symbols.data()), -1);
+    EXPECT_NE(std::string(qpsk_last_error()).find("bit value"), std::string::npos);
+
+    EXPECT_EQ(qpsk_capi_version(), QPSK_CAPI_VERSION);
+}
+
+TEST(CapiTest, SweepIsReproducible) {
+    const double snr_db[] = {-8.0, -4.0, 0.0};
+    double first[3];
+    double second[3];
+
+    ASSERT_EQ(qpsk_simulate_sweep(4, snr_db, 3, 300, 11, "Precomputed", first), 0);
+    ASSERT_EQ(qpsk_simulate_sweep(4, snr_db, 3, 300, 11, "Precomputed", second), 0);
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_DOUBLE_EQ(first[i], second[i]);
+        EXPECT_GE(first[i], 0.0);
+        EXPECT_LE(first[i], 1.0);
+    }
+    EXPECT_GT(first[0], first[2]);
+
+    long long failed = -1;
+    ASSERT_EQ(qpsk_simulate_point(4, 30.0, 200, 1, "Precomputed", &failed), 0);
+    EXPECT_EQ(failed, 0);
+}
+
+TEST(CapiTest, BlerBoundsMatchLibrary) {
+    const double snr_db[] = {-4.0, 4.0};
+    double union_bound[2];
+    double tangential[2];
+
+    ASSERT_EQ(qpsk_bler_bounds(11, snr_db, 2, union_bound, tangential), 0);
+    EXPECT_DOUBLE_EQ(union_bound[1], qpsk::union_bound_bler(11, 4.0));
+    EXPECT_DOUBLE_EQ(tangential[0], qpsk::tangential_sphere_bound_bler(11, -4.0));
+
+    EXPECT_EQ(qpsk_bler_bounds(5, snr_db, 2, union_bound, nullptr), -1);
+}
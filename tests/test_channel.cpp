@@ -70,3 +70,27 @@ TEST(ChannelTest, OutputSizeMatchesInput) {
     auto noisy = channel.apply(signal);
     EXPECT_EQ(noisy.size(), signal.size());
 }
+
+TEST(ChannelTest, SeededApplyIsDeterministic) {
+    Channel channel(0.0);
+    std::vector<Complex> signal(20, Complex(1.0, -1.0));
+
+    std::mt19937 gen_a(123);
+    std::mt19937 gen_b(123);
+
+    EXPECT_EQ(channel.apply(signal, gen_a), channel.apply(signal, gen_b));
+}
+
+TEST(ChannelTest, NoiseOnlyMatchesSnr) {
+    Channel channel(3.0);
+    std::mt19937 gen(5);
+
+    const auto noise = channel.noise(20000, gen);
+    ASSERT_EQ(noise.size(), 20000u);
+
+    double power = 0.0;
+    for (const auto& sample : noise) {
+        power += std::norm(sample);
+    }
+    EXPECT_NEAR(power / noise.size(), std::pow(10.0, -0.3), 0.02);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include "codebook.hpp"
+
+using namespace qpsk;
+
+template<int N>
+void test_table_finds_every_codeword() {
+    CodewordTable<N> table;
+    const auto& codebook = packed_codebook<N>();
+
+    for (size_t i = 0; i < codebook.size(); ++i) {
+        EXPECT_EQ(table.find(codebook[i]), static_cast<int>(i)) << "N=" << N;
+    }
+}
+
+TEST(CodebookTest, PackedCodebookMatchesEncoder) {
+    BlockEncoder<8> encoder;
+    const auto& codebook = packed_codebook<8>();
+
+    for (size_t i = 0; i < codebook.size(); ++i) {
+        EXPECT_EQ(codebook[i], encoder.encode(std::bitset<8>(i)).to_ulong());
+    }
+}
+
+TEST(CodebookTest, TableFindsEveryCodeword) {
+    test_table_finds_every_codeword<2>();
+    test_table_finds_every_codeword<4>();
+    test_table_finds_every_codeword<6>();
+    test_table_finds_every_codeword<8>();
+    test_table_finds_every_codeword<11>();
+}
+
+TEST(CodebookTest, TableRejectsNonCodewords) {
+    CodewordTable<4> table;
+    const auto& codebook = packed_codebook<4>();
+
+    for (uint32_t word = 0; word < (1U << CODEWORD_SIZE); word += 997) {
+        bool valid = std::find(codebook.begin(), codebook.end(), word) != codebook.end();
+        EXPECT_EQ(table.find(word) >= 0, valid) << word;
+    }
+}
+
+TEST(CodebookTest, WeightDistribution) {
+    for (int n : VALID_N_BITS) {
+        const auto& distribution = weight_distribution(n);
+        ASSERT_EQ(distribution.size(), CODEWORD_SIZE + 1);
+        EXPECT_EQ(distribution[0], 1u);
+        EXPECT_EQ(std::accumulate(distribution.begin(), distribution.end(), uint64_t{0}), 1ULL << n);
+        EXPECT_GT(minimum_distance(n), 0);
+    }
+
+    EXPECT_GE(minimum_distance(2), minimum_distance(11));
+    EXPECT_THROW(weight_distribution(3), std::invalid_argument);
+}
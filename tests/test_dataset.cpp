@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "dataset.hpp"
+#include "simulation.hpp"
+
+using namespace qpsk;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+    return (fs::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+TEST(DatasetTest, RoundTripsThroughMapping) {
+    const std::string path = temp_path("qpsk_dataset_roundtrip.bin");
+
+    DatasetConfig config;
+    config.n = 6;
+    config.snr_db = 1.5;
+    config.count = 300;
+    config.seed = 42;
+
+    const size_t bytes = write_dataset(path, config);
+    EXPECT_EQ(bytes, fs::file_size(path));
+    EXPECT_EQ(bytes, 64 + 300 * sizeof(DatasetRecord));
+
+    const Dataset dataset(path);
+    EXPECT_EQ(dataset.n(), 6);
+    EXPECT_DOUBLE_EQ(dataset.snr_db(), 1.5);
+    EXPECT_EQ(dataset.seed(), 42u);
+    ASSERT_EQ(dataset.size(), 300u);
+    for (size_t i = 0; i < dataset.size(); ++i) {
+        EXPECT_LT(dataset[i].tx_bits, 1u << 6);
+    }
+
+    fs::remove(path);
+}
+
+TEST(DatasetTest, ReplayMatchesSimulationWithSameSeed) {
+    const std::string path = temp_path("qpsk_dataset_replay.bin");
+
+    DatasetConfig config;
+    config.n = 8;
+    config.snr_db = -2.0;
+    config.count = 3000;
+    config.seed = 7;
+    write_dataset(path, config);
+
+    SimulationConfig simulation;
+    simulation.n = config.n;
+    simulation.snr_db = config.snr_db;
+    simulation.iterations = config.count;
+    simulation.seed = config.seed;
+    simulation.decoder = "Basic";
+    const SimulationResult simulated = simulate(simulation);
+
+    const Dataset dataset(path);
+    const ReplayResult result = replay_dataset(dataset, {"Basic", "PartialSum", "BranchBound"});
+
+    EXPECT_EQ(result.records, 3000);
+    ASSERT_EQ(result.decoders.size(), 3u);
+    EXPECT_EQ(result.decoders[0].failed, simulated.failed);
+    for (const auto& decoder : result.decoders) {
+        EXPECT_EQ(decoder.failed, result.decoders[0].failed) << decoder.name;
+        EXPECT_GT(decoder.decode_ns, 0.0) << decoder.name;
+    }
+    EXPECT_EQ(result.any_disagreement, 0);
+
+    fs::remove(path);
+}
+
+TEST(DatasetTest, ReplayCountsDisagreements) {
+    const std::string path = temp_path("qpsk_dataset_disagree.bin");
+
+    DatasetConfig config;
+    config.n = 11;
+    config.snr_db = -1.0;
+    config.count = 2000;
+    config.seed = 11;
+    write_dataset(path, config);
+
+    const Dataset dataset(path);
+    DecoderOptions options;
+    options.budget = 1;
+    const ReplayResult result = replay_dataset(dataset, {"PartialSum", "OSD"}, options);
+
+    EXPECT_GT(result.disagreements[0][1], 0);
+    EXPECT_EQ(result.disagreements[0][1], result.disagreements[1][0]);
+    EXPECT_EQ(result.disagreements[0][1], result.any_disagreement);
+    EXPECT_GE(result.decoders[1].failed, result.decoders[0].failed);
+
+    fs::remove(path);
+}
+
+TEST(DatasetTest, RejectsForeignAndTruncatedFiles) {
+    const std::string path = temp_path("qpsk_dataset_bad.bin");
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << std::string(80, 'x');
+    }
+    EXPECT_THROW(Dataset dataset(path), std::invalid_argument);
+
+    DatasetConfig config;
+    config.n = 2;
+    config.count = 10;
+    write_dataset(path, config);
+    fs::resize_file(path, fs::file_size(path) - 1);
+    EXPECT_THROW(Dataset dataset(path), std::invalid_argument);
+
+    fs::remove(path);
+    EXPECT_THROW(Dataset dataset(path), std::runtime_error);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#include "system.hpp"
+#include "encoder.hpp"
+#include "decoder_registry.hpp"
+#include "decoder_tuner.hpp"
+#include "utils/file_utils.hpp"
+
+using namespace qpsk;
+
+namespace fs = std::filesystem;
+
+template<int N>
+void test_registry_decodes(const std::string& name) {
+    auto decoder = make_decoder<N>(name);
+    ASSERT_NE(decoder, nullptr);
+    EXPECT_EQ(decoder->name(), name);
+
+    BlockEncoder<N> encoder;
+    std::bitset<N> tx((1ULL << N) - 2);
+    auto cw = encoder.encode(tx);
+
+    std::vector<double> llrs(CODEWORD_SIZE);
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        llrs[j] = cw[j] ? 1.0 : -1.0;
+    }
+
+    EXPECT_EQ(decoder->decode(llrs), tx) << name << " N=" << N;
+}
+
+TEST(DecoderRegistryTest, EveryRegisteredDecoderIsConstructible) {
+    for (const auto& info : registered_decoders()) {
+        test_registry_decodes<2>(info.name);
+        test_registry_decodes<4>(info.name);
+        test_registry_decodes<6>(info.name);
+        test_registry_decodes<8>(info.name);
+        test_registry_decodes<11>(info.name);
+    }
+}
+
+TEST(DecoderRegistryTest, UnknownDecoderThrows) {
+    EXPECT_FALSE(is_registered_decoder("NoSuchDecoder"));
+    EXPECT_THROW(make_decoder<4>("NoSuchDecoder"), std::invalid_argument);
+}
+
+TEST(DecoderTunerTest, PicksExactDecoder) {
+    TuneResult result = tune_decoder(2);
+
+    EXPECT_EQ(result.n, 2);
+    EXPECT_FALSE(result.timings_ns.empty());
+
+    bool exact = false;
+    for (const auto& info : registered_decoders()) {
+        if (info.name == result.decoder) {
+            exact = info.exact;
+        }
+    }
+    EXPECT_TRUE(exact) << result.decoder;
+}
+
+TEST(DecoderTunerTest, SelectUsesCacheFile) {
+    const char* previous = std::getenv("QPSK_DECODER_CACHE");
+    const std::string saved = previous ? previous : "";
+
+    fs::path cache = fs::temp_directory_path() / "qpsk_decoder_cache_test.json";
+    json content;
+    content[cpu_model()]["4"] = "BranchBound";
+    write_file_atomic(cache.string(), content.dump());
+
+    setenv("QPSK_DECODER_CACHE", cache.c_str(), 1);
+    EXPECT_EQ(decoder_cache_path(), cache.string());
+    EXPECT_EQ(select_decoder(4), "BranchBound");
+
+    std::string tuned = select_decoder(2);
+    EXPECT_TRUE(is_registered_decoder(tuned));
+    json stored = json::parse(read_file(cache.string()));
+    EXPECT_EQ(stored[cpu_model()]["2"], tuned);
+    EXPECT_EQ(stored[cpu_model()]["4"], "BranchBound");
+
+    if (previous) {
+        setenv("QPSK_DECODER_CACHE", saved.c_str(), 1);
+    } else {
+        unsetenv("QPSK_DECODER_CACHE");
+    }
+    fs::remove(cache);
+}
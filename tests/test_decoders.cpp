@@ -1,11 +1,27 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include <bitset>
+#include <string>
 
 #include "encoder.hpp"
 #include "basic_decoder.hpp"
 #include "precomputed_decoder.hpp"
+#include "partial_sum_decoder.hpp"
+#include "unrolled_decoder.hpp"
+#include "parallel_decoder.hpp"
+#include "known_bits_decoder.hpp"
+#include "blind_detector.hpp"
 #include "simd_decoder.hpp"
+#include "fixed_point_decoder.hpp"
+#include "simd_fixed_point_decoder.hpp"
+#include "branch_bound_decoder.hpp"
+#include "early_exit_decoder.hpp"
+#include "osd_decoder.hpp"
+#include "hard_decision_decoder.hpp"
+
+#include <limits>
+#include <random>
+#include <thread>
 
 using namespace qpsk;
 
@@ -28,6 +44,22 @@ void test_decoder_no_noise(Decoder& decoder, const std::string& name) {
     }
 }
 
+// Draws random LLRs and checks that `decode` and `reference` (both mapping
+// the LLRs to an information word index) agree on every draw.
+template<int N, typename Decode, typename Reference>
+void test_matches_reference(Decode&& decode, Reference&& reference, const std::string& name, int trials = 500) {
+    std::mt19937 rng(1000 + N);
+    std::normal_distribution<double> llr(0.0, 2.0);
+
+    for (int trial = 0; trial < trials; ++trial) {
+        std::vector<double> llrs(CODEWORD_SIZE);
+        for (auto& v : llrs) {
+            v = llr(rng);
+        }
+        EXPECT_EQ(decode(llrs), reference(llrs)) << name << " trial " << trial;
+    }
+}
+
 TEST(DecoderTest, BasicDecoderN2) {
     BasicDecoder<2> decoder;
     test_decoder_no_noise<2>(decoder, "BasicDecoder<2>");
@@ -78,6 +110,53 @@ TEST(DecoderTest, PrecomputedDecoderN11) {
     test_decoder_no_noise<11>(decoder, "PrecomputedDecoder<11>");
 }
 
+TEST(DecoderTest, PartialSumDecoderN2) {
+    PartialSumDecoder<2> decoder;
+    test_decoder_no_noise<2>(decoder, "PartialSumDecoder<2>");
+}
+
+TEST(DecoderTest, PartialSumDecoderN4) {
+    PartialSumDecoder<4> decoder;
+    test_decoder_no_noise<4>(decoder, "PartialSumDecoder<4>");
+}
+
+TEST(DecoderTest, PartialSumDecoderN6) {
+    PartialSumDecoder<6> decoder;
+    test_decoder_no_noise<6>(decoder, "PartialSumDecoder<6>");
+}
+
+TEST(DecoderTest, PartialSumDecoderN8) {
+    PartialSumDecoder<8> decoder;
+    test_decoder_no_noise<8>(decoder, "PartialSumDecoder<8>");
+}
+
+TEST(DecoderTest, PartialSumDecoderN11) {
+    PartialSumDecoder<11> decoder;
+    test_decoder_no_noise<11>(decoder, "PartialSumDecoder<11>");
+}
+
+TEST(DecoderTest, PartialSumTablesHoldSubsetSums) {
+    std::vector<double> llrs(CODEWORD_SIZE);
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        llrs[j] = 0.5 * j - 3.0;
+    }
+
+    PartialSumTables tables;
+    build_partial_sums(llrs.data(), tables);
+
+    for (int g = 0; g < PARTIAL_SUM_GROUPS; ++g) {
+        for (int m = 0; m < PARTIAL_SUM_ENTRIES; ++m) {
+            double expected = 0.0;
+            for (int b = 0; b < PARTIAL_SUM_GROUP_BITS; ++b) {
+                if (m & (1 << b)) {
+                    expected += llrs[g * PARTIAL_SUM_GROUP_BITS + b];
+                }
+            }
+            EXPECT_DOUBLE_EQ(tables[g][m], expected) << "group " << g << " subset " << m;
+        }
+    }
+}
+
 #ifdef __AVX2__
 TEST(DecoderTest, SimdDecoderN2) {
     SimdDecoder<2> decoder;
@@ -105,6 +184,250 @@ TEST(DecoderTest, SimdDecoderN11) {
 }
 #endif
 
+TEST(DecoderTest, FixedPointDecoderN2) {
+    FixedPointDecoder<2> decoder;
+    test_decoder_no_noise<2>(decoder, "FixedPointDecoder<2>");
+}
+
+TEST(DecoderTest, FixedPointDecoderN4) {
+    FixedPointDecoder<4> decoder;
+    test_decoder_no_noise<4>(decoder, "FixedPointDecoder<4>");
+}
+
+TEST(DecoderTest, FixedPointDecoderN6) {
+    FixedPointDecoder<6> decoder;
+    test_decoder_no_noise<6>(decoder, "FixedPointDecoder<6>");
+}
+
+TEST(DecoderTest, FixedPointDecoderN8) {
+    FixedPointDecoder<8> decoder;
+    test_decoder_no_noise<8>(decoder, "FixedPointDecoder<8>");
+}
+
+TEST(DecoderTest, FixedPointDecoderN11) {
+    FixedPointDecoder<11> decoder;
+    test_decoder_no_noise<11>(decoder, "FixedPointDecoder<11>");
+}
+
+#ifdef __AVX2__
+TEST(DecoderTest, SimdFixedPointDecoderN2) {
+    SimdFixedPointDecoder<2> decoder;
+    test_decoder_no_noise<2>(decoder, "SimdFixedPointDecoder<2>");
+}
+
+TEST(DecoderTest, SimdFixedPointDecoderN4) {
+    SimdFixedPointDecoder<4> decoder;
+    test_decoder_no_noise<4>(decoder, "SimdFixedPointDecoder<4>");
+}
+
+TEST(DecoderTest, SimdFixedPointDecoderN6) {
+    SimdFixedPointDecoder<6> decoder;
+    test_decoder_no_noise<6>(decoder, "SimdFixedPointDecoder<6>");
+}
+
+TEST(DecoderTest, SimdFixedPointDecoderN8) {
+    SimdFixedPointDecoder<8> decoder;
+    test_decoder_no_noise<8>(decoder, "SimdFixedPointDecoder<8>");
+}
+
+TEST(DecoderTest, SimdFixedPointDecoderN11) {
+    SimdFixedPointDecoder<11> decoder;
+    test_decoder_no_noise<11>(decoder, "SimdFixedPointDecoder<11>");
+}
+
+TEST(DecoderTest, SimdFixedPointMatchesScalarFixedPoint) {
+    FixedPointDecoder<11> scalar;
+    SimdFixedPointDecoder<11> simd;
+
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> dist(-127, 127);
+
+    for (int trial = 0; trial < 500; ++trial) {
+        std::vector<int8_t> llrs(CODEWORD_SIZE);
+        for (auto& llr : llrs) {
+            llr = static_cast<int8_t>(dist(rng) / (trial % 2 == 0 ? 1 : 40));
+        }
+
+        EXPECT_EQ(simd.decode_quantized(llrs), scalar.decode_quantized(llrs)) << "trial " << trial;
+    }
+}
+#endif
+
+TEST(DecoderTest, BranchBoundDecoderN2) {
+    BranchBoundDecoder<2> decoder;
+    test_decoder_no_noise<2>(decoder, "BranchBoundDecoder<2>");
+}
+
+TEST(DecoderTest, BranchBoundDecoderN4) {
+    BranchBoundDecoder<4> decoder;
+    test_decoder_no_noise<4>(decoder, "BranchBoundDecoder<4>");
+}
+
+TEST(DecoderTest, BranchBoundDecoderN6) {
+    BranchBoundDecoder<6> decoder;
+    test_decoder_no_noise<6>(decoder, "BranchBoundDecoder<6>");
+}
+
+TEST(DecoderTest, BranchBoundDecoderN8) {
+    BranchBoundDecoder<8> decoder;
+    test_decoder_no_noise<8>(decoder, "BranchBoundDecoder<8>");
+}
+
+TEST(DecoderTest, BranchBoundDecoderN11) {
+    BranchBoundDecoder<11> decoder;
+    test_decoder_no_noise<11>(decoder, "BranchBoundDecoder<11>");
+}
+
+template<int N, typename Decoder>
+void test_matches_exhaustive(const Decoder& decoder, const std::string& name) {
+    PrecomputedDecoder<N> exhaustive;
+    std::mt19937 rng(N);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::uniform_int_distribution<int> small(-2, 2);
+
+    for (int trial = 0; trial < 400; ++trial) {
+        std::vector<double> llrs(CODEWORD_SIZE);
+        for (auto& llr : llrs) {
+            // Every other trial uses small integers to provoke metric ties.
+            llr = trial % 2 == 0 ? noise(rng) : small(rng);
+        }
+
+        EXPECT_EQ(decoder.decode(llrs), exhaustive.decode(llrs)) << name << " trial " << trial;
+    }
+}
+
+TEST(DecoderTest, BranchBoundMatchesExhaustiveSearch) {
+    test_matches_exhaustive<2>(BranchBoundDecoder<2>(), "BranchBoundDecoder<2>");
+    test_matches_exhaustive<4>(BranchBoundDecoder<4>(), "BranchBoundDecoder<4>");
+    test_matches_exhaustive<6>(BranchBoundDecoder<6>(), "BranchBoundDecoder<6>");
+    test_matches_exhaustive<8>(BranchBoundDecoder<8>(), "BranchBoundDecoder<8>");
+    test_matches_exhaustive<11>(BranchBoundDecoder<11>(), "BranchBoundDecoder<11>");
+}
+
+TEST(DecoderTest, BranchBoundPrunesAtHighSnr) {
+    BlockEncoder<11> encoder;
+    BranchBoundDecoder<11> decoder;
+
+    auto cw = encoder.encode(std::bitset<11>(0x5A5));
+    std::vector<double> llrs(CODEWORD_SIZE);
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        llrs[j] = cw[j] ? 1.0 + 0.01 * j : -1.0 - 0.01 * j;
+    }
+
+    size_t nodes = 0;
+    EXPECT_EQ(decoder.decode(llrs, nodes), std::bitset<11>(0x5A5));
+    EXPECT_LT(nodes, 2048u);
+}
+
+TEST(DecoderTest, EarlyExitMatchesExhaustiveSearch) {
+    test_matches_exhaustive<2>(EarlyExitDecoder<2>(), "EarlyExitDecoder<2>");
+    test_matches_exhaustive<4>(EarlyExitDecoder<4>(), "EarlyExitDecoder<4>");
+    test_matches_exhaustive<6>(EarlyExitDecoder<6>(), "EarlyExitDecoder<6>");
+    test_matches_exhaustive<8>(EarlyExitDecoder<8>(), "EarlyExitDecoder<8>");
+    test_matches_exhaustive<11>(EarlyExitDecoder<11>(), "EarlyExitDecoder<11>");
+}
+
+TEST(DecoderTest, EarlyExitOnCleanCodeword) {
+    BlockEncoder<11> encoder;
+    EarlyExitDecoder<11> decoder;
+    std::bitset<11> tx(0x3C1);
+    auto cw = encoder.encode(tx);
+
+    std::vector<double> llrs(CODEWORD_SIZE);
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        llrs[j] = cw[j] ? 0.5 : -0.5;
+    }
+
+    bool early_exit = false;
+    EXPECT_EQ(decoder.decode(llrs, early_exit), tx);
+    EXPECT_TRUE(early_exit);
+
+    // A single flipped sign is not a codeword: full search corrects it.
+    llrs[3] = -llrs[3] * 0.1;
+    EXPECT_EQ(decoder.decode(llrs, early_exit), tx);
+    EXPECT_FALSE(early_exit);
+
+    // All-zero LLRs tie every candidate: the reliability test must refuse.
+    std::vector<double> zeros(CODEWORD_SIZE, 0.0);
+    decoder.decode(zeros, early_exit);
+    EXPECT_FALSE(early_exit);
+}
+
+TEST(DecoderTest, QuantizeLlrsClipsToBitWidth) {
+    std::vector<double> llrs = {-3.0, -0.1, 0.0, 0.1, 3.0};
+
+    auto adaptive = quantize_llrs(llrs, 4, 0.0);
+    EXPECT_EQ(adaptive, (std::vector<int8_t>{-7, 0, 0, 0, 7}));
+
+    auto fixed = quantize_llrs(llrs, 4, 20.0);
+    EXPECT_EQ(fixed, (std::vector<int8_t>{-7, -2, 0, 2, 7}));
+
+    EXPECT_THROW(quantize_llrs(llrs, 9, 1.0), std::invalid_argument);
+}
+
+TEST(DecoderTest, UnrolledDecoderN2) {
+    UnrolledDecoder<2> decoder;
+    test_decoder_no_noise<2>(decoder, "UnrolledDecoder<2>");
+}
+
+TEST(DecoderTest, UnrolledDecoderN4) {
+    UnrolledDecoder<4> decoder;
+    test_decoder_no_noise<4>(decoder, "UnrolledDecoder<4>");
+}
+
+TEST(DecoderTest, UnrolledDecoderN6) {
+    UnrolledDecoder<6> decoder;
+    test_decoder_no_noise<6>(decoder, "UnrolledDecoder<6>");
+}
+
+TEST(DecoderTest, UnrolledDecoderN8) {
+    UnrolledDecoder<8> decoder;
+    test_decoder_no_noise<8>(decoder, "UnrolledDecoder<8>");
+}
+
+TEST(DecoderTest, UnrolledDecoderN11) {
+    UnrolledDecoder<11> decoder;
+    test_decoder_no_noise<11>(decoder, "UnrolledDecoder<11>");
+}
+
+template<int N>
+void test_unrolled_matches_scan() {
+    PrecomputedDecoder<N> reference;
+    test_matches_reference<N>(
+        [](const std::vector<double>& llrs) { return static_cast<unsigned long>(unrolled_decode<N>(llrs.data())); },
+        [&](const std::vector<double>& llrs) { return reference.decode(llrs).to_ulong(); },
+        "unrolled_decode<" + std::to_string(N) + ">");
+
+    // All candidates tie: the scans keep the first.
+    EXPECT_EQ(unrolled_decode<N>(std::vector<double>(CODEWORD_SIZE, 0.0).data()), 0u) << "N=" << N;
+}
+
+TEST(DecoderTest, UnrolledKernelMatchesCandidateScan) {
+    test_unrolled_matches_scan<2>();
+    test_unrolled_matches_scan<4>();
+    test_unrolled_matches_scan<6>();
+    test_unrolled_matches_scan<8>();
+    test_unrolled_matches_scan<11>();
+}
+
+template<int N>
+void test_unrolled_tolerates_nan() {
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        std::vector<double> llrs(CODEWORD_SIZE, 1.0);
+        llrs[j] = std::numeric_limits<double>::quiet_NaN();
+        EXPECT_LT(unrolled_decode<N>(llrs.data()), 1u << N) << "N=" << N << " position " << j;
+    }
+    const std::vector<double> all_nan(CODEWORD_SIZE, std::numeric_limits<double>::quiet_NaN());
+    EXPECT_LT(unrolled_decode<N>(all_nan.data()), 1u << N) << "N=" << N;
+}
+
+TEST(DecoderTest, UnrolledKernelToleratesNan) {
+    test_unrolled_tolerates_nan<2>();
+    test_unrolled_tolerates_nan<6>();
+    test_unrolled_tolerates_nan<8>();
+    test_unrolled_tolerates_nan<11>();
+}
+
 TEST(DecoderTest, AllDecodersSameResult) {
     BlockEncoder<4> encoder;
     std::bitset<4> tx("1010");
@@ -153,3 +476,512 @@ TEST(DecoderTest, WithNoise) {
     auto rx = decoder.decode(llrs);
     EXPECT_EQ(rx, tx);
 }
+
+template<int N>
+double osd_agreement_with_ml(int budget, double sigma) {
+    BlockEncoder<N> encoder;
+    PrecomputedDecoder<N> exhaustive;
+    OsdDecoder<N> osd(budget);
+    std::mt19937 rng(100 + N);
+    std::normal_distribution<double> noise(0.0, sigma);
+    std::uniform_int_distribution<int> info(0, (1 << N) - 1);
+
+    const int trials = 500;
+    int agreed = 0;
+    for (int trial = 0; trial < trials; ++trial) {
+        auto cw = encoder.encode(std::bitset<N>(info(rng)));
+        std::vector<double> llrs(CODEWORD_SIZE);
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            llrs[j] = (cw[j] ? 0.7 : -0.7) + noise(rng);
+        }
+        agreed += osd.decode(llrs) == exhaustive.decode(llrs);
+    }
+    return static_cast<double>(agreed) / trials;
+}
+
+TEST(DecoderTest, OsdDecoderNoNoise) {
+    OsdDecoder<2> osd2;
+    test_decoder_no_noise<2>(osd2, "OsdDecoder<2>");
+    OsdDecoder<6> osd6;
+    test_decoder_no_noise<6>(osd6, "OsdDecoder<6>");
+    OsdDecoder<11> osd11(1);
+    test_decoder_no_noise<11>(osd11, "OsdDecoder<11>(1)");
+}
+
+TEST(DecoderTest, OsdFullPatternListIsExhaustiveForSmallN) {
+    EXPECT_DOUBLE_EQ(osd_agreement_with_ml<2>(0, 0.8), 1.0);
+    EXPECT_DOUBLE_EQ(osd_agreement_with_ml<4>(16, 0.8), 1.0);
+}
+
+TEST(DecoderTest, OsdBudgetTradesAccuracy) {
+    EXPECT_EQ(OsdDecoder<11>().budget(), OsdDecoder<11>::DEFAULT_BUDGET);
+    EXPECT_EQ(OsdDecoder<11>(5).budget(), 5);
+
+    const double order0 = osd_agreement_with_ml<11>(1, 0.7);
+    const double order2 = osd_agreement_with_ml<11>(0, 0.7);
+    EXPECT_GE(order2, order0);
+    EXPECT_GT(order2, 0.97);
+}
+
+template<int N>
+DecodeResult<N> brute_force_full(const std::vector<double>& llrs) {
+    BlockEncoder<N> encoder;
+    CandidateRanking<N> ranking(true);
+    for (uint32_t i = 0; i < (1U << N); ++i) {
+        const auto cw = encoder.encode(std::bitset<N>(i));
+        double metric = 0.0;
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            if (cw[j]) {
+                metric += llrs[j];
+            }
+        }
+        ranking.add(i, metric);
+    }
+    return ranking.result(metric_span(llrs));
+}
+
+template<int N, typename Decoder>
+void test_decode_full_exact(const Decoder& decoder, double tolerance, const std::string& name) {
+    BlockEncoder<N> encoder;
+    std::mt19937 rng(200 + N);
+    std::normal_distribution<double> noise(0.0, 0.8);
+    std::uniform_int_distribution<int> info(0, (1 << N) - 1);
+
+    for (int trial = 0; trial < 200; ++trial) {
+        const auto cw = encoder.encode(std::bitset<N>(info(rng)));
+        std::vector<double> llrs(CODEWORD_SIZE);
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            llrs[j] = (cw[j] ? 1.0 : -1.0) + noise(rng);
+        }
+
+        const auto expected = brute_force_full<N>(llrs);
+        const auto full = decoder.decode_full(llrs, true);
+        EXPECT_EQ(full.bits, decoder.decode(llrs)) << name;
+        EXPECT_EQ(full.bits, expected.bits) << name;
+        EXPECT_EQ(full.index, full.bits.to_ulong()) << name;
+        EXPECT_NEAR(full.best_metric, expected.best_metric, tolerance) << name;
+        EXPECT_NEAR(full.second_metric, expected.second_metric, tolerance) << name;
+        ASSERT_EQ(full.soft.size(), static_cast<size_t>(N)) << name;
+        for (int i = 0; i < N; ++i) {
+            EXPECT_NEAR(full.soft[i], expected.soft[i], tolerance) << name << " bit " << i;
+        }
+        EXPECT_TRUE(decoder.decode_full(llrs).soft.empty()) << name;
+    }
+}
+
+TEST(DecoderTest, DecodeFullMatchesBruteForce) {
+    test_decode_full_exact<4>(BasicDecoder<4>(), 1e-9, "BasicDecoder<4>");
+    test_decode_full_exact<11>(BasicDecoder<11>(), 1e-9, "BasicDecoder<11>");
+    test_decode_full_exact<8>(PrecomputedDecoder<8>(), 1e-9, "PrecomputedDecoder<8>");
+    test_decode_full_exact<11>(PartialSumDecoder<11>(), 1e-9, "PartialSumDecoder<11>");
+    test_decode_full_exact<6>(PartialSumDecoder<6>(), 1e-9, "PartialSumDecoder<6>");
+    test_decode_full_exact<2>(UnrolledDecoder<2>(), 1e-9, "UnrolledDecoder<2>");
+    test_decode_full_exact<4>(UnrolledDecoder<4>(), 1e-9, "UnrolledDecoder<4>");
+    test_decode_full_exact<6>(UnrolledDecoder<6>(), 1e-9, "UnrolledDecoder<6>");
+    test_decode_full_exact<8>(UnrolledDecoder<8>(), 1e-9, "UnrolledDecoder<8>");
+#ifdef __AVX2__
+    test_decode_full_exact<11>(SimdDecoder<11>(), 1e-9, "SimdDecoder<11>");
+    test_decode_full_exact<6>(SimdDecoder<6>(), 1e-9, "SimdDecoder<6>");
+#endif
+    test_decode_full_exact<11>(BranchBoundDecoder<11>(), 1e-9, "BranchBoundDecoder<11>");
+    test_decode_full_exact<2>(BranchBoundDecoder<2>(), 1e-9, "BranchBoundDecoder<2>");
+    test_decode_full_exact<11>(EarlyExitDecoder<11>(), 1e-9, "EarlyExitDecoder<11>");
+    test_decode_full_exact<4>(OsdDecoder<4>(16), 1e-9, "OsdDecoder<4>(16)");
+}
+
+template<int N, typename Decoder>
+void test_decode_full_fixed_point(const Decoder& decoder, int bits, const std::string& name) {
+    BlockEncoder<N> encoder;
+    std::mt19937 rng(250 + N);
+    std::normal_distribution<double> noise(0.0, 0.8);
+    std::uniform_int_distribution<int> info(0, (1 << N) - 1);
+
+    for (int trial = 0; trial < 200; ++trial) {
+        const auto cw = encoder.encode(std::bitset<N>(info(rng)));
+        std::vector<double> llrs(CODEWORD_SIZE);
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            llrs[j] = (cw[j] ? 1.0 : -1.0) + noise(rng);
+        }
+
+        // Fixed-point metrics are exact over the LLRs the decoder actually sees.
+        double scale = 0.0;
+        const auto quantized = quantize_llrs(llrs, bits, 0.0, &scale);
+        std::vector<double> seen(CODEWORD_SIZE);
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            seen[j] = quantized[j] / scale;
+        }
+
+        const auto expected = brute_force_full<N>(seen);
+        const auto full = decoder.decode_full(llrs, true);
+        EXPECT_EQ(full.bits, decoder.decode(llrs)) << name;
+        EXPECT_NEAR(full.best_metric, expected.best_metric, 1e-9) << name;
+        EXPECT_NEAR(full.second_metric, expected.second_metric, 1e-9) << name;
+        for (int i = 0; i < N; ++i) {
+            EXPECT_NEAR(full.soft[i], expected.soft[i], 1e-9) << name << " bit " << i;
+        }
+    }
+}
+
+TEST(DecoderTest, DecodeFullFixedPointMatchesQuantizedBruteForce) {
+    test_decode_full_fixed_point<8>(FixedPointDecoder<8>(6), 6, "FixedPointDecoder<8>(6)");
+#ifdef __AVX2__
+    test_decode_full_fixed_point<11>(SimdFixedPointDecoder<11>(8), 8, "SimdFixedPointDecoder<11>(8)");
+#endif
+}
+
+TEST(DecoderTest, DecodeFullOsdRunnerUpIsBounded) {
+    BlockEncoder<11> encoder;
+    OsdDecoder<11> osd(1);
+    std::mt19937 rng(300);
+    std::normal_distribution<double> noise(0.0, 0.7);
+
+    for (int trial = 0; trial < 100; ++trial) {
+        const auto cw = encoder.encode(std::bitset<11>(trial));
+        std::vector<double> llrs(CODEWORD_SIZE);
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            llrs[j] = (cw[j] ? 1.0 : -1.0) + noise(rng);
+        }
+        const auto full = osd.decode_full(llrs);
+        const auto exact = brute_force_full<11>(llrs);
+        EXPECT_EQ(full.bits, osd.decode(llrs));
+        EXPECT_LE(full.best_metric, exact.best_metric + 1e-9);
+        EXPECT_GE(full.margin(), 0.0);
+    }
+}
+
+TEST(DecoderTest, HardDecisionDecoderN2) {
+    HardDecisionDecoder<2> lowest;
+    test_decoder_no_noise<2>(lowest, "HardDecisionDecoder<2>");
+    HardDecisionDecoder<2> soft_tie(HardTieBreak::SoftMetric);
+    test_decoder_no_noise<2>(soft_tie, "HardDecisionDecoder<2>(SoftMetric)");
+}
+
+TEST(DecoderTest, HardDecisionDecoderN4) {
+    HardDecisionDecoder<4> lowest;
+    test_decoder_no_noise<4>(lowest, "HardDecisionDecoder<4>");
+    HardDecisionDecoder<4> soft_tie(HardTieBreak::SoftMetric);
+    test_decoder_no_noise<4>(soft_tie, "HardDecisionDecoder<4>(SoftMetric)");
+}
+
+TEST(DecoderTest, HardDecisionDecoderN6) {
+    HardDecisionDecoder<6> lowest;
+    test_decoder_no_noise<6>(lowest, "HardDecisionDecoder<6>");
+    HardDecisionDecoder<6> soft_tie(HardTieBreak::SoftMetric);
+    test_decoder_no_noise<6>(soft_tie, "HardDecisionDecoder<6>(SoftMetric)");
+}
+
+TEST(DecoderTest, HardDecisionDecoderN8) {
+    HardDecisionDecoder<8> lowest;
+    test_decoder_no_noise<8>(lowest, "HardDecisionDecoder<8>");
+    HardDecisionDecoder<8> soft_tie(HardTieBreak::SoftMetric);
+    test_decoder_no_noise<8>(soft_tie, "HardDecisionDecoder<8>(SoftMetric)");
+}
+
+TEST(DecoderTest, HardDecisionDecoderN11) {
+    HardDecisionDecoder<11> lowest;
+    test_decoder_no_noise<11>(lowest, "HardDecisionDecoder<11>");
+    HardDecisionDecoder<11> soft_tie(HardTieBreak::SoftMetric);
+    test_decoder_no_noise<11>(soft_tie, "HardDecisionDecoder<11>(SoftMetric)");
+}
+
+// Minimum Hamming distance to the sliced LLRs by exhaustive scan; ties go to
+// the lowest index, or with `soft_tie` to the best soft metric.
+template<int N>
+unsigned long nearest_by_distance(const std::vector<double>& llrs, bool soft_tie) {
+    BlockEncoder<N> encoder;
+    int best_distance = CODEWORD_SIZE + 1;
+    unsigned long best = 0;
+    double best_metric = 0.0;
+    for (uint32_t i = 0; i < (1U << N); ++i) {
+        const auto cw = encoder.encode(std::bitset<N>(i));
+        int distance = 0;
+        double metric = 0.0;
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            distance += cw[j] != (llrs[j] > 0.0);
+            metric += cw[j] ? llrs[j] : 0.0;
+        }
+        if (distance < best_distance || (soft_tie && distance == best_distance && metric > best_metric)) {
+            best_distance = distance;
+            best = i;
+            best_metric = metric;
+        }
+    }
+    return best;
+}
+
+template<int N>
+void test_hard_decision_matches_distance_scan() {
+    HardDecisionDecoder<N> lowest;
+    HardDecisionDecoder<N> soft_tie(HardTieBreak::SoftMetric);
+    const std::string name = "HardDecisionDecoder<" + std::to_string(N) + ">";
+
+    test_matches_reference<N>(
+        [&](const std::vector<double>& llrs) { return lowest.decode(llrs).to_ulong(); },
+        [](const std::vector<double>& llrs) { return nearest_by_distance<N>(llrs, false); },
+        name, 300);
+    test_matches_reference<N>(
+        [&](const std::vector<double>& llrs) { return soft_tie.decode(llrs).to_ulong(); },
+        [](const std::vector<double>& llrs) { return nearest_by_distance<N>(llrs, true); },
+        name + "(SoftMetric)", 300);
+}
+
+TEST(DecoderTest, HardDecisionMatchesMinimumDistanceScan) {
+    test_hard_decision_matches_distance_scan<2>();
+    test_hard_decision_matches_distance_scan<4>();
+    test_hard_decision_matches_distance_scan<6>();
+    test_hard_decision_matches_distance_scan<8>();
+    test_hard_decision_matches_distance_scan<11>();
+}
+
+template<int N>
+void test_decode_full_hard_decision(const HardDecisionDecoder<N>& decoder, const std::string& name) {
+    BlockEncoder<N> encoder;
+    std::mt19937 rng(350 + N);
+    std::normal_distribution<double> noise(0.0, 0.8);
+    std::uniform_int_distribution<int> info(0, (1 << N) - 1);
+
+    for (int trial = 0; trial < 200; ++trial) {
+        const auto cw = encoder.encode(std::bitset<N>(info(rng)));
+        std::vector<double> llrs(CODEWORD_SIZE);
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            llrs[j] = (cw[j] ? 1.0 : -1.0) + noise(rng);
+        }
+
+        // Hard-decision metrics are exact over the LLRs sliced to +-mean|LLR|.
+        const double level = metric_span(llrs) / CODEWORD_SIZE;
+        std::vector<double> seen(CODEWORD_SIZE);
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            seen[j] = llrs[j] > 0.0 ? level : -level;
+        }
+
+        const auto expected = brute_force_full<N>(seen);
+        const auto full = decoder.decode_full(llrs, true);
+        EXPECT_EQ(full.bits, decoder.decode(llrs)) << name;
+        EXPECT_EQ(full.index, full.bits.to_ulong()) << name;
+        EXPECT_NEAR(full.best_metric, expected.best_metric, 1e-9) << name;
+        EXPECT_NEAR(full.second_metric, expected.second_metric, 1e-9) << name;
+        for (int i = 0; i < N; ++i) {
+            EXPECT_NEAR(std::abs(full.soft[i]), std::abs(expected.soft[i]), 1e-9) << name << " bit " << i;
+        }
+    }
+}
+
+TEST(DecoderTest, DecodeFullHardDecisionMatchesSlicedBruteForce) {
+    test_decode_full_hard_decision<6>(HardDecisionDecoder<6>(), "HardDecisionDecoder<6>");
+    test_decode_full_hard_decision<11>(HardDecisionDecoder<11>(), "HardDecisionDecoder<11>");
+    test_decode_full_hard_decision<11>(HardDecisionDecoder<11>(HardTieBreak::SoftMetric),
+                                       "HardDecisionDecoder<11>(SoftMetric)");
+}
+
+TEST(DecoderTest, NormalizedCorrelationSeparatesCodewordFromNoise) {
+    BlockEncoder<11> encoder;
+    BasicDecoder<11> decoder;
+
+    const auto cw = encoder.encode(std::bitset<11>(0x2A5));
+    std::vector<double> llrs(CODEWORD_SIZE);
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        llrs[j] = cw[j] ? 3.0 : -3.0;
+    }
+    EXPECT_NEAR(normalized_correlation(decoder.decode_full(llrs).best_metric, llrs), 1.0, 1e-12);
+
+    std::mt19937 rng(400);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    double total = 0.0;
+    for (int trial = 0; trial < 200; ++trial) {
+        for (auto& llr : llrs) {
+            llr = noise(rng);
+        }
+        total += normalized_correlation(decoder.decode_full(llrs).best_metric, llrs);
+    }
+    EXPECT_LT(total / 200, 0.75);
+}
+
+TEST(DecoderTest, ParallelDecoderNoNoise) {
+    ParallelDecoder<4> d4(2);
+    test_decoder_no_noise<4>(d4, "ParallelDecoder<4>(2)");
+    ParallelDecoder<11> d11(3);
+    test_decoder_no_noise<11>(d11, "ParallelDecoder<11>(3)");
+}
+
+TEST(DecoderTest, ParallelDecoderMatchesSerialScan) {
+    BlockEncoder<11> encoder;
+    PartialSumDecoder<11> reference;
+    std::mt19937 rng(500);
+    std::normal_distribution<double> noise(0.0, 1.0);
+
+    for (int helpers : {0, 1, 3}) {
+        ParallelDecoder<11> decoder(helpers);
+        EXPECT_EQ(decoder.helpers(), helpers);
+        if (helpers == 0) {
+            EXPECT_FALSE(decoder.parallel());
+        }
+
+        for (int trial = 0; trial < 50; ++trial) {
+            const auto cw = encoder.encode(std::bitset<11>(trial * 37));
+            std::vector<double> llrs(CODEWORD_SIZE);
+            for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+                llrs[j] = (cw[j] ? 0.8 : -0.8) + noise(rng);
+            }
+            const auto expected = reference.decode(llrs);
+            EXPECT_EQ(decoder.decode(llrs, true), expected) << helpers << " helpers";
+            EXPECT_EQ(decoder.decode(llrs, false), expected) << helpers << " helpers";
+            EXPECT_EQ(decoder.decode_full(llrs).bits, expected) << helpers << " helpers";
+        }
+    }
+}
+
+TEST(DecoderTest, ParallelDecoderIsSafeFromSeveralThreads) {
+    BlockEncoder<8> encoder;
+    ParallelDecoder<8> decoder(2);
+
+    auto worker = [&](int offset, int& errors) {
+        for (int i = 0; i < 40; ++i) {
+            const std::bitset<8> tx((offset + i * 7) & 0xFF);
+            const auto cw = encoder.encode(tx);
+            std::vector<double> llrs(CODEWORD_SIZE);
+            for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+                llrs[j] = cw[j] ? 1.0 : -1.0;
+            }
+            errors += decoder.decode(llrs, true) != tx;
+        }
+    };
+
+    int errors_a = 0;
+    int errors_b = 0;
+    std::thread a(worker, 0, std::ref(errors_a));
+    std::thread b(worker, 100, std::ref(errors_b));
+    a.join();
+    b.join();
+    EXPECT_EQ(errors_a, 0);
+    EXPECT_EQ(errors_b, 0);
+}
+
+template<int N>
+void test_known_bits(const KnownBits& known) {
+    BlockEncoder<N> encoder;
+    KnownBitsDecoder<N> decoder(known);
+    EXPECT_EQ(decoder.candidates(), 1ULL << (N - known.count()));
+
+    std::mt19937 rng(600 + N);
+    std::normal_distribution<double> noise(0.0, 1.2);
+    std::uniform_int_distribution<uint32_t> info(0, (1U << N) - 1);
+
+    for (int trial = 0; trial < 100; ++trial) {
+        const uint32_t tx = known.apply(info(rng));
+        const auto cw = encoder.encode(std::bitset<N>(tx));
+        std::vector<double> llrs(CODEWORD_SIZE);
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            llrs[j] = (cw[j] ? 1.0 : -1.0) + noise(rng);
+        }
+
+        // Brute force over the words consistent with the known bits.
+        CandidateRanking<N> ranking(false);
+        for (uint32_t i = 0; i < (1U << N); ++i) {
+            if (known.apply(i) != i) {
+                continue;
+            }
+            const auto candidate = encoder.encode(std::bitset<N>(i));
+            double metric = 0.0;
+            for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+                metric += candidate[j] ? llrs[j] : 0.0;
+            }
+            ranking.add(i, metric);
+        }
+        const auto expected = ranking.result(metric_span(llrs));
+
+        const auto full = decoder.decode_full(llrs, true);
+        EXPECT_EQ(decoder.decode(llrs), expected.bits);
+        EXPECT_EQ(full.bits, expected.bits);
+        EXPECT_NEAR(full.best_metric, expected.best_metric, 1e-9);
+        EXPECT_NEAR(full.second_metric, expected.second_metric, 1e-9);
+        EXPECT_EQ(known.apply(full.index), full.index);
+    }
+}
+
+TEST(DecoderTest, KnownBitsDecoderSearchesAffineSubcode) {
+    test_known_bits<4>(make_known_bits(4, {1}, {1}));
+    test_known_bits<8>(make_known_bits(8, {0, 5, 7}, {1, 0, 1}));
+    test_known_bits<11>(make_known_bits(11, {2, 3, 4, 9}, {0, 1, 1, 0}));
+    test_known_bits<11>(KnownBits{});
+
+    KnownBitsDecoder<6> all(make_known_bits(6, {0, 1, 2, 3, 4, 5}, {1, 0, 1, 1, 0, 0}));
+    EXPECT_EQ(all.candidates(), 1u);
+    EXPECT_EQ(all.decode(std::vector<double>(CODEWORD_SIZE, 0.0)).to_ulong(), 0b001101u);
+}
+
+TEST(DecoderTest, KnownBitsRejectsInvalidSpecs) {
+    EXPECT_THROW(make_known_bits(4, {4}, {0}), std::invalid_argument);
+    EXPECT_THROW(make_known_bits(4, {1}, {2}), std::invalid_argument);
+    EXPECT_THROW(make_known_bits(4, {1, 1}, {0, 0}), std::invalid_argument);
+    EXPECT_THROW(make_known_bits(4, {1, 2}, {0}), std::invalid_argument);
+    EXPECT_THROW(KnownBitsDecoder<2>(make_known_bits(4, {3}, {1})), std::invalid_argument);
+}
+
+template<int N>
+void expect_size_hypothesis(const SizeHypothesis& h, const std::vector<double>& llrs) {
+    const auto expected = PartialSumDecoder<N>().decode_full(llrs, false);
+    EXPECT_EQ(h.n, N);
+    EXPECT_EQ(h.bits, expected.index);
+    EXPECT_NEAR(h.best_metric, expected.best_metric, 1e-9);
+    EXPECT_NEAR(h.second_metric, expected.second_metric, 1e-9);
+    EXPECT_NEAR(h.correlation, normalized_correlation(expected.best_metric, llrs), 1e-12);
+}
+
+TEST(DecoderTest, BlindDetectorMatchesPerSizeDecoders) {
+    const BlindDetector detector;
+    BlockEncoder<11> encoder;
+    std::mt19937 rng(46);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::uniform_int_distribution<uint32_t> info(0, (1U << 11) - 1);
+
+    for (int trial = 0; trial < 50; ++trial) {
+        const auto cw = encoder.encode(std::bitset<11>(info(rng)));
+        std::vector<double> llrs(CODEWORD_SIZE);
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            llrs[j] = (cw[j] ? 1.0 : -1.0) + noise(rng);
+        }
+
+        const BlindDetection detection = detector.detect(llrs);
+        ASSERT_EQ(detection.sizes.size(), 5u);
+        expect_size_hypothesis<2>(detection.sizes[0], llrs);
+        expect_size_hypothesis<4>(detection.sizes[1], llrs);
+        expect_size_hypothesis<6>(detection.sizes[2], llrs);
+        expect_size_hypothesis<8>(detection.sizes[3], llrs);
+        expect_size_hypothesis<11>(detection.sizes[4], llrs);
+    }
+}
+
+template<int N>
+void expect_blind_picks_size(const BlindDetector& detector, uint32_t word) {
+    const auto cw = BlockEncoder<N>().encode(std::bitset<N>(word));
+    std::vector<double> llrs(CODEWORD_SIZE);
+    for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+        llrs[j] = cw[j] ? 1.0 : -1.0;
+    }
+
+    const BlindDetection detection = detector.detect(llrs);
+    EXPECT_EQ(detection.decision().n, N);
+    EXPECT_EQ(detection.decision().bits, word);
+}
+
+TEST(DecoderTest, BlindDetectorPicksTransmittedSize) {
+    const BlindDetector detector({11, 4, 8, 2, 6, 4});
+    EXPECT_EQ(detector.sizes(), (std::vector<int>{2, 4, 6, 8, 11}));
+
+    // Each word uses its top bit, so no smaller codebook contains it.
+    expect_blind_picks_size<2>(detector, 0b10);
+    expect_blind_picks_size<4>(detector, 0b1001);
+    expect_blind_picks_size<6>(detector, 0b110110);
+    expect_blind_picks_size<8>(detector, 0b10000001);
+    expect_blind_picks_size<11>(detector, 0b10101010101);
+
+    // A word below 2^2 is a codeword of every size; the smallest wins.
+    expect_blind_picks_size<2>(detector, 0b01);
+}
+
+TEST(DecoderTest, BlindDetectorRejectsInvalidSizes) {
+    EXPECT_THROW(BlindDetector({3}), std::invalid_argument);
+    EXPECT_THROW(BlindDetector({2, 13}), std::invalid_argument);
+    EXPECT_THROW(BlindDetector({2, 4}, -0.1), std::invalid_argument);
+    EXPECT_THROW(BlindDetector().detect(std::vector<double>(10)), std::invalid_argument);
+}
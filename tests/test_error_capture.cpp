@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "error_capture.hpp"
+#include "simulation.hpp"
+
+using namespace qpsk;
+
+namespace fs = std::filesystem;
+
+TEST(RingBufferTest, KeepsMostRecentValues) {
+    RingBuffer<int> ring(3);
+    for (int i = 0; i < 5; ++i) {
+        ring.push(i);
+    }
+
+    EXPECT_EQ(ring.pushed(), 5u);
+    EXPECT_EQ(ring.size(), 3u);
+    EXPECT_EQ(ring.snapshot(), (std::vector<int>{2, 3, 4}));
+}
+
+TEST(ErrorCaptureTest, CaptureDoesNotChangeResults) {
+    SimulationConfig config;
+    config.n = 6;
+    config.snr_db = -4.0;
+    config.iterations = 3000;
+    config.seed = 21;
+    config.decoder = "Precomputed";
+
+    SimulationResult plain = simulate(config);
+
+    config.capture.failures = 16;
+    config.capture.successes = 4;
+    config.capture.sample_period = 100;
+    SimulationResult captured = simulate(config);
+
+    EXPECT_EQ(plain.failed, captured.failed);
+    EXPECT_EQ(captured.capture.failures_seen, static_cast<uint64_t>(captured.failed));
+    EXPECT_EQ(captured.capture.successes_sampled, static_cast<uint64_t>(captured.success / 100));
+    ASSERT_EQ(captured.capture.records.size(), 20u);
+
+    for (size_t i = 0; i < captured.capture.records.size(); ++i) {
+        const auto& r = captured.capture.records[i];
+        EXPECT_EQ(r.failed, i < 16 ? 1 : 0);
+        EXPECT_EQ(r.n, 6);
+        EXPECT_EQ(r.failed != 0, r.tx_bits != r.rx_bits);
+        // Precomputed is ML, so the decoded word is the best-metric codeword.
+        EXPECT_EQ(r.rx_bits, r.best_index);
+        EXPECT_NE(r.best_index, r.runner_up_index);
+        EXPECT_GE(r.best_metric, r.runner_up_metric);
+    }
+}
+
+TEST(ErrorCaptureTest, FileRoundtrip) {
+    SimulationConfig config;
+    config.n = 4;
+    config.snr_db = -6.0;
+    config.iterations = 500;
+    config.seed = 2;
+    config.decoder = "Precomputed";
+    config.capture.failures = 8;
+    config.capture.successes = 2;
+    config.capture.sample_period = 10;
+
+    const CaptureDump dump = simulate(config).capture;
+
+    const fs::path path = fs::temp_directory_path() /
+        ("qpsk_capture_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + ".bin");
+    write_capture(path.string(), dump);
+    const CaptureDump loaded = read_capture(path.string());
+    fs::remove(path);
+
+    EXPECT_EQ(loaded.failures_seen, dump.failures_seen);
+    EXPECT_EQ(loaded.successes_sampled, dump.successes_sampled);
+    ASSERT_EQ(loaded.records.size(), dump.records.size());
+    for (size_t i = 0; i < dump.records.size(); ++i) {
+        EXPECT_EQ(loaded.records[i].trial, dump.records[i].trial);
+        EXPECT_EQ(loaded.records[i].tx_bits, dump.records[i].tx_bits);
+        EXPECT_FLOAT_EQ(loaded.records[i].rx[7], dump.records[i].rx[7]);
+    }
+}
@@ -101,3 +101,10 @@ TEST(JsonHelpersTest, ComplexRoundtrip) {
         EXPECT_DOUBLE_EQ(c1.imag(), c2.imag());
     }
 }
+
+TEST(JsonHelpersTest, ScalarOrArray) {
+    EXPECT_EQ(scalar_or_array<int>(json(11)), std::vector<int>({11}));
+    EXPECT_EQ(scalar_or_array<int>(json::parse("[2, 4, 6]")), std::vector<int>({2, 4, 6}));
+    EXPECT_EQ(scalar_or_array<double>(json(1.5)), std::vector<double>({1.5}));
+    EXPECT_THROW(scalar_or_array<int>(json("eleven")), json::exception);
+}
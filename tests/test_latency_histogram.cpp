@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "utils/latency_histogram.hpp"
+
+using namespace qpsk;
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram h;
+    for (uint64_t v = 1; v <= 50; ++v) {
+        h.record(v);
+    }
+
+    EXPECT_EQ(h.count(), 50u);
+    EXPECT_EQ(h.min(), 1u);
+    EXPECT_EQ(h.max(), 50u);
+    EXPECT_EQ(h.percentile(50.0), 25u);
+    EXPECT_EQ(h.percentile(100.0), 50u);
+    EXPECT_DOUBLE_EQ(h.mean(), 25.5);
+}
+
+TEST(LatencyHistogramTest, BucketsBoundRelativeError) {
+    for (uint64_t v : {64ULL, 65ULL, 1000ULL, 123456ULL, 987654321ULL, 1ULL << 40}) {
+        size_t index = LatencyHistogram::bucket_index(v);
+        uint64_t upper = LatencyHistogram::bucket_upper(index);
+
+        EXPECT_GE(upper, v);
+        EXPECT_LE(static_cast<double>(upper - v) / v, 1.0 / LatencyHistogram::HALF_SUB_BUCKETS);
+        EXPECT_LT(index, LatencyHistogram::BUCKETS);
+    }
+
+    EXPECT_EQ(LatencyHistogram::bucket_index(UINT64_MAX), LatencyHistogram::BUCKETS - 1);
+}
+
+TEST(LatencyHistogramTest, TailPercentiles) {
+    LatencyHistogram h;
+    for (int i = 0; i < 990; ++i) {
+        h.record(1000);
+    }
+    for (int i = 0; i < 10; ++i) {
+        h.record(1000000);
+    }
+
+    EXPECT_NEAR(static_cast<double>(h.percentile(50.0)), 1000.0, 1000.0 / 32);
+    EXPECT_NEAR(static_cast<double>(h.percentile(99.0)), 1000.0, 1000.0 / 32);
+    EXPECT_NEAR(static_cast<double>(h.percentile(99.9)), 1000000.0, 1000000.0 / 32);
+    EXPECT_EQ(h.max(), 1000000u);
+}
+
+TEST(LatencyHistogramTest, MergeAndReset) {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    a.record(10);
+    b.record(20);
+    b.record(30);
+
+    a.merge(b);
+    EXPECT_EQ(a.count(), 3u);
+    EXPECT_EQ(a.min(), 10u);
+    EXPECT_EQ(a.max(), 30u);
+
+    a.reset();
+    EXPECT_EQ(a.count(), 0u);
+    EXPECT_EQ(a.percentile(99.0), 0u);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "simulation.hpp"
+#include "utils/spsc_ring.hpp"
+
+using namespace qpsk;
+
+TEST(SpscRingTest, BoundedFifo) {
+    SpscRing<int> ring(3);
+    EXPECT_EQ(ring.capacity(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    EXPECT_FALSE(ring.try_push(4));
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.try_pop(value));
+}
+
+TEST(SpscRingTest, TransfersAcrossThreadsInOrder) {
+    SpscRing<int> ring(8);
+    constexpr int COUNT = 100000;
+
+    std::thread producer([&ring] {
+        for (int i = 0; i < COUNT; ++i) {
+            while (!ring.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    long long sum = 0;
+    bool ordered = true;
+    for (int expected = 0; expected < COUNT; ++expected) {
+        int value;
+        while (!ring.try_pop(value)) {
+            std::this_thread::yield();
+        }
+        ordered = ordered && value == expected;
+        sum += value;
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(sum, static_cast<long long>(COUNT) * (COUNT - 1) / 2);
+}
+
+TEST(PipelinedSimulationTest, MatchesSerialStatisticsAndIsReproducible) {
+    SimulationConfig config;
+    config.n = 6;
+    config.snr_db = -4.0;
+    config.iterations = 20000;
+    config.seed = 11;
+    config.decoder = "Precomputed";
+
+    const double serial_bler = static_cast<double>(simulate(config).failed) / config.iterations;
+
+    config.engine = "pipelined";
+    const SimulationResult first = simulate(config);
+    const SimulationResult second = simulate(config);
+
+    EXPECT_EQ(first.success + first.failed, config.iterations);
+    EXPECT_EQ(first.failed, second.failed);
+    EXPECT_NEAR(static_cast<double>(first.failed) / config.iterations, serial_bler, 0.02);
+
+    ASSERT_EQ(first.stages.size(), DEFAULT_PIPELINE.size());
+    for (size_t g = 0; g < first.stages.size(); ++g) {
+        EXPECT_EQ(first.stages[g].name, DEFAULT_PIPELINE[g]);
+        EXPECT_EQ(first.stages[g].blocks, (config.iterations + 255) / 256);
+        EXPECT_GT(first.stages[g].busy_ns, 0.0);
+        EXPECT_LE(first.stages[g].busy_ns, first.stages[g].wall_ns);
+    }
+}
+
+TEST(PipelinedSimulationTest, StageGroupingDoesNotChangeResults) {
+    SimulationConfig config;
+    config.n = 4;
+    config.snr_db = -6.0;
+    config.iterations = 3000;
+    config.seed = 4;
+    config.decoder = "Precomputed";
+    config.engine = "pipelined";
+
+    const long long failed = simulate(config).failed;
+
+    config.pipeline_stages = {"bits+encode+modulate+channel+demodulate+decode"};
+    EXPECT_EQ(simulate(config).failed, failed);
+
+    config.pipeline_stages = {"bits", "encode", "modulate", "channel", "demodulate", "decode"};
+    const SimulationResult split = simulate(config);
+    EXPECT_EQ(split.failed, failed);
+    EXPECT_EQ(split.stages.size(), 6u);
+}
+
+TEST(PipelinedSimulationTest, RejectsInvalidPipelines) {
+    SimulationConfig config;
+    config.n = 4;
+    config.iterations = 10;
+    config.engine = "pipelined";
+
+    config.pipeline_stages = {"bits+encode", "channel+modulate", "demodulate+decode"};
+    EXPECT_THROW(simulate(config), std::invalid_argument);
+
+    config.pipeline_stages = {"bits+encode+modulate+channel"};
+    EXPECT_THROW(simulate(config), std::invalid_argument);
+
+    config.pipeline_stages.clear();
+    config.compare_to_ml = true;
+    EXPECT_THROW(simulate(config), std::invalid_argument);
+
+    config.compare_to_ml = false;
+    config.engine = "vectorized";
+    EXPECT_THROW(simulate(config), std::invalid_argument);
+}
@@ -91,3 +91,27 @@ TEST(QPSKTest, IntegrationWithDecoder) {
 
     EXPECT_EQ(recovered, info);
 }
+
+TEST(QPSKTest, DemodulateQuantizedKeepsSignsAndClips) {
+    QPSK mod;
+    std::vector<Complex> symbols(QPSK_SYMBOLS_COUNT, Complex(NORM, -NORM));
+    symbols[0] = Complex(100.0, -100.0);
+
+    const double scale = QPSK::quantization_scale(10.0, 6);
+    auto llrs = mod.demodulate_quantized(symbols, 6, scale);
+
+    ASSERT_EQ(llrs.size(), CODEWORD_SIZE);
+    EXPECT_EQ(llrs[0], 31);
+    EXPECT_EQ(llrs[1], -31);
+    for (size_t i = 2; i < CODEWORD_SIZE; i += 2) {
+        EXPECT_GT(llrs[i], 0);
+        EXPECT_LT(llrs[i + 1], 0);
+        EXPECT_LT(llrs[i], 31);
+    }
+}
+
+TEST(QPSKTest, QuantizationScaleGrowsWithSnr) {
+    EXPECT_LT(QPSK::quantization_scale(-5.0, 8), QPSK::quantization_scale(10.0, 8));
+    EXPECT_LT(QPSK::quantization_scale(0.0, 4), QPSK::quantization_scale(0.0, 8));
+    EXPECT_THROW(QPSK::quantization_scale(0.0, 1), std::invalid_argument);
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "realtime.hpp"
+
+using namespace qpsk;
+
+namespace {
+
+RealtimeConfig small_config() {
+    RealtimeConfig config;
+    config.sizes = {2, 6, 11};
+    config.snr_db = 20.0;
+    config.tti_ns = 2000000;
+    config.reports_per_tti = 4;
+    config.ttis = 20;
+    config.workers = 2;
+    config.seed = 5;
+    config.decoder = "Precomputed";
+    return config;
+}
+
+} // namespace
+
+TEST(RealtimeTest, AccountsEveryTti) {
+    const RealtimeResult result = run_realtime(small_config());
+
+    EXPECT_EQ(result.ttis, 20);
+    EXPECT_EQ(result.reports, 80);
+    EXPECT_EQ(result.failed, 0);
+    EXPECT_EQ(result.processing.count(), 20u);
+    EXPECT_EQ(result.wakeup.count(), 40u);
+    EXPECT_EQ(result.slack.count() + result.lateness.count(), 20u);
+    EXPECT_EQ(result.lateness.count(), static_cast<uint64_t>(result.misses));
+}
+
+TEST(RealtimeTest, ImpossibleDeadlineMisses) {
+    RealtimeConfig config = small_config();
+    config.tti_ns = 100;
+    config.reports_per_tti = 256;
+    config.workers = 1;
+
+    const RealtimeResult result = run_realtime(config);
+    EXPECT_EQ(result.misses, result.ttis);
+}
+
+TEST(RealtimeTest, CapacitySearchStopsAtLimit) {
+    RealtimeConfig config = small_config();
+    config.tti_ns = 5000000;
+    config.ttis = 4;
+
+    const RealtimeCapacity capacity = find_max_reports_per_tti(config, 1.0, 6);
+    EXPECT_EQ(capacity.max_reports_per_tti, 6);
+    ASSERT_FALSE(capacity.probes.empty());
+    EXPECT_EQ(capacity.probes.front().reports_per_tti, 1);
+}
+
+TEST(RealtimeTest, RejectsInvalidConfig) {
+    RealtimeConfig config = small_config();
+    config.sizes = {3};
+    EXPECT_THROW(run_realtime(config), std::invalid_argument);
+
+    config = small_config();
+    config.workers = 0;
+    EXPECT_THROW(run_realtime(config), std::invalid_argument);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <set>
+
+#include "shard_queue.hpp"
+#include "simulation.hpp"
+
+using namespace qpsk;
+
+namespace fs = std::filesystem;
+
+class ShardQueueTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = fs::temp_directory_path() /
+               ("qpsk_shard_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        fs::remove_all(dir_);
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir_);
+    }
+
+    ShardJob small_job() const {
+        ShardJob job;
+        job.sizes = {2, 4};
+        job.snrs_db = {-5.0, 0.0};
+        job.iterations = 250;
+        job.shard_size = 100;
+        job.seed = 7;
+        job.decoder = "Precomputed";
+        return job;
+    }
+
+    fs::path dir_;
+};
+
+TEST_F(ShardQueueTest, CreateSplitsIntoShards) {
+    ShardQueue queue(dir_.string());
+    EXPECT_FALSE(queue.exists());
+
+    queue.create(small_job());
+
+    EXPECT_TRUE(queue.exists());
+    EXPECT_EQ(queue.shard_count(), 2 * 2 * 3);
+    EXPECT_EQ(queue.shard(2).trials, 50);
+    EXPECT_EQ(queue.shard(2).first_trial, 200);
+    EXPECT_THROW(queue.create(small_job()), std::invalid_argument);
+}
+
+TEST_F(ShardQueueTest, ClaimsAreExclusive) {
+    ShardQueue queue(dir_.string());
+    queue.create(small_job());
+
+    std::set<int> claimed;
+    while (auto spec = queue.claim(3600.0)) {
+        EXPECT_TRUE(claimed.insert(spec->id).second) << "shard " << spec->id << " claimed twice";
+    }
+
+    EXPECT_EQ(static_cast<int>(claimed.size()), queue.shard_count());
+}
+
+TEST_F(ShardQueueTest, StaleLeaseIsReclaimed) {
+    ShardQueue queue(dir_.string());
+    queue.create(small_job());
+
+    auto first = queue.claim(3600.0);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->id, 0);
+
+    auto stolen = queue.claim(-1.0);
+    ASSERT_TRUE(stolen.has_value());
+    EXPECT_EQ(stolen->id, 0);
+}
+
+TEST_F(ShardQueueTest, ShardSeedsAreDeterministicAndDistinct) {
+    EXPECT_EQ(shard_seed(1, 5), shard_seed(1, 5));
+    EXPECT_NE(shard_seed(1, 5), shard_seed(1, 6));
+    EXPECT_NE(shard_seed(1, 5), shard_seed(2, 5));
+}
+
+TEST_F(ShardQueueTest, MergeSumsPartialCounts) {
+    ShardQueue queue(dir_.string());
+    queue.create(small_job());
+
+    EXPECT_FALSE(queue.merge()["complete"].get<bool>());
+
+    run_shard_worker(queue, 3600.0);
+
+    json merged = queue.merge();
+    EXPECT_TRUE(merged["complete"].get<bool>());
+    ASSERT_EQ(merged["results"].size(), 4u);
+
+    for (const auto& row : merged["results"]) {
+        EXPECT_EQ(row["success"].get<long long>() + row["failed"].get<long long>(), 250);
+    }
+}
+
+TEST_F(ShardQueueTest, LocalWorkersMatchSingleProcess) {
+    ShardJob job = small_job();
+
+    fs::path single_dir = dir_ / "single";
+    ShardQueue single(single_dir.string());
+    single.create(job);
+    run_shard_worker(single, 3600.0);
+
+    fs::path parallel_dir = dir_ / "parallel";
+    json input;
+    input["queue_dir"] = parallel_dir.string();
+    input["num_of_pucch_f2_bits"] = job.sizes;
+    input["snr_db"] = job.snrs_db;
+    input["iterations"] = job.iterations;
+    input["shard_size"] = job.shard_size;
+    input["seed"] = job.seed;
+    input["decoder"] = job.decoder;
+    input["workers"] = 3;
+
+    json output;
+    ASSERT_EQ(run_sharded_simulation_mode(input, output), 0);
+    EXPECT_TRUE(output["complete"].get<bool>());
+    EXPECT_EQ(output["results"], single.merge()["results"]);
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include "simulation.hpp"
+
+using namespace qpsk;
+
+TEST(SimulationTest, DtxDetectionAtHighSnr) {
+    SimulationConfig config;
+    config.n = 11;
+    config.snr_db = 8.0;
+    config.iterations = 2000;
+    config.seed = 8;
+    config.dtx_threshold = 0.85;
+
+    const SimulationResult result = simulate(config);
+    EXPECT_EQ(result.dtx_trials, config.iterations);
+    EXPECT_LT(result.missed_detections, config.iterations / 20);
+    EXPECT_LT(result.false_alarms, result.dtx_trials / 20);
+
+    config.dtx_threshold = 2.0;
+    const SimulationResult rejecting = simulate(config);
+    EXPECT_EQ(rejecting.missed_detections, config.iterations);
+    EXPECT_EQ(rejecting.false_alarms, 0);
+
+    // Early exit keeps its shortcut and the same decisions under DTX.
+    config.dtx_threshold = 0.85;
+    config.early_exit = true;
+    const SimulationResult early = simulate(config);
+    EXPECT_GT(early.early_exits, config.iterations / 2);
+    EXPECT_EQ(early.missed_detections, result.missed_detections);
+    EXPECT_EQ(early.false_alarms, result.false_alarms);
+    EXPECT_EQ(early.failed, result.failed);
+}
+
+TEST(SimulationTest, KnownBitsLowerSimulatedBler) {
+    SimulationConfig config;
+    config.n = 11;
+    config.snr_db = -3.0;
+    config.iterations = 2000;
+    config.seed = 9;
+    config.decoder = "PartialSum";
+    config.known_bits = make_known_bits(11, {0, 1, 2, 3}, {1, 0, 0, 1});
+
+    const SimulationResult result = simulate(config);
+    EXPECT_EQ(result.success + result.failed, config.iterations);
+    EXPECT_LT(result.failed, result.full_search_failed);
+
+    config.early_exit = true;
+    EXPECT_THROW(simulate(config), std::invalid_argument);
+}
+
+TEST(SimulationTest, BlindDetectionErrorsAreAmbiguousWordsAtHighSnr) {
+    SimulationConfig config;
+    config.n = 8;
+    config.snr_db = 8.0;
+    config.iterations = 2000;
+    config.seed = 10;
+    config.decoder = "PartialSum";
+    config.blind_sizes = {2, 4, 6, 8, 11};
+
+    const SimulationResult result = simulate(config);
+    ASSERT_EQ(result.blind_selected.size(), 5u);
+    const long long size_errors = config.iterations - result.blind_selected[3];
+    // Words below 2^6 are also 6-bit codewords and go to the smaller size.
+    EXPECT_NEAR(static_cast<double>(result.blind_ambiguous) / config.iterations, 0.25, 0.04);
+    EXPECT_LE(std::abs(size_errors - result.blind_ambiguous), config.iterations / 100);
+    EXPECT_GE(result.blind_failed, size_errors);
+
+    config.blind_sizes = {2, 4};
+    EXPECT_THROW(simulate(config), std::invalid_argument);
+}
+
+TEST(SimulationTest, HardDecisionLosesToSoftMl) {
+    SimulationConfig config;
+    config.n = 11;
+    config.snr_db = 0.0;
+    config.iterations = 2000;
+    config.seed = 11;
+    config.decoder = "HardDecision";
+    config.compare_to_ml = true;
+
+    const SimulationResult result = simulate(config);
+    EXPECT_GT(result.failed, result.ml_failed);
+    EXPECT_GE(result.disagreements, result.failed - result.ml_failed);
+}
+
+TEST(SimulationTest, BlindDetectionIsNotTimedAsDecode) {
+    SimulationConfig config;
+    config.n = 8;
+    config.snr_db = 2.0;
+    config.iterations = 2000;
+    config.seed = 12;
+    config.decoder = "PartialSum";
+    config.compare_to_ml = true;
+    const SimulationResult plain = simulate(config);
+
+    // Blind detection scans every size, N=11 included, per trial; inside the
+    // decode window it would multiply decode_ns several times over.
+    config.blind_sizes = {2, 4, 6, 8, 11};
+    const SimulationResult blind = simulate(config);
+    EXPECT_EQ(blind.failed, plain.failed);
+    EXPECT_LT(blind.decode_ns, 2.0 * plain.decode_ns);
+}
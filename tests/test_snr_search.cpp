@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "snr_search.hpp"
+#include "simulation.hpp"
+
+using namespace qpsk;
+
+TEST(SnrSearchTest, WilsonIntervalContainsEstimate) {
+    const double z = normal_quantile(0.975);
+    EXPECT_NEAR(z, 1.959964, 1e-5);
+
+    auto [low, high] = wilson_interval(10, 1000, z);
+    EXPECT_LT(low, 0.01);
+    EXPECT_GT(high, 0.01);
+
+    auto [zero_low, zero_high] = wilson_interval(0, 1000, z);
+    EXPECT_NEAR(zero_low, 0.0, 1e-12);
+    EXPECT_GT(zero_high, 0.0);
+    EXPECT_LT(zero_high, 0.01);
+}
+
+TEST(SnrSearchTest, FindsTargetWithFewTrials) {
+    SnrSearchConfig config;
+    config.n = 2;
+    config.target_bler = 0.05;
+    config.seed = 11;
+    config.decoder = "Precomputed";
+
+    SnrSearchResult result = search_snr(config);
+
+    EXPECT_TRUE(result.converged);
+    EXPECT_LE(result.snr_low_db, result.snr_db);
+    EXPECT_LE(result.snr_db, result.snr_high_db);
+    EXPECT_LT(result.trials, result.sweep_trials / 4);
+
+    SimulationConfig check;
+    check.n = 2;
+    check.iterations = 20000;
+    check.seed = 99;
+    check.decoder = "Precomputed";
+
+    check.snr_db = result.snr_low_db - 0.5;
+    EXPECT_GT(simulate(check).failed, 20000 * config.target_bler);
+    check.snr_db = result.snr_high_db + 0.5;
+    EXPECT_LT(simulate(check).failed, 20000 * config.target_bler);
+}
+
+TEST(SnrSearchTest, IsReproducibleForSeed) {
+    SnrSearchConfig config;
+    config.n = 4;
+    config.target_bler = 0.1;
+    config.seed = 3;
+
+    SnrSearchResult a = search_snr(config);
+    SnrSearchResult b = search_snr(config);
+
+    EXPECT_EQ(a.snr_db, b.snr_db);
+    EXPECT_EQ(a.trials, b.trials);
+}
+
+TEST(SnrSearchTest, RejectsInvalidTarget) {
+    SnrSearchConfig config;
+    config.n = 2;
+    config.target_bler = 1.5;
+
+    EXPECT_THROW(search_snr(config), std::invalid_argument);
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simulation.hpp"
+#include "utils/file_utils.hpp"
+#include "utils/trace.hpp"
+
+using namespace qpsk;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+    return (fs::temp_directory_path() / name).string();
+}
+
+TraceConfig temp_trace(const std::string& name) {
+    TraceConfig config;
+    config.file = temp_path(name);
+    return config;
+}
+
+std::vector<json> complete_events(const json& trace, const std::string& name) {
+    std::vector<json> events;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "X" && event["name"] == name) {
+            events.push_back(event);
+        }
+    }
+    return events;
+}
+
+} // namespace
+
+TEST(TraceTest, WritesNestedSpansPerThread) {
+    const TraceConfig config = temp_trace("qpsk_trace_threads.json");
+    start_tracing(config);
+    {
+        TraceSpan outer("outer", false);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 2; ++t) {
+            threads.emplace_back([t] {
+                set_trace_thread_name("worker " + std::to_string(t));
+                for (int i = 0; i < 3; ++i) {
+                    TraceSpan span("work", false);
+                    TraceSpan inner("inner", false);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    const TraceSummary summary = stop_tracing();
+    EXPECT_EQ(summary.threads, 3u);
+    EXPECT_EQ(summary.spans, 13u);
+    EXPECT_EQ(summary.dropped, 0u);
+
+    const json trace = json::parse(read_file(config.file));
+    std::vector<std::string> names;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "M" && event["name"] == "thread_name") {
+            names.push_back(event["args"]["name"]);
+        }
+    }
+    EXPECT_EQ(names.size(), 3u);
+    EXPECT_EQ(names[0], "main");
+
+    const auto outer = complete_events(trace, "outer");
+    const auto work = complete_events(trace, "work");
+    const auto inner = complete_events(trace, "inner");
+    ASSERT_EQ(outer.size(), 1u);
+    ASSERT_EQ(work.size(), 6u);
+    ASSERT_EQ(inner.size(), 6u);
+    for (size_t i = 0; i < work.size(); ++i) {
+        EXPECT_NE(work[i]["tid"], outer[0]["tid"]);
+        EXPECT_GE(work[i]["ts"].get<double>(), outer[0]["ts"].get<double>());
+        EXPECT_EQ(inner[i]["tid"], work[i]["tid"]);
+        EXPECT_GE(inner[i]["ts"].get<double>(), work[i]["ts"].get<double>());
+        EXPECT_LE(inner[i]["dur"].get<double>(), work[i]["dur"].get<double>());
+    }
+}
+
+TEST(TraceTest, SamplingKeepsWholeSubtrees) {
+    TraceConfig config = temp_trace("qpsk_trace_sampled.json");
+    config.sample_period = 8;
+    start_tracing(config);
+    for (int i = 0; i < 4000; ++i) {
+        TraceSpan trial("trial", true);
+        TraceSpan stage("stage", true);
+        TraceSpan always("always", false);
+    }
+    stop_tracing();
+
+    const json trace = json::parse(read_file(config.file));
+    const size_t trials = complete_events(trace, "trial").size();
+    EXPECT_NEAR(static_cast<double>(trials), 500.0, 150.0);
+    EXPECT_EQ(complete_events(trace, "stage").size(), trials);
+    EXPECT_EQ(complete_events(trace, "always").size(), 4000u);
+}
+
+TEST(TraceTest, FullBufferDropsSpans) {
+    TraceConfig config = temp_trace("qpsk_trace_full.json");
+    config.buffer_spans = 10;
+    start_tracing(config);
+    for (int i = 0; i < 25; ++i) {
+        TraceSpan span("span", false);
+    }
+    const TraceSummary summary = stop_tracing();
+    EXPECT_EQ(summary.spans, 10u);
+    EXPECT_EQ(summary.dropped, 15u);
+
+    const json trace = json::parse(read_file(config.file));
+    EXPECT_EQ(trace["otherData"]["dropped_spans"], 15);
+}
+
+TEST(TraceTest, RecordsNothingWhenStopped) {
+    EXPECT_FALSE(tracing_enabled());
+    {
+        TraceSpan span("ignored", false);
+    }
+    EXPECT_THROW(stop_tracing(), std::logic_error);
+
+    TraceConfig config;
+    EXPECT_THROW(start_tracing(config), std::invalid_argument);
+    config.file = temp_path("qpsk_trace_invalid.json");
+    config.sample_period = 0;
+    EXPECT_THROW(start_tracing(config), std::invalid_argument);
+    EXPECT_FALSE(tracing_enabled());
+}
+
+TEST(TraceTest, ParsesTraceField) {
+    EXPECT_EQ(parse_trace_config("trace.json").file, "trace.json");
+    EXPECT_EQ(parse_trace_config("trace.json").sample_period, 1u);
+
+    const TraceConfig config = parse_trace_config(json::parse(R"({"file": "t.json", "sample_period": 16})"));
+    EXPECT_EQ(config.file, "t.json");
+    EXPECT_EQ(config.sample_period, 16u);
+
+    EXPECT_THROW(parse_trace_config(json::parse(R"({"sample_period": 16})")), std::invalid_argument);
+    EXPECT_THROW(parse_trace_config(json(5)), std::invalid_argument);
+}
+
+#ifdef QPSK_TRACING
+TEST(TraceTest, TracesSimulationStages) {
+    TraceConfig config = temp_trace("qpsk_trace_simulation.json");
+    config.sample_period = 4;
+    start_tracing(config);
+
+    SimulationConfig simulation;
+    simulation.n = 4;
+    simulation.iterations = 400;
+    simulation.seed = 47;
+    simulate(simulation);
+    stop_tracing();
+
+    const json trace = json::parse(read_file(config.file));
+    const size_t trials = complete_events(trace, "trial").size();
+    EXPECT_GT(trials, 0u);
+    EXPECT_LT(trials, 400u);
+    for (const char* stage : {"bits", "encode", "modulate", "channel", "demodulate", "decode"}) {
+        EXPECT_EQ(complete_events(trace, stage).size(), trials) << stage;
+    }
+}
+#endif
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include "waveform.hpp"
+#include "encoder.hpp"
+#include "qpsk.hpp"
+#include "partial_sum_decoder.hpp"
+#include "utils/file_utils.hpp"
+
+using namespace qpsk;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+    return (fs::temp_directory_path() / name).string();
+}
+
+template <typename T>
+std::vector<T> read_values(const std::string& path) {
+    const std::string bytes = read_file(path);
+    std::vector<T> values(bytes.size() / sizeof(T));
+    std::memcpy(values.data(), bytes.data(), values.size() * sizeof(T));
+    return values;
+}
+
+void write_messages(const std::string& path, const std::vector<uint16_t>& messages) {
+    write_file_atomic(path, std::string(reinterpret_cast<const char*>(messages.data()),
+                                        messages.size() * sizeof(uint16_t)));
+}
+
+} // namespace
+
+TEST(WaveformTest, MessagesFileMatchesModulator) {
+    const std::string messages_path = temp_path("qpsk_waveform_messages.bin");
+    const std::vector<uint16_t> messages = {0, 1, 0x2A, 0x3F, 0x15};
+    write_messages(messages_path, messages);
+
+    WaveformConfig config;
+    config.n = 6;
+    config.messages_file = messages_path;
+
+    BlockEncoder<6> code;
+    QPSK mod;
+    for (IqFormat format : {IqFormat::CF32, IqFormat::CF64, IqFormat::CI16}) {
+        config.format = format;
+        const std::string path = temp_path(std::string("qpsk_waveform.") + iq_format_name(format));
+        const WaveformResult result = write_waveform(path, config);
+        EXPECT_EQ(result.messages, 5);
+        EXPECT_EQ(result.bytes, 5 * QPSK_SYMBOLS_COUNT * iq_sample_bytes(format));
+        EXPECT_EQ(fs::file_size(path), result.bytes);
+
+        std::vector<double> values;
+        switch (format) {
+            case IqFormat::CF32:
+                for (float v : read_values<float>(path)) values.push_back(v);
+                break;
+            case IqFormat::CF64:
+                values = read_values<double>(path);
+                break;
+            case IqFormat::CI16:
+                for (int16_t v : read_values<int16_t>(path)) values.push_back(v / config.ci16_scale);
+                break;
+        }
+        ASSERT_EQ(values.size(), 5 * CODEWORD_SIZE);
+
+        for (size_t m = 0; m < messages.size(); ++m) {
+            const auto symbols = mod.modulate(code.encode(std::bitset<6>(messages[m])));
+            for (size_t k = 0; k < QPSK_SYMBOLS_COUNT; ++k) {
+                EXPECT_NEAR(values[(m * QPSK_SYMBOLS_COUNT + k) * 2], symbols[k].real(), 1e-4);
+                EXPECT_NEAR(values[(m * QPSK_SYMBOLS_COUNT + k) * 2 + 1], symbols[k].imag(), 1e-4);
+            }
+        }
+    }
+}
+
+TEST(WaveformTest, NoisyVectorsDecodeToSavedMessages) {
+    WaveformConfig config;
+    config.n = 11;
+    config.count = 2000;
+    config.seed = 48;
+    config.snr_db = 8.0;
+    config.save_messages = temp_path("qpsk_waveform_saved.bin");
+    const std::string path = temp_path("qpsk_waveform_noisy.cf32");
+
+    const WaveformResult result = write_waveform(path, config);
+    EXPECT_EQ(result.messages, 2000);
+
+    const auto messages = read_values<uint16_t>(config.save_messages);
+    const auto samples = read_values<float>(path);
+    ASSERT_EQ(messages.size(), 2000u);
+    ASSERT_EQ(samples.size(), 2000 * CODEWORD_SIZE);
+
+    PartialSumDecoder<11> decoder;
+    std::vector<double> llrs(CODEWORD_SIZE);
+    long long errors = 0;
+    double noise_power = 0.0;
+    for (size_t m = 0; m < messages.size(); ++m) {
+        EXPECT_LT(messages[m], 1u << 11);
+        for (size_t j = 0; j < CODEWORD_SIZE; ++j) {
+            llrs[j] = samples[m * CODEWORD_SIZE + j];
+            noise_power += std::pow(std::abs(llrs[j]) - NORM, 2);
+        }
+        errors += decoder.decode(llrs).to_ulong() != messages[m];
+    }
+    EXPECT_LT(errors, 20);
+    // Per-component noise variance 1 / (2 * SNR); folding at |x| only shrinks it.
+    EXPECT_LT(noise_power / samples.size(), 1.0 / (2.0 * std::pow(10.0, 0.8)) * 1.1);
+
+    // Same seed, same vectors.
+    const std::string again = temp_path("qpsk_waveform_noisy_again.cf32");
+    write_waveform(again, config);
+    EXPECT_EQ(read_file(again), read_file(path));
+}
+
+TEST(WaveformTest, RejectsInvalidInput) {
+    const std::string messages_path = temp_path("qpsk_waveform_invalid.bin");
+    write_messages(messages_path, {3, 4});
+
+    WaveformConfig config;
+    config.n = 2;
+    config.messages_file = messages_path;
+    const std::string path = temp_path("qpsk_waveform_invalid.cf32");
+    EXPECT_THROW(write_waveform(path, config), std::invalid_argument);
+    EXPECT_FALSE(fs::exists(path));
+
+    config.n = 3;
+    EXPECT_THROW(write_waveform(path, config), std::invalid_argument);
+
+    EXPECT_THROW(parse_iq_format("cs8"), std::invalid_argument);
+    EXPECT_EQ(parse_iq_format("ci16"), IqFormat::CI16);
+}